@@ -0,0 +1,134 @@
+#include "PCH.h"
+#include "Benchmark.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <sys/resource.h>
+#endif
+
+void Benchmark::Run(std::string const& name, std::string const& graph, uint32_t const& vertices, uint64_t const& edges,
+	uint32_t const& threads, uint64_t const& traversedEdges, std::function<uint64_t()> const& function)
+{
+	Vector<double> seconds(_repetitions);
+	AlgorithmStats stats;
+
+	ResetPeakRss();
+
+	for (uint32_t i = 0; i < _repetitions; ++i)
+	{
+		AlgorithmStatsScope statsScope(&stats);
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+		stats.Reset();
+		_sink += function();
+		seconds[i] = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	std::sort(seconds.begin(), seconds.end());
+
+	BenchmarkResult result;
+
+	result.name = name;
+	result.graph = graph;
+	result.vertices = vertices;
+	result.edges = edges;
+	result.threads = threads;
+	result.repetitions = _repetitions;
+	result.minimumSeconds = seconds.front();
+	result.medianSeconds = seconds[seconds.size() / 2];
+	result.traversedEdges = traversedEdges;
+	result.peakRssKilobytes = GetPeakRssKilobytes();
+	result.stats = stats;
+
+	_results.push_back(result);
+
+	std::cerr << name << " on " << graph << " (V = " << vertices << ", E = " << edges << ", threads = " << threads << "): "
+		<< result.medianSeconds << " s\n";
+}
+
+void Benchmark::WriteJson(std::ostream& os, uint32_t const& hardwareThreads) const
+{
+	os << std::setprecision(9);
+	os << "{\n  \"context\": { \"hardware_threads\": " << hardwareThreads << ", \"repetitions\": " << _repetitions
+		<< ", \"sink\": " << _sink << " },\n  \"results\": [\n";
+
+	for (uint32_t i = 0; i < _results.size(); ++i)
+	{
+		BenchmarkResult const& result = _results[i];
+		double teps = (result.medianSeconds > 0) ? result.traversedEdges / result.medianSeconds : 0;
+
+		os << "    { \"name\": ";
+		WriteJsonString(os, result.name);
+		os << ", \"graph\": ";
+		WriteJsonString(os, result.graph);
+		os << ", \"vertices\": " << result.vertices << ", \"edges\": " << result.edges << ", \"threads\": " << result.threads
+			<< ", \"seconds_min\": " << result.minimumSeconds << ", \"seconds_median\": " << result.medianSeconds
+			<< ", \"teps\": " << teps << ", \"peak_rss_kb\": " << result.peakRssKilobytes;
+
+#ifdef GRAPH_ALGORITHMS_INSTRUMENTATION
+		os << ", \"stats\": ";
+		result.stats.WriteJson(os);
+#endif
+
+		os << " }" << ((i + 1 < _results.size()) ? ",\n" : "\n");
+	}
+
+	os << "  ]\n}\n";
+}
+
+void Benchmark::ResetPeakRss()
+{
+#ifndef _WIN32
+	// Linux resets the peak resident set ("5" to clear_refs), elsewhere the peak covers the whole process.
+	std::ofstream clearRefs("/proc/self/clear_refs");
+
+	if (clearRefs)
+		clearRefs << "5";
+#endif
+}
+
+uint64_t Benchmark::GetPeakRssKilobytes()
+{
+#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS counters;
+
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+		return counters.PeakWorkingSetSize / 1024;
+
+	return 0;
+#else
+	std::ifstream status("/proc/self/status");
+	std::string line;
+
+	while (std::getline(status, line))
+		if (line.compare(0, 6, "VmHWM:") == 0)
+			return std::strtoull(line.c_str() + 6, nullptr, 10);
+
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+
+	return static_cast<uint64_t>(usage.ru_maxrss);
+#endif
+}
+
+void Benchmark::WriteJsonString(std::ostream& os, std::string const& value)
+{
+	os << '"';
+
+	for (std::string::const_iterator itr = value.begin(); itr != value.end(); ++itr)
+		if (*itr == '"' || *itr == '\\')
+			os << '\\' << *itr;
+		else
+			os << *itr;
+
+	os << '"';
+}
+
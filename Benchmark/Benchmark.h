@@ -0,0 +1,49 @@
+#ifndef _BENCHMARK_H
+#define _BENCHMARK_H
+
+#include "PCH.h"
+#include "Instrumentation.h"
+
+#include <string>
+#include <functional>
+
+struct BenchmarkResult
+{
+	std::string name;
+	std::string graph;
+	uint32_t vertices;
+	uint64_t edges;
+	uint32_t threads;
+	uint32_t repetitions;
+	double minimumSeconds;
+	double medianSeconds;
+	uint64_t traversedEdges;	// Edges one run touches, the TEPS numerator.
+	uint64_t peakRssKilobytes;	// Peak resident set while the case ran (process lifetime peak where it can't be reset).
+	AlgorithmStats stats;		// Kernel counters of the last repetition, filled in instrumented builds only.
+};
+
+class Benchmark
+{
+	public:
+		explicit Benchmark(uint32_t const& repetitions) : _repetitions(repetitions ? repetitions : 1), _sink(0) { }
+
+		void Run(std::string const& name, std::string const& graph, uint32_t const& vertices, uint64_t const& edges,
+			uint32_t const& threads, uint64_t const& traversedEdges, std::function<uint64_t()> const& function);
+
+		Vector<BenchmarkResult> const& GetResults() const { return _results; }
+
+		void WriteJson(std::ostream& os, uint32_t const& hardwareThreads) const;
+
+		static void ResetPeakRss();
+		static uint64_t GetPeakRssKilobytes();
+
+	private:
+		static void WriteJsonString(std::ostream& os, std::string const& value);
+
+		uint32_t _repetitions;
+		uint64_t _sink;		// Folds every function result in so the optimizer keeps the measured calls.
+		Vector<BenchmarkResult> _results;
+};
+
+#endif
+
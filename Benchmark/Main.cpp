@@ -0,0 +1,430 @@
+#include "PCH.h"
+#include "Benchmark.h"
+#include "DirectedGraph.h"
+#include "UndirectedGraph.h"
+#include "Tree.h"
+#include "AllPairsShortestPaths.h"
+#include "BellmanFord.h"
+#include "BipartiteMatching.h"
+#include "BlockCutTree.h"
+#include "Centrality.h"
+#include "ContractionHierarchy.h"
+#include "CoreDecomposition.h"
+#include "EulerianPath.h"
+#include "GraphFingerprint.h"
+#include "HamiltonianCycle.h"
+#include "MaximumFlow.h"
+#include "PageRank.h"
+#include "PointToPointSearch.h"
+#include "QueryExecutor.h"
+#include "TopologicalOrder.h"
+#include "VersionedGraph.h"
+#include "GraphGenerator.h"
+#include "GraphView.h"
+#include "GraphWriter.h"
+#include "Parallel.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+
+struct BenchmarkOptions
+{
+	uint32_t minimumScale;
+	uint32_t maximumScale;
+	uint32_t edgeFactor;
+	uint32_t repetitions;
+	uint64_t seed;
+	Vector<uint32_t> threads;
+	std::string filter;
+	std::string output;
+};
+
+struct BenchmarkGraphs
+{
+	uint32_t scale;
+	uint32_t source;			// Highest degree R-MAT vertex, scrambling can leave vertex 0 isolated.
+	UndirectedGraph undirected;
+	UndirectedGraph secondUndirected;
+	DirectedGraph directed;
+	DirectedGraph secondDirected;
+	DirectedGraph acyclic;		// R-MAT edges oriented from the lower to the higher id.
+	DirectedGraph network;		// Road edges as one-way arcs, the lengths are the capacities.
+	DirectedGraph deBruijn;		// Binary de Bruijn graph, v -> 2v and 2v + 1 modulo V, so it has an Eulerian circuit.
+	UndirectedGraph road;
+	UndirectedGraph smallRoad;	// A 4 x 4 road grid for the exponential APIs, the same at every scale.
+	UndirectedGraph assignment;	// R-MAT edges moved to run from an even to an odd vertex, so it is bipartite.
+	Tree tree;
+};
+
+class BenchmarkSuite
+{
+	public:
+		BenchmarkSuite(BenchmarkOptions const& options, Benchmark* benchmark) : _options(options), _benchmark(benchmark) { }
+
+		void Run(BenchmarkGraphs& graphs);
+
+	private:
+		// Runs the case unless it is filtered out or the scale is above maximumScale (for the super-linear APIs).
+		void Run(std::string const& name, std::string const& graphName, Graph const& graph, uint32_t const& maximumScale,
+			uint32_t const& threads, std::function<uint64_t()> const& function);
+
+		BenchmarkOptions const& _options;
+		Benchmark* _benchmark;
+		uint32_t _scale;
+};
+
+void BenchmarkSuite::Run(std::string const& name, std::string const& graphName, Graph const& graph, uint32_t const& maximumScale,
+	uint32_t const& threads, std::function<uint64_t()> const& function)
+{
+	if (_scale > maximumScale || name.find(_options.filter) == std::string::npos)
+		return;
+
+	std::ostringstream graphLabel;
+	graphLabel << graphName << "-" << _scale;
+
+	_benchmark->Run(name, graphLabel.str(), graph.GetVertices(), graph.GetEdges(), threads, graph.GetEdges(), function);
+}
+
+void BenchmarkSuite::Run(BenchmarkGraphs& graphs)
+{
+	uint32_t const unlimited = UINT32_MAX;
+	uint32_t source = graphs.source;
+	PointToPointSearch search(graphs.road);
+	ContractionHierarchy hierarchy;
+	ContractionHierarchy::Workspace hierarchyWorkspace;
+	ComponentLabels components;		// Reused by the flat component cases, so their repetitions allocate nothing.
+	TraversalWorkspace workspace;
+
+	_scale = graphs.scale;
+
+	// Preprocessing is far slower than a query, so the query case gets its hierarchy outside the timed region.
+	if (_scale <= 12 && std::string("hierarchy_query").find(_options.filter) != std::string::npos)
+		hierarchy = ContractionHierarchy(graphs.road);
+
+	// Parallel APIs, swept over the thread counts.
+	for (uint32_t i = 0; i < _options.threads.size(); ++i)
+	{
+		uint32_t threads = _options.threads[i];
+
+		Run("generate_rmat", "rmat-directed", graphs.directed, unlimited, threads, [&]()
+			{ return GraphGenerator(_options.seed, threads).GetRMatEdges(_scale, _options.edgeFactor).size(); });
+		Run("floyd_warshall", "rmat", graphs.undirected, 10, threads, [&]()
+			{ return static_cast<uint64_t>(AllPairsShortestPaths::FloydWarshall(graphs.undirected, threads).GetVertices()); });
+		Run("johnson", "road", graphs.road, 12, threads, [&]()
+			{ return static_cast<uint64_t>(AllPairsShortestPaths::Johnson(graphs.road, threads).GetVertices()); });
+		Run("topological_levels", "rmat-acyclic", graphs.acyclic, unlimited, threads, [&]()
+			{ return static_cast<uint64_t>(TopologicalOrder(graphs.acyclic, threads).GetCriticalPathLength()); });
+		Run("bellman_ford", "network", graphs.network, unlimited, threads, [&]()
+			{ return static_cast<uint64_t>(BellmanFord(graphs.network, 0, threads).GetRounds()); });
+		Run("contraction_hierarchy", "road", graphs.road, 12, threads, [&]()
+			{ return static_cast<uint64_t>(ContractionHierarchy(graphs.road, threads).GetArcs()); });
+		Run("bipartite_matching", "assignment", graphs.assignment, unlimited, threads, [&]()
+			{ return static_cast<uint64_t>(BipartiteMatching(graphs.assignment, threads).GetSize()); });
+		Run("hamiltonian_tour", "road-4x4", graphs.smallRoad, unlimited, threads, [&]()
+			{
+				HamiltonianCycle tour(graphs.smallRoad, threads);
+
+				tour.FindOptimal();
+
+				return static_cast<uint64_t>(tour.GetCost());
+			});
+		Run("core_decomposition", "rmat", graphs.undirected, unlimited, threads, [&]()
+			{ return static_cast<uint64_t>(CoreDecomposition(graphs.undirected, threads).GetDegeneracy()); });
+		Run("betweenness", "rmat", graphs.undirected, 12, threads, [&]()
+			{ return static_cast<uint64_t>(Centrality(graphs.undirected, Centrality::AllSources, 0, threads).GetSources()); });
+		Run("betweenness_sampled", "road", graphs.road, unlimited, threads, [&]()
+			{ return static_cast<uint64_t>(Centrality(graphs.road, 64, _options.seed, threads).GetSources()); });
+		Run("pagerank", "rmat-directed", graphs.directed, unlimited, threads, [&]()
+			{
+				uint32_t iterations = 0;
+
+				PageRank(graphs.directed, 0.85, 1e-6, 100, threads).Compute(nullptr, &iterations);
+
+				return static_cast<uint64_t>(iterations);
+			});
+		Run("personalized_pagerank", "rmat-directed", graphs.directed, unlimited, threads, [&]()
+			{
+				Vector<uint32_t> seeds;
+
+				for (uint32_t j = 0; j < 2 * PageRank::BatchSeeds; ++j)
+					seeds.push_back(static_cast<uint32_t>((j * 2654435761ULL) % graphs.directed.GetVertices()));
+
+				return static_cast<uint64_t>(PageRank(graphs.directed, 0.85, 1e-6, 100, threads).ComputePersonalized(seeds).size());
+			});
+		Run("query_executor", "road", graphs.road, unlimited, threads, [&]()
+			{
+				// Local distance queries spread over the graph; starting the workers is part of the measurement.
+				QueryExecutor executor(graphs.road, threads);
+				Vector<Query> queries;
+
+				for (uint32_t j = 0; j < 256; ++j)
+					queries.push_back(Query(Query::Distances, static_cast<uint32_t>((j * 2654435761ULL) % graphs.road.GetVertices()),
+						0, 1000));
+
+				Vector<QueryResult> results = executor.Execute(queries);
+				uint64_t settled = 0;
+
+				for (uint32_t j = 0; j < results.size(); ++j)
+					settled += results[j].vertices.size();
+
+				return settled;
+			});
+	}
+
+	Run("reorder_rcm", "rmat", graphs.undirected, unlimited, 1, [&]()
+		{ UndirectedGraph graph(graphs.undirected); return graph.Reorder(VertexOrder::ReverseCuthillMcKee).ToInternal(0); });
+
+	// Traversals and shortest paths.
+	Run("breadth_first_search", "rmat", graphs.undirected, unlimited, 1, [&]() { return graphs.undirected.BreadthFirstSearch(source).size(); });
+	Run("depth_first_search", "rmat", graphs.undirected, unlimited, 1, [&]() { return graphs.undirected.DepthFirstSearch(source).size(); });
+	Run("road_distance", "road", graphs.road, unlimited, 1, [&]() { return graphs.road.GetRoadDistance(0).size(); });
+	Run("breadth_first_search_workspace", "rmat", graphs.undirected, unlimited, 1, [&]()
+		{ return static_cast<uint64_t>(graphs.undirected.BreadthFirstSearch(source, &workspace).size()); });
+	Run("road_distance_local", "road", graphs.road, unlimited, 1, [&]()
+		{ return static_cast<uint64_t>(graphs.road.GetRoadDistance(0, &workspace, 1000).size()); });
+	Run("point_to_point", "road", graphs.road, unlimited, 1, [&]()
+		{ return static_cast<uint64_t>(search.Query(0, graphs.road.GetVertices() - 1)); });
+	Run("hierarchy_query", "road", graphs.road, 12, 1, [&]()
+		{ return static_cast<uint64_t>(hierarchy.Query(0, graphs.road.GetVertices() - 1, &hierarchyWorkspace)); });
+
+	// UndirectedGraph.
+	Run("minimum_spanning_tree", "road", graphs.road, 12, 1, [&]() { return graphs.road.GetMinimumSpanningTree().size(); });
+	Run("connected_components", "rmat", graphs.undirected, unlimited, 1, [&]() { return graphs.undirected.GetConnectedComponents().size(); });
+	Run("articulation_points", "rmat", graphs.undirected, unlimited, 1, [&]() { return graphs.undirected.GetArticulationPoints().size(); });
+	Run("biconnected_components", "rmat", graphs.undirected, unlimited, 1, [&]() { return graphs.undirected.GetBiconnectedComponents().size(); });
+	Run("connected_components_flat", "rmat", graphs.undirected, unlimited, 1, [&]()
+		{ graphs.undirected.GetConnectedComponents(&components); return static_cast<uint64_t>(components.GetCount()); });
+	Run("connected_components_view", "rmat", graphs.undirected, unlimited, 1, [&]()
+		{
+			Vector<bool> mask(graphs.undirected.GetVertices());
+
+			for (uint32_t j = 0; j < mask.size(); ++j)
+				mask[j] = (j & 3) != 0;
+
+			GraphView(graphs.undirected).SetVertexMask(mask).GetConnectedComponents(&components);
+			return static_cast<uint64_t>(components.GetCount());
+		});
+	Run("biconnected_components_flat", "rmat", graphs.undirected, unlimited, 1, [&]()
+		{ graphs.undirected.GetBiconnectedComponents(&components); return static_cast<uint64_t>(components.GetCount()); });
+	Run("is_biconnected", "road", graphs.road, unlimited, 1, [&]() { return static_cast<uint64_t>(graphs.road.IsBiconnected()); });
+	Run("is_bipartite", "road", graphs.road, unlimited, 1, [&]() { return static_cast<uint64_t>(graphs.road.IsBipartite()); });
+	Run("max_degree", "rmat", graphs.undirected, unlimited, 1, [&]() { return static_cast<uint64_t>(graphs.undirected.GetMaxDegree()); });
+
+	// DirectedGraph.
+	Run("strongly_connected_components", "rmat-directed", graphs.directed, unlimited, 1, [&]()
+		{ return graphs.directed.GetStronglyConnectedComponents().size(); });
+	Run("block_cut_tree", "rmat", graphs.undirected, unlimited, 1, [&]()
+		{
+			BlockCutTree index(graphs.undirected);
+			uint32_t vertices = graphs.undirected.GetVertices();
+			uint64_t connected = 0;
+
+			for (uint64_t j = 0; j < 65536; ++j)
+				connected += index.IsConnectedWithoutVertex(static_cast<uint32_t>(j * 2654435761ULL % vertices),
+					static_cast<uint32_t>(j * 40503ULL % vertices), graphs.source);
+
+			return connected;
+		});
+	Run("strongly_connected_components_flat", "rmat-directed", graphs.directed, unlimited, 1, [&]()
+		{ graphs.directed.GetStronglyConnectedComponents(&components); return static_cast<uint64_t>(components.GetCount()); });
+	Run("topological_sort", "rmat-acyclic", graphs.acyclic, unlimited, 1, [&]() { return graphs.acyclic.GetTopologicalSort().size(); });
+	Run("is_strongly_connected", "rmat-directed", graphs.directed, unlimited, 1, [&]()
+		{ return static_cast<uint64_t>(graphs.directed.IsStronglyConnected()); });
+	Run("maximum_flow", "network", graphs.network, unlimited, 1, [&]()
+		{ return static_cast<uint64_t>(MaximumFlow(graphs.network, 0, graphs.network.GetVertices() - 1).GetValue()); });
+	Run("max_in_degree", "rmat-directed", graphs.directed, unlimited, 1, [&]() { return static_cast<uint64_t>(graphs.directed.GetMaxInDegree()); });
+
+	Run("eulerian_circuit", "debruijn", graphs.deBruijn, unlimited, 1, [&]()
+		{ return EulerianPath(graphs.deBruijn).GetPath().size(); });
+
+	// Tree.
+	Run("tree_diameter", "random-tree", graphs.tree, unlimited, 1, [&]() { return static_cast<uint64_t>(graphs.tree.GetDiameter()); });
+	Run("tree_center", "random-tree", graphs.tree, unlimited, 1, [&]() { return graphs.tree.GetCenter().size(); });
+
+	// Set operators.
+	Run("undirected_union", "rmat", graphs.undirected, unlimited, 1, [&]()
+		{ return static_cast<uint64_t>((graphs.undirected + graphs.secondUndirected).GetVertices()); });
+	Run("undirected_difference", "rmat", graphs.undirected, unlimited, 1, [&]()
+		{ return static_cast<uint64_t>((graphs.undirected - graphs.secondUndirected).GetVertices()); });
+	Run("undirected_equality", "rmat", graphs.undirected, unlimited, 1, [&]()
+		{ return static_cast<uint64_t>(graphs.undirected == graphs.secondUndirected); });
+	Run("graph_fingerprint", "rmat", graphs.undirected, unlimited, 1, [&]()
+		{ return GraphFingerprint(graphs.undirected).GetFingerprint().low; });
+	Run("directed_union", "rmat-directed", graphs.directed, unlimited, 1, [&]()
+		{ return static_cast<uint64_t>((graphs.directed + graphs.secondDirected).GetVertices()); });
+	Run("directed_difference", "rmat-directed", graphs.directed, unlimited, 1, [&]()
+		{ return static_cast<uint64_t>((graphs.directed - graphs.secondDirected).GetVertices()); });
+
+	// Versioned updates.
+	Run("versioned_updates", "rmat", graphs.undirected, unlimited, 1, [&]()
+		{
+			VersionedGraph versioned(graphs.undirected);
+			uint32_t vertices = graphs.undirected.GetVertices();
+
+			for (uint64_t batch = 0; batch < 64; ++batch)
+			{
+				Vector<EdgeUpdate> updates;
+
+				for (uint64_t j = batch * 1024; j < (batch + 1) * 1024; ++j)
+					updates.push_back(EdgeUpdate((j & 1) ? EdgeUpdate::Delete : EdgeUpdate::Insert,
+						static_cast<uint32_t>(j * 2654435761ULL % vertices), static_cast<uint32_t>(j * 40503ULL % vertices), 1));
+
+				versioned.Apply(updates);
+			}
+
+			return versioned.GetSnapshot().BreadthFirstSearch(0).size();
+		});
+
+	// Export.
+	Run("write_adjacency", "rmat", graphs.undirected, unlimited, 1, [&]()
+		{ std::ostringstream os; os << graphs.undirected; return static_cast<uint64_t>(os.tellp()); });
+	Run("write_edge_list", "rmat", graphs.undirected, unlimited, 1, [&]()
+		{
+			std::ostringstream os;
+			GraphWriter(os).WriteEdgeList(graphs.undirected);
+			return static_cast<uint64_t>(os.tellp());
+		});
+}
+
+static void PrintUsage()
+{
+	std::cerr << "Usage: Benchmark [--min-scale N] [--max-scale N] [--edge-factor N] [--repetitions N] [--seed N]\n"
+		"                 [--threads 1,2,4] [--filter substring] [--output results.json]\n";
+}
+
+static bool ParseOptions(int argc, char** argv, BenchmarkOptions* options)
+{
+	options->minimumScale = 10;
+	options->maximumScale = 16;
+	options->edgeFactor = 8;
+	options->repetitions = 3;
+	options->seed = 1;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string argument = argv[i];
+
+		if (i + 1 >= argc)
+			return false;
+
+		std::string value = argv[++i];
+
+		if (argument == "--min-scale")
+			options->minimumScale = static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, 10));
+		else if (argument == "--max-scale")
+			options->maximumScale = static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, 10));
+		else if (argument == "--edge-factor")
+			options->edgeFactor = static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, 10));
+		else if (argument == "--repetitions")
+			options->repetitions = static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, 10));
+		else if (argument == "--seed")
+			options->seed = std::strtoull(value.c_str(), nullptr, 10);
+		else if (argument == "--filter")
+			options->filter = value;
+		else if (argument == "--output")
+			options->output = value;
+		else if (argument == "--threads")
+		{
+			std::istringstream threads(value);
+			std::string thread;
+
+			while (std::getline(threads, thread, ','))
+				options->threads.push_back(static_cast<uint32_t>(std::strtoul(thread.c_str(), nullptr, 10)));
+		}
+		else
+			return false;
+	}
+
+	if (options->threads.empty())
+	{
+		options->threads.push_back(1);
+
+		if (Parallel::GetThreads(0) > 1)
+			options->threads.push_back(Parallel::GetThreads(0));
+	}
+
+	return options->minimumScale <= options->maximumScale;
+}
+
+static void BuildGraphs(BenchmarkOptions const& options, uint32_t const& scale, BenchmarkGraphs* graphs)
+{
+	uint32_t vertices = 1U << scale;
+	uint32_t side = 1U << (scale / 2);
+	GraphGenerator generator(options.seed);
+	GraphGenerator secondGenerator(options.seed + 1);
+	EdgesVector rMatEdges = generator.GetRMatEdges(scale, options.edgeFactor);
+	EdgesVector acyclicEdges;
+	EdgesVector assignmentEdges(rMatEdges);
+
+	graphs->scale = scale;
+	graphs->undirected = UndirectedGraph(vertices, rMatEdges);
+	graphs->directed = DirectedGraph(vertices, rMatEdges);
+	graphs->secondUndirected = UndirectedGraph(vertices, secondGenerator.GetRMatEdges(scale, options.edgeFactor));
+	graphs->secondDirected = DirectedGraph(vertices, secondGenerator.GetRMatEdges(scale, options.edgeFactor));
+
+	for (uint32_t i = 0; i < rMatEdges.size(); ++i)
+		if (rMatEdges[i].first.first != rMatEdges[i].first.second)
+			acyclicEdges.push_back(std::make_pair(std::make_pair(std::min(rMatEdges[i].first.first, rMatEdges[i].first.second),
+				std::max(rMatEdges[i].first.first, rMatEdges[i].first.second)), 0));
+
+	graphs->acyclic = DirectedGraph(vertices, acyclicEdges);
+
+	for (uint32_t i = 0; i < assignmentEdges.size(); ++i)
+		assignmentEdges[i].first = std::make_pair(assignmentEdges[i].first.first & ~1U, assignmentEdges[i].first.second | 1U);
+
+	graphs->assignment = UndirectedGraph(vertices, assignmentEdges);
+	EdgesVector roadEdges = generator.GetRoadEdges(vertices / side, side);
+
+	graphs->road = UndirectedGraph(side * (vertices / side), roadEdges, true);
+	graphs->network = DirectedGraph(side * (vertices / side), roadEdges, true);
+	graphs->smallRoad = UndirectedGraph(16, generator.GetRoadEdges(4, 4), true);
+
+	EdgesVector deBruijnEdges;
+
+	for (uint32_t i = 0; i < vertices; ++i)
+		for (uint32_t j = 0; j < 2; ++j)
+			deBruijnEdges.push_back(std::make_pair(std::make_pair(i, ((i << 1) | j) & (vertices - 1)), 0));
+
+	graphs->deBruijn = DirectedGraph(vertices, deBruijnEdges);
+	graphs->tree = generator.GetRandomTree(vertices);
+
+	graphs->source = 0;
+
+	for (uint32_t i = 1; i < vertices; ++i)
+		if (graphs->undirected.GetDegree(i) > graphs->undirected.GetDegree(graphs->source))
+			graphs->source = i;
+}
+
+int main(int argc, char** argv)
+{
+	BenchmarkOptions options;
+
+	if (!ParseOptions(argc, argv, &options))
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	Benchmark benchmark(options.repetitions);
+	BenchmarkSuite suite(options, &benchmark);
+
+	for (uint32_t scale = options.minimumScale; scale <= options.maximumScale; ++scale)
+	{
+		BenchmarkGraphs graphs;
+
+		BuildGraphs(options, scale, &graphs);
+		suite.Run(graphs);
+	}
+
+	if (options.output.empty())
+		benchmark.WriteJson(std::cout, Parallel::GetThreads(0));
+	else
+	{
+		std::ofstream ofs(options.output);
+		benchmark.WriteJson(ofs, Parallel::GetThreads(0));
+	}
+
+	return 0;
+}
+
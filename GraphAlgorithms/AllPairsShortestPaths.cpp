@@ -0,0 +1,293 @@
+#include "PCH.h"
+#include "AllPairsShortestPaths.h"
+#include "BellmanFord.h"
+#include "Instrumentation.h"
+#include "Parallel.h"
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+int32_t const DistanceMatrix::Unreachable;
+int32_t const AllPairsShortestPaths::Infinity;
+uint32_t const AllPairsShortestPaths::BlockSize;
+
+DistanceMatrix AllPairsShortestPaths::Compute(Graph const& graph, uint32_t const& threads, RunControl* control)
+{
+	uint64_t vertices = graph.GetVertices();
+	uint64_t arcs = 0;
+
+	for (uint32_t i = 0; i < graph.GetVertices(); ++i)
+		arcs += graph.GetNeighbours(i).size();
+
+	if (arcs * 16 >= vertices * vertices)
+		return FloydWarshall(graph, threads, control);
+
+	return Johnson(graph, threads, control);
+}
+
+DistanceMatrix AllPairsShortestPaths::FloydWarshall(Graph const& graph, uint32_t const& threads, RunControl* control)
+{
+	GRAPH_STATS_COLLECTOR();
+	GRAPH_STATS_PHASE("floyd_warshall");
+
+	if (!graph.HasVertices())
+		return DistanceMatrix();
+
+	uint32_t vertices = graph.GetVertices();
+	uint32_t stride = GetStride(vertices);
+	uint32_t blocks = stride / BlockSize;
+	bool weighted = graph.IsWeighted();
+	DistanceMatrix distances(vertices, stride, Infinity);
+
+	GRAPH_STATS_ADD(BytesAllocated, static_cast<uint64_t>(stride) * stride * sizeof(int32_t));
+
+	for (uint32_t i = 0; i < vertices; ++i)
+	{
+		int32_t* row = distances.GetRow(i);
+
+		row[i] = 0;
+
+		for (AdjacencyListConstIterator itr = graph.GetNeighbours(i).begin(); itr != graph.GetNeighbours(i).end(); ++itr)
+			row[itr->first] = std::min(row[itr->first], weighted ? itr->second : 1);
+	}
+
+	int32_t* base = distances.GetRow(0);
+	auto getBlock = [&](uint32_t const& row, uint32_t const& column)
+		{ return base + static_cast<uint64_t>(row) * BlockSize * stride + static_cast<uint64_t>(column) * BlockSize; };
+
+	// Round k closes the diagonal tile, then the tiles of its row and column, then every other tile through them.
+	for (uint32_t k = 0; k < blocks; ++k)
+	{
+		if (control && !control->Poll(k, blocks))
+			return DistanceMatrix();
+
+		CloseDiagonalBlock(getBlock(k, k), stride);
+
+		Parallel::For(0, blocks, threads, [&](uint64_t const& first, uint64_t const& last, uint32_t const&)
+		{
+			for (uint32_t i = static_cast<uint32_t>(first); i < last; ++i)
+				if (i != k)
+				{
+					UpdateBlock(getBlock(k, i), getBlock(k, k), getBlock(k, i), stride);
+					UpdateBlock(getBlock(i, k), getBlock(i, k), getBlock(k, k), stride);
+				}
+		});
+
+		// A round costs V^3 / blocks, so the control is also polled per tile row to keep deadlines tight.
+		Parallel::For(0, blocks, threads, [&](uint64_t const& first, uint64_t const& last, uint32_t const&)
+		{
+			for (uint32_t i = static_cast<uint32_t>(first); i < last; ++i)
+			{
+				if (control && !control->Poll(k, blocks))
+					return;
+
+				for (uint32_t j = 0; j < blocks && i != k; ++j)
+					if (j != k)
+						UpdateBlock(getBlock(i, j), getBlock(i, k), getBlock(k, j), stride);
+			}
+		});
+	}
+
+	if (control && control->IsStopped())
+		return DistanceMatrix();
+
+	for (uint32_t i = 0; i < vertices; ++i)
+		if (distances.Get(i, i) < 0)
+			return DistanceMatrix();
+
+	Parallel::For(0, vertices, threads, [&](uint64_t const& first, uint64_t const& last, uint32_t const&)
+	{
+		for (uint32_t i = static_cast<uint32_t>(first); i < last; ++i)
+		{
+			int32_t* row = distances.GetRow(i);
+
+			for (uint32_t j = 0; j < vertices; ++j)
+				if (row[j] >= Infinity / 2)
+					row[j] = DistanceMatrix::Unreachable;
+		}
+	});
+
+	if (control)
+		control->Complete(blocks);
+
+	return distances;
+}
+
+DistanceMatrix AllPairsShortestPaths::Johnson(Graph const& graph, uint32_t const& threads, RunControl* control)
+{
+	GRAPH_STATS_COLLECTOR();
+
+	CompressedGraph compressed(graph);
+	uint32_t vertices = compressed.GetVertices();
+	bool weighted = graph.IsWeighted();
+	Vector<int64_t> potentials;
+
+	{
+		GRAPH_STATS_PHASE("johnson_potentials");
+
+		BellmanFord potential(compressed, weighted, BellmanFord::AllVertices, threads, control);
+
+		if (!potential.IsValid() || potential.HasNegativeCycle())
+			return DistanceMatrix();
+
+		potentials = potential.GetDistances();
+	}
+
+	GRAPH_STATS_PHASE("johnson_dijkstra");
+
+	DistanceMatrix distances(vertices, GetStride(vertices), DistanceMatrix::Unreachable);
+	Vector<Vector<int64_t>> reducedDistances(Parallel::GetThreads(threads));
+	Vector<Vector<uint32_t>> reached(reducedDistances.size());
+	Vector<Vector<Pair<int64_t, uint32_t>>> heaps(reducedDistances.size());
+	std::atomic<uint64_t> done(0);
+
+	GRAPH_STATS_ADD(BytesAllocated, static_cast<uint64_t>(distances.GetStride()) * distances.GetStride() * sizeof(int32_t));
+
+	// The reweighted arcs w + p(u) - p(v) are non-negative, so every source runs a plain lazy deletion Dijkstra.
+	Parallel::ForDynamic(0, vertices, 16, threads, [&](uint64_t const& first, uint64_t const& last, uint32_t const& thread)
+	{
+		Vector<int64_t>& distance = reducedDistances[thread];
+		Vector<uint32_t>& touched = reached[thread];
+		Vector<Pair<int64_t, uint32_t>>& heap = heaps[thread];
+		std::greater<Pair<int64_t, uint32_t>> compare;
+
+		// Once the control says stop every remaining chunk returns right away.
+		if (control && !control->Poll(done, vertices))
+			return;
+
+		if (distance.empty())
+			distance.assign(vertices, INT64_MAX);
+
+		for (uint32_t source = static_cast<uint32_t>(first); source < last; ++source)
+		{
+			distance[source] = 0;
+			touched.push_back(source);
+			heap.push_back(std::make_pair(0, source));
+
+			while (!heap.empty())
+			{
+				std::pop_heap(heap.begin(), heap.end(), compare);
+
+				int64_t length = heap.back().first;
+				uint32_t element = heap.back().second;
+
+				heap.pop_back();
+
+				if (length > distance[element])
+					continue;
+
+				for (uint64_t arc = compressed.GetBegin(element); arc < compressed.GetEnd(element); ++arc)
+				{
+					uint32_t neighbour = compressed.GetTarget(arc);
+					int64_t candidate = length + GetWeight(compressed, arc, weighted) + potentials[element] - potentials[neighbour];
+
+					if (candidate < distance[neighbour])
+					{
+						if (distance[neighbour] == INT64_MAX)
+							touched.push_back(neighbour);
+
+						distance[neighbour] = candidate;
+						heap.push_back(std::make_pair(candidate, neighbour));
+						std::push_heap(heap.begin(), heap.end(), compare);
+					}
+				}
+			}
+
+			int32_t* row = distances.GetRow(source);
+
+			for (uint32_t i = 0; i < touched.size(); ++i)
+			{
+				row[touched[i]] = static_cast<int32_t>(distance[touched[i]] - potentials[source] + potentials[touched[i]]);
+				distance[touched[i]] = INT64_MAX;
+			}
+
+			touched.clear();
+		}
+
+		done += last - first;
+	});
+
+	if (control)
+	{
+		if (control->IsStopped())
+			return DistanceMatrix();
+
+		control->Complete(vertices);
+	}
+
+	return distances;
+}
+
+void AllPairsShortestPaths::RelaxRow(int32_t* row, int32_t const& distance, int32_t const* through)
+{
+#ifdef __AVX2__
+	__m256i broadcast = _mm256_set1_epi32(distance);
+
+	for (uint32_t j = 0; j < BlockSize; j += 8)
+	{
+		__m256i current = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(row + j));
+		__m256i candidate = _mm256_add_epi32(broadcast, _mm256_loadu_si256(reinterpret_cast<__m256i const*>(through + j)));
+
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(row + j), _mm256_min_epi32(current, candidate));
+	}
+#else
+	for (uint32_t j = 0; j < BlockSize; ++j)
+		row[j] = std::min(row[j], distance + through[j]);
+#endif
+}
+
+void AllPairsShortestPaths::UpdateBlock(int32_t* c, int32_t const* a, int32_t const* b, uint32_t const& stride)
+{
+	for (uint32_t i = 0; i < BlockSize; ++i)
+	{
+		int32_t* row = c + static_cast<uint64_t>(i) * stride;
+
+#ifdef __AVX2__
+		// The row stays in registers for the whole tile. When c aliases a or b the reads see its old values, which
+		// is still exact because the diagonal tile is already closed.
+		__m256i current[BlockSize / 8];
+
+		for (uint32_t j = 0; j < BlockSize / 8; ++j)
+			current[j] = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(row + 8 * j));
+#endif
+
+		for (uint32_t k = 0; k < BlockSize; ++k)
+		{
+			int32_t distance = a[static_cast<uint64_t>(i) * stride + k];
+
+			// Entries this large are unreachable, skipping them also keeps the sums from overflowing.
+			if (distance >= Infinity / 2)
+				continue;
+
+#ifdef __AVX2__
+			__m256i broadcast = _mm256_set1_epi32(distance);
+			int32_t const* through = b + static_cast<uint64_t>(k) * stride;
+
+			for (uint32_t j = 0; j < BlockSize / 8; ++j)
+				current[j] = _mm256_min_epi32(current[j],
+					_mm256_add_epi32(broadcast, _mm256_loadu_si256(reinterpret_cast<__m256i const*>(through + 8 * j))));
+#else
+			RelaxRow(row, distance, b + static_cast<uint64_t>(k) * stride);
+#endif
+		}
+
+#ifdef __AVX2__
+		for (uint32_t j = 0; j < BlockSize / 8; ++j)
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(row + 8 * j), current[j]);
+#endif
+	}
+}
+
+void AllPairsShortestPaths::CloseDiagonalBlock(int32_t* block, uint32_t const& stride)
+{
+	for (uint32_t k = 0; k < BlockSize; ++k)
+		for (uint32_t i = 0; i < BlockSize; ++i)
+		{
+			int32_t distance = block[static_cast<uint64_t>(i) * stride + k];
+
+			if (distance < Infinity / 2)
+				RelaxRow(block + static_cast<uint64_t>(i) * stride, distance, block + static_cast<uint64_t>(k) * stride);
+		}
+}
+
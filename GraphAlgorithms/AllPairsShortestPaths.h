@@ -0,0 +1,72 @@
+#ifndef _ALL_PAIRS_SHORTEST_PATHS_H
+#define _ALL_PAIRS_SHORTEST_PATHS_H
+
+#include "PCH.h"
+#include "Graph.h"
+#include "CompressedGraph.h"
+#include "RunControl.h"
+
+// Flat row-major V x V distances. Both dimensions are padded to GetStride() so the blocked kernels can work on whole
+// tiles, the padding entries are unspecified.
+class DistanceMatrix
+{
+	public:
+		static int32_t const Unreachable = INT32_MAX;
+
+		DistanceMatrix() : _vertices(0), _stride(0) { }
+		DistanceMatrix(uint32_t const& vertices, uint32_t const& stride, int32_t const& value) : _vertices(vertices),
+			_stride(stride), _distances(static_cast<uint64_t>(stride) * stride, value) { }
+
+		bool IsEmpty() const { return _distances.empty(); }
+		uint32_t GetVertices() const { return _vertices; }
+		uint32_t GetStride() const { return _stride; }
+
+		int32_t Get(uint32_t const& from, uint32_t const& to) const { return _distances[static_cast<uint64_t>(from) * _stride + to]; }
+
+		int32_t* GetRow(uint32_t const& vertex) { return &_distances[static_cast<uint64_t>(vertex) * _stride]; }
+		int32_t const* GetRow(uint32_t const& vertex) const { return &_distances[static_cast<uint64_t>(vertex) * _stride]; }
+
+	private:
+		uint32_t _vertices;
+		uint32_t _stride;
+		Vector<int32_t> _distances;
+};
+
+// All-pairs shortest paths on directed or undirected graphs with possibly negative weights; an unweighted graph counts
+// hops. The path lengths must stay within +-2^29. Every engine returns an empty matrix when there is a negative cycle
+// or when its control stops the run.
+class AllPairsShortestPaths
+{
+	public:
+		// Floyd-Warshall for dense graphs when Arcs * 16 >= V^2, Johnson otherwise.
+		static DistanceMatrix Compute(Graph const& graph, uint32_t const& threads = 0, RunControl* control = nullptr);
+
+		// Blocked Floyd-Warshall, O(V^3) with AVX2 when the compiler targets it. The tile rows are updated in parallel.
+		// Progress counts diagonal tiles.
+		static DistanceMatrix FloydWarshall(Graph const& graph, uint32_t const& threads = 0, RunControl* control = nullptr);
+
+		// Parallel Bellman-Ford potentials from a virtual source, then one Dijkstra per source spread over the threads.
+		// Progress counts the Bellman-Ford rounds, then the sources.
+		static DistanceMatrix Johnson(Graph const& graph, uint32_t const& threads = 0, RunControl* control = nullptr);
+
+	private:
+		static int32_t const Infinity = 1 << 30;
+		static uint32_t const BlockSize = 64;
+
+		static int32_t GetWeight(CompressedGraph const& graph, uint64_t const& arc, bool weighted)
+		{
+			return weighted ? graph.GetWeight(arc) : 1;
+		}
+
+		static uint32_t GetStride(uint32_t const& vertices) { return (vertices + BlockSize - 1) / BlockSize * BlockSize; }
+
+		// row[j] = min(row[j], distance + through[j]) over one tile row.
+		static void RelaxRow(int32_t* row, int32_t const& distance, int32_t const* through);
+
+		// c = min(c, a * b) over one tile, where * is the min-plus product. c may alias a or b.
+		static void UpdateBlock(int32_t* c, int32_t const* a, int32_t const* b, uint32_t const& stride);
+		static void CloseDiagonalBlock(int32_t* block, uint32_t const& stride);
+};
+
+#endif
+
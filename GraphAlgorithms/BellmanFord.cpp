@@ -0,0 +1,183 @@
+#include "PCH.h"
+#include "BellmanFord.h"
+#include "Instrumentation.h"
+#include "Parallel.h"
+
+int64_t const BellmanFord::Unreachable;
+uint32_t const BellmanFord::NoParent;
+uint32_t const BellmanFord::AllVertices;
+uint32_t const BellmanFord::SerialRelaxations;
+
+BellmanFord::BellmanFord(Graph const& graph, uint32_t const& source, uint32_t const& threads, RunControl* control) :
+	BellmanFord(CompressedGraph(graph), graph.IsWeighted(), source, threads, control)
+{
+}
+
+BellmanFord::BellmanFord(CompressedGraph const& graph, bool weighted, uint32_t const& source, uint32_t const& threads,
+	RunControl* control) :
+	_valid(source < graph.GetVertices() || source == AllVertices), _rounds(0), _distances(graph.GetVertices(), Unreachable),
+	_parents(graph.GetVertices(), NoParent)
+{
+	if (!_valid)
+		return;
+
+	GRAPH_STATS_COLLECTOR();
+	GRAPH_STATS_PHASE("bellman_ford_rounds");
+
+	uint32_t vertices = graph.GetVertices();
+	uint32_t threadCount = Parallel::GetThreads(threads);
+	Vector<std::atomic<int64_t>> distances(vertices);
+	Vector<Pair<uint32_t, int64_t>> frontier;		// Vertices improved by the previous round, with that distance.
+	Matrix<Relaxation> relaxations(threadCount);
+
+	for (uint32_t i = 0; i < vertices; ++i)
+		distances[i].store(Unreachable, std::memory_order_relaxed);
+
+	if (source == AllVertices)
+		for (uint32_t i = 0; i < vertices; ++i)
+		{
+			distances[i].store(0, std::memory_order_relaxed);
+			frontier.push_back(std::make_pair(i, 0));
+		}
+	else
+	{
+		distances[source].store(0, std::memory_order_relaxed);
+		frontier.push_back(std::make_pair(source, 0));
+	}
+
+	while (!frontier.empty())
+	{
+		if (control && !control->Poll(_rounds, vertices))
+		{
+			_valid = false;
+			return;
+		}
+
+		++_rounds;
+		GRAPH_STATS_ADD(VerticesVisited, frontier.size());
+
+		// Every round reads the distances the frontier had when it started, so after k rounds every path of at most
+		// k arcs is final and V rounds that still improve something prove a negative cycle.
+		Parallel::ForDynamic(0, frontier.size(), 256, threadCount, [&](uint64_t const& first, uint64_t const& last, uint32_t const& thread)
+		{
+			for (uint64_t i = first; i < last; ++i)
+			{
+				uint32_t vertex = frontier[i].first;
+
+				for (uint64_t arc = graph.GetBegin(vertex); arc < graph.GetEnd(vertex); ++arc)
+				{
+					uint32_t neighbour = graph.GetTarget(arc);
+					int64_t candidate = frontier[i].second + (weighted ? graph.GetWeight(arc) : 1);
+					int64_t current = distances[neighbour].load(std::memory_order_relaxed);
+
+					while (candidate < current && !distances[neighbour].compare_exchange_weak(current, candidate, std::memory_order_relaxed))
+						;
+
+					if (candidate < current)
+					{
+						Relaxation relaxation = { neighbour, vertex, candidate };
+
+						relaxations[thread].push_back(relaxation);
+					}
+				}
+			}
+		});
+
+		uint64_t relaxed = 0;
+
+		for (uint32_t i = 0; i < threadCount; ++i)
+			relaxed += relaxations[i].size();
+
+		// The successful swaps on a vertex strictly decrease, so exactly one relaxation per improved vertex matches
+		// its final distance and only that one writes the parent. A short round is not worth starting threads for.
+		Parallel::For(0, threadCount, (relaxed < SerialRelaxations) ? 1 : threadCount,
+			[&](uint64_t const& first, uint64_t const& last, uint32_t const&)
+		{
+			for (uint64_t i = first; i < last; ++i)
+			{
+				Vector<Relaxation>& list = relaxations[i];
+				uint64_t kept = 0;
+
+				for (uint64_t j = 0; j < list.size(); ++j)
+					if (list[j].length == distances[list[j].vertex].load(std::memory_order_relaxed))
+					{
+						_parents[list[j].vertex] = list[j].parent;
+						list[kept++] = list[j];
+					}
+
+				list.resize(kept);
+			}
+		});
+
+		frontier.clear();
+
+		for (uint32_t i = 0; i < threadCount; ++i)
+		{
+			for (uint64_t j = 0; j < relaxations[i].size(); ++j)
+				frontier.push_back(std::make_pair(relaxations[i][j].vertex, relaxations[i][j].length));
+
+			relaxations[i].clear();
+		}
+
+		// A cycle of parents is always negative, looking for one now and then ends most negative cycle searches long
+		// before round V.
+		if (!frontier.empty() && (_rounds >= vertices || (_rounds >= 16 && (_rounds & (_rounds - 1)) == 0)) && FindParentCycle())
+			break;
+	}
+
+	for (uint32_t i = 0; i < vertices; ++i)
+		_distances[i] = distances[i].load(std::memory_order_relaxed);
+
+	if (control)
+		control->Complete(vertices);
+}
+
+Vector<uint32_t> BellmanFord::GetPath(uint32_t const& target) const
+{
+	Vector<uint32_t> path;
+
+	if (!_valid || HasNegativeCycle() || target >= _distances.size() || _distances[target] == Unreachable)
+		return path;
+
+	for (uint32_t vertex = target; vertex != NoParent; vertex = _parents[vertex])
+		path.push_back(vertex);
+
+	std::reverse(path.begin(), path.end());
+
+	return path;
+}
+
+bool BellmanFord::FindParentCycle()
+{
+	// The parents form a functional graph, every walk is stamped with its start so it recognises its own tail.
+	Vector<uint32_t> walk(_parents.size(), NoParent);
+
+	for (uint32_t i = 0; i < _parents.size(); ++i)
+	{
+		uint32_t vertex = i;
+
+		while (vertex != NoParent && walk[vertex] == NoParent)
+		{
+			walk[vertex] = i;
+			vertex = _parents[vertex];
+		}
+
+		if (vertex == NoParent || walk[vertex] != i)
+			continue;
+
+		// Parents point backwards along the arcs.
+		uint32_t start = vertex;
+
+		do
+		{
+			_cycle.push_back(vertex);
+			vertex = _parents[vertex];
+		} while (vertex != start);
+
+		std::reverse(_cycle.begin(), _cycle.end());
+
+		return true;
+	}
+
+	return false;
+}
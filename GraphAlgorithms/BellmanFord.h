@@ -0,0 +1,66 @@
+#ifndef _BELLMAN_FORD_H
+#define _BELLMAN_FORD_H
+
+#include "PCH.h"
+#include "Graph.h"
+#include "CompressedGraph.h"
+#include "RunControl.h"
+
+// Single source shortest paths that accept negative weights; an unweighted graph counts hops. Every round relaxes
+// the out arcs of the vertices the previous round improved, in parallel, and the search stops as soon as a round
+// improves nothing. On an undirected graph a reachable negative edge is already a negative cycle of two arcs.
+class BellmanFord
+{
+	public:
+		static int64_t const Unreachable = INT64_MAX;
+		static uint32_t const NoParent = UINT32_MAX;
+
+		// AllVertices starts every vertex at distance 0, as from a virtual source with a 0 arc to each of them, which
+		// yields Johnson potentials and finds negative cycles anywhere in the graph.
+		static uint32_t const AllVertices = UINT32_MAX;
+
+		static uint32_t const SerialRelaxations = 4096;	// Rounds with fewer relaxations filter them on one thread.
+
+		// threads splits every round, 0 uses every hardware thread. The control is polled once per round, progress
+		// counts rounds out of at most V.
+		BellmanFord(Graph const& graph, uint32_t const& source, uint32_t const& threads = 0, RunControl* control = nullptr);
+		BellmanFord(CompressedGraph const& graph, bool weighted, uint32_t const& source, uint32_t const& threads = 0,
+			RunControl* control = nullptr);
+
+		// False when source is neither a valid vertex nor AllVertices, or when the control stopped the run.
+		bool IsValid() const { return _valid; }
+
+		// The distances and parents are meaningless when a negative cycle was found.
+		bool HasNegativeCycle() const { return !_cycle.empty(); }
+
+		// The vertices of one negative cycle in arc order, the last one has an arc back to the first.
+		Vector<uint32_t> const& GetNegativeCycle() const { return _cycle; }
+
+		int64_t GetDistance(uint32_t const& vertex) const { return _distances[vertex]; }
+		Vector<int64_t> const& GetDistances() const { return _distances; }
+		uint32_t GetParent(uint32_t const& vertex) const { return _parents[vertex]; }
+
+		// Vertices from the source to target, empty when target is unreachable or there is a negative cycle.
+		Vector<uint32_t> GetPath(uint32_t const& target) const;
+
+		uint32_t GetRounds() const { return _rounds; }
+
+	private:
+		// Successful relaxation of one round; it won when its length is the final distance of the round.
+		struct Relaxation
+		{
+			uint32_t vertex;
+			uint32_t parent;
+			int64_t length;
+		};
+
+		bool FindParentCycle();
+
+		bool _valid;
+		uint32_t _rounds;
+		Vector<int64_t> _distances;
+		Vector<uint32_t> _parents;
+		Vector<uint32_t> _cycle;
+};
+
+#endif
@@ -0,0 +1,175 @@
+#include "PCH.h"
+#include "BipartiteMatching.h"
+#include "Instrumentation.h"
+#include "Parallel.h"
+
+uint32_t const BipartiteMatching::NoMate;
+
+BipartiteMatching::BipartiteMatching(UndirectedGraph const& graph, uint32_t const& threads) : _bipartite(false), _size(0),
+	_freeLayer(UINT32_MAX)
+{
+	GRAPH_STATS_COLLECTOR();
+
+	_bipartite = graph.GetBipartition(&_color);
+	_mate.assign(graph.GetVertices(), NoMate);
+
+	if (!_bipartite)
+		return;
+
+	_graph = CompressedGraph(graph);
+
+	for (uint32_t i = 0; i < graph.GetVertices(); ++i)
+		if (_color[i] == 0 && _graph.GetDegree(i) != 0)
+			_left.push_back(i);
+
+	_layer.assign(graph.GetVertices(), UINT32_MAX);
+	_cursor.resize(graph.GetVertices());
+	_queue.reserve(_left.size());
+
+	{
+		GRAPH_STATS_PHASE("matching_greedy");
+		InitializeGreedy(threads);
+	}
+
+	GRAPH_STATS_PHASE("matching_augment");
+
+	while (BuildLayers())
+	{
+		for (uint32_t i = 0; i < _left.size(); ++i)
+			_cursor[_left[i]] = _graph.GetBegin(_left[i]);
+
+		for (uint32_t i = 0; i < _left.size(); ++i)
+			if (_mate[_left[i]] == NoMate && Augment(_left[i]))
+				++_size;
+	}
+}
+
+Vector<Pair<uint32_t, uint32_t>> BipartiteMatching::GetEdges() const
+{
+	Vector<Pair<uint32_t, uint32_t>> edges;
+
+	edges.reserve(_size);
+
+	for (uint32_t i = 0; i < _left.size(); ++i)
+		if (_mate[_left[i]] != NoMate)
+			edges.push_back(std::make_pair(_left[i], _mate[_left[i]]));
+
+	return edges;
+}
+
+void BipartiteMatching::InitializeGreedy(uint32_t const& threads)
+{
+	Vector<std::atomic<uint32_t>> owner(_mate.size());
+
+	for (uint32_t i = 0; i < owner.size(); ++i)
+		owner[i].store(NoMate, std::memory_order_relaxed);
+
+	// Each left vertex claims its first unowned neighbour; the claims race only on the right side.
+	Parallel::For(0, _left.size(), threads, [&](uint64_t const& first, uint64_t const& last, uint32_t const&)
+	{
+		for (uint64_t i = first; i < last; ++i)
+			for (uint64_t arc = _graph.GetBegin(_left[i]); arc < _graph.GetEnd(_left[i]); ++arc)
+			{
+				uint32_t expected = NoMate;
+
+				if (owner[_graph.GetTarget(arc)].load(std::memory_order_relaxed) == NoMate &&
+					owner[_graph.GetTarget(arc)].compare_exchange_strong(expected, _left[i]))
+				{
+					_mate[_left[i]] = _graph.GetTarget(arc);
+					break;
+				}
+			}
+	});
+
+	for (uint32_t i = 0; i < _left.size(); ++i)
+		if (_mate[_left[i]] != NoMate)
+		{
+			_mate[_mate[_left[i]]] = _left[i];
+			++_size;
+		}
+}
+
+bool BipartiteMatching::BuildLayers()
+{
+	GRAPH_STATS_COLLECTOR();
+
+	_queue.clear();
+	_freeLayer = UINT32_MAX;
+
+	for (uint32_t i = 0; i < _left.size(); ++i)
+		if (_mate[_left[i]] == NoMate)
+		{
+			_layer[_left[i]] = 0;
+			_queue.push_back(_left[i]);
+		}
+		else
+			_layer[_left[i]] = UINT32_MAX;
+
+	for (uint32_t head = 0; head < _queue.size(); ++head)
+	{
+		uint32_t element = _queue[head];
+
+		// Nothing beyond the first layer that reaches a free right vertex can be on a shortest augmenting path.
+		if (_layer[element] >= _freeLayer)
+			break;
+
+		GRAPH_STATS_ADD(VerticesVisited, 1);
+		GRAPH_STATS_ADD(EdgesScanned, _graph.GetDegree(element));
+
+		for (uint64_t arc = _graph.GetBegin(element); arc < _graph.GetEnd(element); ++arc)
+		{
+			uint32_t mate = _mate[_graph.GetTarget(arc)];
+
+			if (mate == NoMate)
+				_freeLayer = std::min(_freeLayer, _layer[element] + 1);
+			else if (_layer[mate] == UINT32_MAX)
+			{
+				_layer[mate] = _layer[element] + 1;
+				_queue.push_back(mate);
+			}
+		}
+	}
+
+	return _freeLayer != UINT32_MAX;
+}
+
+bool BipartiteMatching::Augment(uint32_t const& vertex)
+{
+	_stack.clear();
+	_stack.push_back(vertex);
+
+	while (!_stack.empty())
+	{
+		uint32_t element = _stack.back();
+
+		if (_cursor[element] == _graph.GetEnd(element))
+		{
+			_layer[element] = UINT32_MAX;	// Exhausted, no augmenting path passes through it in this phase.
+			_stack.pop_back();
+			continue;
+		}
+
+		uint32_t mate = _mate[_graph.GetTarget(_cursor[element])];
+
+		if (mate == NoMate && _layer[element] + 1 == _freeLayer)
+		{
+			// The cursors of the vertices on the stack point at the arcs of the augmenting path.
+			for (uint32_t i = 0; i < _stack.size(); ++i)
+			{
+				uint32_t right = _graph.GetTarget(_cursor[_stack[i]]);
+
+				_mate[_stack[i]] = right;
+				_mate[right] = _stack[i];
+			}
+
+			return true;
+		}
+
+		if (mate != NoMate && _layer[mate] == _layer[element] + 1)
+			_stack.push_back(mate);
+		else
+			++_cursor[element];
+	}
+
+	return false;
+}
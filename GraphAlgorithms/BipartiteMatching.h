@@ -0,0 +1,46 @@
+#ifndef _BIPARTITE_MATCHING_H
+#define _BIPARTITE_MATCHING_H
+
+#include "PCH.h"
+#include "UndirectedGraph.h"
+#include "CompressedGraph.h"
+
+// Hopcroft-Karp maximum cardinality matching, O(E * sqrt(V)). The sides are the two colors of
+// UndirectedGraph::GetBipartition, over all the components; color 0 vertices are the left side.
+class BipartiteMatching
+{
+	public:
+		static uint32_t const NoMate = UINT32_MAX;
+
+		// threads splits the greedy pass that seeds the matching, 0 uses every hardware thread.
+		explicit BipartiteMatching(UndirectedGraph const& graph, uint32_t const& threads = 1);
+
+		bool IsBipartite() const { return _bipartite; }
+		uint32_t GetSize() const { return _size; }
+
+		uint32_t GetMate(uint32_t const& vertex) const { return _mate[vertex]; }
+		Vector<char> const& GetColors() const { return _color; }
+
+		// Matched (left, right) pairs in ascending left vertex order.
+		Vector<Pair<uint32_t, uint32_t>> GetEdges() const;
+
+	private:
+		void InitializeGreedy(uint32_t const& threads);
+		bool BuildLayers();
+		bool Augment(uint32_t const& vertex);
+
+		CompressedGraph _graph;
+		bool _bipartite;
+		uint32_t _size;
+		uint32_t _freeLayer;			// Layer at which the last BFS reached a free right vertex.
+		Vector<char> _color;
+		Vector<uint32_t> _left;			// Non-isolated left vertices in ascending order.
+		Vector<uint32_t> _mate;
+		Vector<uint32_t> _layer;		// BFS layer of the left vertices, UINT32_MAX when unreached or exhausted.
+		Vector<uint64_t> _cursor;		// Next arc each left vertex tries in the current phase.
+		Vector<uint32_t> _queue;
+		Vector<uint32_t> _stack;
+};
+
+#endif
+
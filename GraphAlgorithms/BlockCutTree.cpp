@@ -0,0 +1,220 @@
+#include "PCH.h"
+#include "BlockCutTree.h"
+#include "Instrumentation.h"
+
+uint32_t const BlockCutTree::None;
+
+BlockCutTree::BlockCutTree(UndirectedGraph const& graph) : _components(graph.GetVertices(), None),
+	_cutIndex(graph.GetVertices(), None)
+{
+	GRAPH_STATS_COLLECTOR();
+	GRAPH_STATS_ADD(VerticesVisited, graph.GetVertices());
+	GRAPH_STATS_ADD(EdgesScanned, 2 * static_cast<uint64_t>(graph.GetEdges()));
+
+	uint32_t vertices = graph.GetVertices();
+
+	_blocks.Reset(vertices);
+	_twoEdgeComponents.Reset(vertices);
+
+	Vector<uint32_t>& depth = _blocks._depth;
+	Vector<uint32_t>& low = _blocks._low;
+	Vector<uint32_t>& blockStack = _blocks._stack;
+	Vector<uint32_t>& twoEdgeStack = _twoEdgeComponents._stack;
+	Vector<uint32_t> blockStarts(vertices);
+	Vector<uint32_t> twoEdgeStarts(vertices);
+	Vector<uint32_t> blockParents;
+	Vector<Frame> frames;
+	uint32_t time = 0;
+
+	auto discover = [&](uint32_t const& vertex)
+	{
+		depth[vertex] = low[vertex] = ++time;
+		blockStarts[vertex] = _blocks.GetCount();
+		twoEdgeStarts[vertex] = _twoEdgeComponents.GetCount();
+		blockStack.push_back(vertex);
+		twoEdgeStack.push_back(vertex);
+	};
+
+	// Labels the 2-edge-connected component of vertex, the rest of the stack above it.
+	auto closeTwoEdgeComponent = [&](uint32_t const& vertex, uint32_t const& bridge)
+	{
+		_twoEdgeFirst.push_back(twoEdgeStarts[vertex]);
+		_parentBridges.push_back(bridge);
+
+		while (twoEdgeStack.back() != vertex)
+		{
+			_twoEdgeComponents.Add(twoEdgeStack.back());
+			twoEdgeStack.pop_back();
+		}
+
+		_twoEdgeComponents.Add(vertex);
+		twoEdgeStack.pop_back();
+		_twoEdgeComponents.Close();
+	};
+
+	uint32_t components = 0;
+
+	for (uint32_t i = 0; i < vertices; ++i)
+	{
+		if (depth[i])
+			continue;
+
+		Frame root = { i, 0, true };
+
+		discover(i);
+		frames.push_back(root);
+
+		while (!frames.empty())
+		{
+			uint32_t vertex = frames.back().vertex;
+
+			if (frames.back().next < graph.GetNeighbours(vertex).size())
+			{
+				uint32_t neighbour = graph.GetNeighbours(vertex)[frames.back().next++].first;
+
+				if (!depth[neighbour])
+				{
+					Frame frame = { neighbour, 0, false };
+
+					discover(neighbour);
+					frames.push_back(frame);
+				}
+				else if (!frames.back().skipped && neighbour == frames[frames.size() - 2].vertex)
+					frames.back().skipped = true;
+				else
+					low[vertex] = std::min(low[vertex], depth[neighbour]);
+
+				continue;
+			}
+
+			frames.pop_back();
+			_components[vertex] = components;
+
+			if (frames.empty())
+			{
+				closeTwoEdgeComponent(vertex, None);
+				break;
+			}
+
+			uint32_t parent = frames.back().vertex;
+
+			low[parent] = std::min(low[parent], low[vertex]);
+
+			if (low[vertex] > depth[parent])
+			{
+				closeTwoEdgeComponent(vertex, static_cast<uint32_t>(_bridges.size()));
+				_bridges.push_back(std::make_pair(parent, vertex));
+			}
+
+			// parent separates the subtree of vertex, which is still on top of the stack.
+			if (low[vertex] >= depth[parent])
+			{
+				_blockFirst.push_back(blockStarts[vertex]);
+				blockParents.push_back(parent);
+
+				while (blockStack.back() != vertex)
+				{
+					_blocks.Add(blockStack.back());
+					blockStack.pop_back();
+				}
+
+				_blocks.Add(vertex);
+				blockStack.pop_back();
+				_blocks.Add(parent);
+				_blocks.Close();
+			}
+		}
+
+		blockStack.clear();
+		++components;
+	}
+
+	_blocks.ReleaseScratch();
+	_twoEdgeComponents.ReleaseScratch();
+
+	// A cut vertex is in more than one block.
+	Vector<uint32_t> blockCounts(vertices, 0);
+
+	for (uint64_t i = 0; i < _blocks._members.size(); ++i)
+		++blockCounts[_blocks._members[i]];
+
+	for (uint32_t i = 0; i < vertices; ++i)
+		if (blockCounts[i] > 1)
+		{
+			_cutIndex[i] = static_cast<uint32_t>(_cutVertices.size());
+			_cutVertices.push_back(i);
+		}
+
+	_childOffsets.assign(_cutVertices.size() + 1, 0);
+
+	for (uint32_t i = 0; i < blockParents.size(); ++i)
+		if (IsCutVertex(blockParents[i]))
+			++_childOffsets[_cutIndex[blockParents[i]] + 1];
+
+	for (uint32_t i = 0; i < _cutVertices.size(); ++i)
+		_childOffsets[i + 1] += _childOffsets[i];
+
+	Vector<uint32_t> next(_childOffsets.begin(), _childOffsets.end() - 1);
+
+	_childBlocks.resize(_childOffsets.back());
+
+	for (uint32_t i = 0; i < blockParents.size(); ++i)
+		if (IsCutVertex(blockParents[i]))
+			_childBlocks[next[_cutIndex[blockParents[i]]]++] = i;
+}
+
+bool BlockCutTree::IsConnectedWithoutVertex(uint32_t const& u, uint32_t const& v, uint32_t const& failed) const
+{
+	if (u == failed || v == failed || !IsConnected(u, v))
+		return false;
+
+	if (u == v || !IsCutVertex(failed))
+		return true;
+
+	// The failed cut vertex is on the block-cut tree path between them unless neither end is below it or one child
+	// subtree of it holds both, i.e. it is neither their lowest common ancestor nor between it and one end.
+	return GetChildBlock(failed, GetPoint(u)) == GetChildBlock(failed, GetPoint(v));
+}
+
+uint32_t BlockCutTree::GetChildBlock(uint32_t const& cutVertex, uint32_t const& point) const
+{
+	Vector<uint32_t>::const_iterator end = _childBlocks.begin() + _childOffsets[_cutIndex[cutVertex] + 1];
+	Vector<uint32_t>::const_iterator child = std::lower_bound(_childBlocks.begin() + _childOffsets[_cutIndex[cutVertex]], end, point);
+
+	return (child != end && _blockFirst[*child] <= point) ? *child : None;
+}
+
+bool BlockCutTree::IsConnectedWithoutEdge(uint32_t const& u, uint32_t const& v, uint32_t const& x, uint32_t const& y) const
+{
+	if (!IsConnected(u, v))
+		return false;
+
+	uint32_t child = GetBridgeChild(x, y);
+
+	if (child == None)
+		return true;
+
+	uint32_t uComponent = _twoEdgeComponents.GetComponent(u);
+	uint32_t vComponent = _twoEdgeComponents.GetComponent(v);
+
+	return (uComponent >= _twoEdgeFirst[child] && uComponent <= child) == (vComponent >= _twoEdgeFirst[child] && vComponent <= child);
+}
+
+uint32_t BlockCutTree::GetBridgeChild(uint32_t const& x, uint32_t const& y) const
+{
+	uint32_t components[2] = { _twoEdgeComponents.GetComponent(x), _twoEdgeComponents.GetComponent(y) };
+
+	if (components[0] == components[1])
+		return None;
+
+	for (uint32_t i = 0; i < 2; ++i)
+	{
+		uint32_t bridge = _parentBridges[components[i]];
+
+		if (bridge != None && ((_bridges[bridge].first == x && _bridges[bridge].second == y) ||
+			(_bridges[bridge].first == y && _bridges[bridge].second == x)))
+			return components[i];
+	}
+
+	return None;
+}
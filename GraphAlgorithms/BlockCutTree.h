@@ -0,0 +1,85 @@
+#ifndef _BLOCK_CUT_TREE_H
+#define _BLOCK_CUT_TREE_H
+
+#include "PCH.h"
+#include "UndirectedGraph.h"
+#include "ComponentLabels.h"
+
+// Blocks (biconnected components), cut vertices, bridges and 2-edge-connected components of an undirected graph from
+// one iterative DFS, kept as an index for failure queries. Blocks and 2-edge-connected components are labelled in DFS
+// post-order, so the subtree of a block in the block-cut tree, or of a component in the bridge tree, is a contiguous
+// label range and an ancestor test is two comparisons. A failed edge is answered in O(1), a failed vertex in O(log d)
+// for a cut vertex with d child blocks, by finding the child subtree that holds each endpoint. Parallel edges are
+// never bridges.
+class BlockCutTree
+{
+	public:
+		static uint32_t const None = UINT32_MAX;
+
+		explicit BlockCutTree(UndirectedGraph const& graph);
+
+		uint32_t GetVertices() const { return static_cast<uint32_t>(_components.size()); }
+
+		// A block lists its cut vertices too, as UndirectedGraph::GetBiconnectedComponents does.
+		ComponentLabels const& GetBlocks() const { return _blocks; }
+		ComponentLabels const& GetTwoEdgeConnectedComponents() const { return _twoEdgeComponents; }
+
+		// (parent, child) in DFS order.
+		Vector<Pair<uint32_t, uint32_t>> const& GetBridges() const { return _bridges; }
+		Vector<uint32_t> const& GetCutVertices() const { return _cutVertices; }
+
+		bool IsCutVertex(uint32_t const& vertex) const { return _cutIndex[vertex] != None; }
+		bool IsBridge(uint32_t const& x, uint32_t const& y) const { return GetBridgeChild(x, y) != None; }
+
+		bool IsConnected(uint32_t const& u, uint32_t const& v) const { return _components[u] == _components[v]; }
+		bool IsTwoEdgeConnected(uint32_t const& u, uint32_t const& v) const
+		{
+			return _twoEdgeComponents.GetComponent(u) == _twoEdgeComponents.GetComponent(v);
+		}
+
+		// Whether u and v stay connected once failed and its edges are removed; false when u or v is failed.
+		bool IsConnectedWithoutVertex(uint32_t const& u, uint32_t const& v, uint32_t const& failed) const;
+
+		// Whether u and v stay connected once the edge (x, y) is removed, which must be an edge of the graph. Of
+		// parallel edges only one is removed.
+		bool IsConnectedWithoutEdge(uint32_t const& u, uint32_t const& v, uint32_t const& x, uint32_t const& y) const;
+
+	private:
+		struct Frame
+		{
+			uint32_t vertex;
+			uint32_t next;
+			bool skipped;		// Whether the edge to the DFS parent was skipped, only the first copy of it is.
+		};
+
+		// The 2-edge-connected component below the bridge (x, y), None when (x, y) is not a bridge.
+		uint32_t GetBridgeChild(uint32_t const& x, uint32_t const& y) const;
+
+		// A block label in the block-cut subtree of a vertex that has a block: its only block, or the last child block
+		// of a cut vertex.
+		uint32_t GetPoint(uint32_t const& vertex) const
+		{
+			return IsCutVertex(vertex) ? _childBlocks[_childOffsets[_cutIndex[vertex] + 1] - 1] : _blocks.GetComponent(vertex);
+		}
+
+		// The child block of a cut vertex whose subtree holds the block label point, None when it is not below it.
+		uint32_t GetChildBlock(uint32_t const& cutVertex, uint32_t const& point) const;
+
+		Vector<uint32_t> _components;
+
+		ComponentLabels _blocks;
+		Vector<uint32_t> _blockFirst;			// The smallest block label in the subtree of every block.
+
+		// The child blocks of cut vertex c are [_childOffsets[c], _childOffsets[c + 1]) of _childBlocks, ascending.
+		Vector<uint32_t> _cutVertices;
+		Vector<uint32_t> _cutIndex;
+		Vector<uint32_t> _childOffsets;
+		Vector<uint32_t> _childBlocks;
+
+		ComponentLabels _twoEdgeComponents;
+		Vector<uint32_t> _twoEdgeFirst;
+		Vector<uint32_t> _parentBridges;		// The bridge above every 2-edge-connected component, None for a root.
+		Vector<Pair<uint32_t, uint32_t>> _bridges;
+};
+
+#endif
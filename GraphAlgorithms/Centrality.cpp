@@ -0,0 +1,262 @@
+#include "PCH.h"
+#include "Centrality.h"
+#include "GraphGenerator.h"
+#include "Instrumentation.h"
+#include "Parallel.h"
+
+uint32_t const Centrality::AllSources;
+
+Centrality::Centrality(UndirectedGraph const& graph, uint32_t const& samples, uint64_t const& seed, uint32_t const& threads,
+	RunControl* control) : _valid(false), _directed(false), _vertices(graph.GetVertices()), _sources(0)
+{
+	Compute(graph, samples, seed, threads, control);
+}
+
+Centrality::Centrality(DirectedGraph const& graph, uint32_t const& samples, uint64_t const& seed, uint32_t const& threads,
+	RunControl* control) : _valid(false), _directed(true), _vertices(graph.GetVertices()), _sources(0)
+{
+	Compute(graph, samples, seed, threads, control);
+}
+
+uint32_t Centrality::GetSampleCount(uint32_t const& vertices, double const& error, double const& confidence)
+{
+	if (vertices < 2 || error <= 0 || confidence >= 1)
+		return vertices;
+
+	// A normalized score is V / (V - 1) times the mean over all sources of a term in [0, 1].
+	double scale = static_cast<double>(vertices) / (vertices - 1);
+	double samples = std::ceil(scale * scale * std::log(4.0 * vertices / (1 - confidence)) / (2 * error * error));
+
+	return static_cast<uint32_t>(std::min<double>(samples, vertices));
+}
+
+double Centrality::GetNormalizedBetweenness(uint32_t const& vertex) const
+{
+	if (_vertices < 3)
+		return 0;
+
+	return _betweenness[vertex] * (_directed ? 1 : 2) / (static_cast<double>(_vertices - 1) * (_vertices - 2));
+}
+
+double Centrality::GetErrorBound(double const& confidence) const
+{
+	if (IsExact())
+		return 0;
+
+	if (!_sources || confidence >= 1)
+		return 1;
+
+	return static_cast<double>(_vertices) / (_vertices - 1) *
+		std::sqrt(std::log(4.0 * _vertices / (1 - confidence)) / (2.0 * _sources));
+}
+
+void Centrality::Compute(Graph const& graph, uint32_t const& samples, uint64_t const& seed, uint32_t const& threads,
+	RunControl* control)
+{
+	GRAPH_STATS_COLLECTOR();
+
+	CompressedGraph compressed(graph);
+	bool weighted = graph.IsWeighted();
+
+	for (uint64_t arc = 0; weighted && arc < compressed.GetArcs(); ++arc)
+		if (compressed.GetWeight(arc) <= 0)
+			return;
+
+	// The first samples entries of a partial Fisher-Yates shuffle, sorted back for locality.
+	Vector<uint32_t> sources(_vertices);
+
+	for (uint32_t i = 0; i < _vertices; ++i)
+		sources[i] = i;
+
+	_sources = std::min(samples, _vertices);
+
+	if (!IsExact())
+	{
+		RandomEngine random(seed);
+
+		for (uint32_t i = 0; i < _sources; ++i)
+			std::swap(sources[i], sources[i + random.NextBelow(_vertices - i)]);
+
+		sources.resize(_sources);
+		std::sort(sources.begin(), sources.end());
+	}
+
+	Vector<Workspace> workspaces(Parallel::GetThreads(threads));
+	std::atomic<uint64_t> done(0);
+	std::atomic<bool> stopped(false);
+
+	Parallel::ForDynamic(0, _sources, 16, threads, [&](uint64_t const& first, uint64_t const& last, uint32_t const& thread)
+	{
+		Workspace& workspace = workspaces[thread];
+
+		// Once the control says stop every remaining chunk returns right away.
+		if (stopped || (control && !control->Poll(done, _sources)))
+		{
+			stopped = true;
+			return;
+		}
+
+		if (workspace.distances.empty())
+		{
+			workspace.distances.assign(_vertices, INT64_MAX);
+			workspace.paths.assign(_vertices, 0);
+			workspace.dependencies.assign(_vertices, 0);
+			workspace.betweenness.assign(_vertices, 0);
+			workspace.closeness.assign(_vertices, 0);
+			workspace.visited = 0;
+			workspace.scanned = 0;
+		}
+
+		for (uint64_t i = first; i < last; ++i)
+			if (weighted)
+				Accumulate<true>(compressed, sources[i], &workspace);
+			else
+				Accumulate<false>(compressed, sources[i], &workspace);
+
+		done += last - first;
+	});
+
+	if (stopped)
+		return;
+
+	// Sampled sums stand for V / samples times as many sources; both directions of an undirected pair were counted.
+	double scale = _sources ? static_cast<double>(_vertices) / _sources : 0;
+
+	_betweenness.assign(_vertices, 0);
+	_closeness.assign(_vertices, 0);
+
+	for (uint32_t i = 0; i < workspaces.size(); ++i)
+	{
+		if (workspaces[i].distances.empty())
+			continue;
+
+		for (uint32_t j = 0; j < _vertices; ++j)
+		{
+			_betweenness[j] += workspaces[i].betweenness[j];
+			_closeness[j] += workspaces[i].closeness[j];
+		}
+
+		GRAPH_STATS_ADD(VerticesVisited, workspaces[i].visited);
+		GRAPH_STATS_ADD(EdgesScanned, workspaces[i].scanned);
+	}
+
+	for (uint32_t i = 0; i < _vertices; ++i)
+	{
+		_betweenness[i] *= _directed ? scale : scale / 2;
+		_closeness[i] = (_vertices > 1) ? _closeness[i] * scale / (_vertices - 1) : 0;
+	}
+
+	_valid = true;
+
+	if (control)
+		control->Complete(_sources);
+}
+
+template <bool _Weighted>
+void Centrality::Accumulate(CompressedGraph const& graph, uint32_t const& source, Workspace* workspace)
+{
+	Vector<int64_t>& distances = workspace->distances;
+	Vector<double>& paths = workspace->paths;
+	Vector<double>& dependencies = workspace->dependencies;
+	Vector<uint32_t>& order = workspace->order;
+	Vector<Pair<int64_t, uint32_t>>& heap = workspace->heap;
+	std::greater<Pair<int64_t, uint32_t>> compare;
+
+	distances[source] = 0;
+	paths[source] = 1;
+
+	// Shortest path counts in settle order. A weight is positive, so a vertex only gains paths before it is settled.
+	if (_Weighted)
+	{
+		heap.push_back(std::make_pair(0, source));
+
+		while (!heap.empty())
+		{
+			std::pop_heap(heap.begin(), heap.end(), compare);
+
+			int64_t length = heap.back().first;
+			uint32_t vertex = heap.back().second;
+
+			heap.pop_back();
+
+			if (length > distances[vertex])
+				continue;
+
+			order.push_back(vertex);
+
+			for (uint64_t arc = graph.GetBegin(vertex); arc < graph.GetEnd(vertex); ++arc)
+			{
+				uint32_t neighbour = graph.GetTarget(arc);
+				int64_t candidate = length + graph.GetWeight(arc);
+
+				if (candidate < distances[neighbour])
+				{
+					distances[neighbour] = candidate;
+					paths[neighbour] = paths[vertex];
+					heap.push_back(std::make_pair(candidate, neighbour));
+					std::push_heap(heap.begin(), heap.end(), compare);
+				}
+				else if (candidate == distances[neighbour])
+					paths[neighbour] += paths[vertex];
+			}
+		}
+	}
+	else
+	{
+		order.push_back(source);
+
+		for (uint64_t head = 0; head < order.size(); ++head)
+		{
+			uint32_t vertex = order[head];
+
+			for (uint64_t arc = graph.GetBegin(vertex); arc < graph.GetEnd(vertex); ++arc)
+			{
+				uint32_t neighbour = graph.GetTarget(arc);
+
+				if (distances[neighbour] == INT64_MAX)
+				{
+					distances[neighbour] = distances[vertex] + 1;
+					order.push_back(neighbour);
+				}
+
+				if (distances[neighbour] == distances[vertex] + 1)
+					paths[neighbour] += paths[vertex];
+			}
+		}
+	}
+
+	// The successors of a vertex come after it in settle order, so their dependencies are final when it is reached.
+	for (uint64_t i = order.size(); i-- > 0;)
+	{
+		uint32_t vertex = order[i];
+		double dependency = 0;
+
+		for (uint64_t arc = graph.GetBegin(vertex); arc < graph.GetEnd(vertex); ++arc)
+		{
+			uint32_t neighbour = graph.GetTarget(arc);
+
+			if (distances[neighbour] == distances[vertex] + (_Weighted ? graph.GetWeight(arc) : 1))
+				dependency += (1 + dependencies[neighbour]) / paths[neighbour];
+		}
+
+		dependencies[vertex] = dependency * paths[vertex];
+
+		if (vertex != source)
+		{
+			workspace->betweenness[vertex] += dependencies[vertex];
+			workspace->closeness[vertex] += 1.0 / distances[vertex];
+		}
+	}
+
+	workspace->visited += order.size();
+
+	for (uint64_t i = 0; i < order.size(); ++i)
+	{
+		workspace->scanned += 2 * graph.GetDegree(order[i]);
+		distances[order[i]] = INT64_MAX;
+		paths[order[i]] = 0;
+		dependencies[order[i]] = 0;
+	}
+
+	order.clear();
+}
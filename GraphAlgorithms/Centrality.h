@@ -0,0 +1,82 @@
+#ifndef _CENTRALITY_H
+#define _CENTRALITY_H
+
+#include "PCH.h"
+#include "UndirectedGraph.h"
+#include "DirectedGraph.h"
+#include "CompressedGraph.h"
+#include "RunControl.h"
+
+// Betweenness and harmonic closeness centrality by Brandes' algorithm: one search per source counts the shortest
+// paths to every vertex in settle order, a BFS on an unweighted graph and Dijkstra on a weighted one, then walks that
+// order backwards accumulating each vertex's dependency on its successors, so no predecessor lists are kept. Sources
+// are shared among the threads, each with its own search workspace and score accumulators that are summed at the end.
+// The sampled mode runs a uniform sample of distinct sources and scales their sums by V / samples; every score is then
+// an unbiased estimate, and GetErrorBound gives its deviation from Hoeffding's inequality. Parallel edges count as
+// distinct paths; weights must be positive.
+class Centrality
+{
+	public:
+		static uint32_t const AllSources = UINT32_MAX;
+
+		// samples distinct sources drawn with the seed, every vertex with AllSources or samples >= V. threads splits
+		// the sources, 0 uses every hardware thread; the control is polled between chunks of sources, progress counts
+		// sources.
+		explicit Centrality(UndirectedGraph const& graph, uint32_t const& samples = AllSources, uint64_t const& seed = 0,
+			uint32_t const& threads = 0, RunControl* control = nullptr);
+		explicit Centrality(DirectedGraph const& graph, uint32_t const& samples = AllSources, uint64_t const& seed = 0,
+			uint32_t const& threads = 0, RunControl* control = nullptr);
+
+		// Samples after which every normalized score is within error of the exact one with the given confidence, the
+		// union bound taken over both scores of all vertices.
+		static uint32_t GetSampleCount(uint32_t const& vertices, double const& error, double const& confidence);
+
+		// False when a weight is not positive or the control stopped the run, then there are no scores.
+		bool IsValid() const { return _valid; }
+		bool IsExact() const { return _sources == _vertices; }
+		uint32_t GetSources() const { return _sources; }
+
+		// Over the pairs s != v != t, the fraction of the shortest paths from s to t through v; an undirected graph counts
+		// every pair once.
+		Vector<double> const& GetBetweenness() const { return _betweenness; }
+
+		// Betweenness over the number of pairs it counts, in [0, 1].
+		double GetNormalizedBetweenness(uint32_t const& vertex) const;
+
+		// Sum of 1 / d(u, v) over the vertices u != v that reach v, divided by V - 1, so in [0, 1] and defined on
+		// disconnected graphs. On a directed graph the distances run into v; the transpose gives them out of it.
+		Vector<double> const& GetCloseness() const { return _closeness; }
+
+		// Deviation that no normalized score exceeds with the given confidence, 0 when every vertex was a source.
+		double GetErrorBound(double const& confidence) const;
+
+	private:
+		struct Workspace
+		{
+			Vector<int64_t> distances;
+			Vector<double> paths;
+			Vector<double> dependencies;
+			Vector<uint32_t> order;			// Reached vertices in settle order.
+			Vector<Pair<int64_t, uint32_t>> heap;
+			Vector<double> betweenness;
+			Vector<double> closeness;
+			uint64_t visited;
+			uint64_t scanned;
+		};
+
+		void Compute(Graph const& graph, uint32_t const& samples, uint64_t const& seed, uint32_t const& threads,
+			RunControl* control);
+
+		// Brandes' search from source, adding its dependencies and inverse distances to the workspace's scores.
+		template <bool _Weighted>
+		static void Accumulate(CompressedGraph const& graph, uint32_t const& source, Workspace* workspace);
+
+		bool _valid;
+		bool _directed;
+		uint32_t _vertices;
+		uint32_t _sources;
+		Vector<double> _betweenness;
+		Vector<double> _closeness;
+};
+
+#endif
@@ -0,0 +1,34 @@
+#include "PCH.h"
+#include "ComponentLabels.h"
+
+uint32_t const ComponentLabels::None;
+
+Matrix<uint32_t> ComponentLabels::ToMatrix() const
+{
+	Matrix<uint32_t> components(GetCount());
+
+	for (uint32_t i = 0; i < GetCount(); ++i)
+		components[i].assign(_members.begin() + _offsets[i], _members.begin() + _offsets[i + 1]);
+
+	return components;
+}
+
+void ComponentLabels::Reset(uint32_t const& vertices)
+{
+	// assign and clear keep the capacity.
+	_labels.assign(vertices, None);
+	_offsets.assign(1, 0);
+	_members.clear();
+	_depth.assign(vertices, 0);
+	_low.resize(vertices);
+	_stack.clear();
+	_frames.clear();
+}
+
+void ComponentLabels::ReleaseScratch()
+{
+	Vector<uint32_t>().swap(_depth);
+	Vector<uint32_t>().swap(_low);
+	Vector<uint32_t>().swap(_stack);
+	Vector<Frame>().swap(_frames);
+}
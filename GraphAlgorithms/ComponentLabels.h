@@ -0,0 +1,64 @@
+#ifndef _COMPONENT_LABELS_H
+#define _COMPONENT_LABELS_H
+
+#include "PCH.h"
+
+// Components as two flat arrays: the component of every vertex, and the members of component c in
+// [GetBegin(c), GetEnd(c)) of one members array. Refilling an instance reuses its buffers, together with the
+// traversal scratch it keeps for the algorithms, so repeated runs on graphs of the same size allocate nothing.
+class ComponentLabels
+{
+	public:
+		static uint32_t const None = UINT32_MAX;
+
+		ComponentLabels() : _offsets(1, 0) { }
+
+		uint32_t GetCount() const { return static_cast<uint32_t>(_offsets.size() - 1); }
+		uint32_t GetVertices() const { return static_cast<uint32_t>(_labels.size()); }
+
+		// None for a vertex outside every component, e.g. an isolated vertex has no biconnected component.
+		uint32_t GetComponent(uint32_t const& vertex) const { return _labels[vertex]; }
+		Vector<uint32_t> const& GetComponents() const { return _labels; }
+
+		uint64_t GetBegin(uint32_t const& component) const { return _offsets[component]; }
+		uint64_t GetEnd(uint32_t const& component) const { return _offsets[component + 1]; }
+		uint32_t GetSize(uint32_t const& component) const { return static_cast<uint32_t>(_offsets[component + 1] - _offsets[component]); }
+		uint32_t GetMember(uint64_t const& index) const { return _members[index]; }
+
+		// One vector per component, as the Matrix returning APIs give them.
+		Matrix<uint32_t> ToMatrix() const;
+
+	private:
+		friend class UndirectedGraph;
+		friend class Traversal;
+		friend class BlockCutTree;
+
+		// A suspended DFS call: the vertex and the index of the next neighbour it scans.
+		struct Frame
+		{
+			uint32_t vertex;
+			uint32_t next;
+		};
+
+		void Reset(uint32_t const& vertices);
+		void ReleaseScratch();		// For labels kept long after they were computed.
+
+		void Add(uint32_t const& vertex)
+		{
+			_labels[vertex] = GetCount();
+			_members.push_back(vertex);
+		}
+
+		void Close() { _offsets.push_back(_members.size()); }
+
+		Vector<uint32_t> _labels;
+		Vector<uint64_t> _offsets;
+		Vector<uint32_t> _members;
+
+		Vector<uint32_t> _depth;
+		Vector<uint32_t> _low;
+		Vector<uint32_t> _stack;
+		Vector<Frame> _frames;
+};
+
+#endif
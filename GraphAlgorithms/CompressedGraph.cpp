@@ -0,0 +1,77 @@
+#include "PCH.h"
+#include "CompressedGraph.h"
+
+CompressedGraph::CompressedGraph(Graph const& graph) : _offsets(graph.GetVertices() + 1, 0)
+{
+	for (uint32_t i = 0; i < graph.GetVertices(); ++i)
+		_offsets[i + 1] = _offsets[i] + graph.GetNeighbours(i).size();
+
+	_targets.resize(_offsets.back());
+	_weights.resize(_offsets.back());
+
+	for (uint32_t i = 0; i < graph.GetVertices(); ++i)
+	{
+		uint64_t arc = _offsets[i];
+
+		for (AdjacencyListConstIterator itr = graph.GetNeighbours(i).begin(); itr != graph.GetNeighbours(i).end(); ++itr, ++arc)
+		{
+			_targets[arc] = itr->first;
+			_weights[arc] = itr->second;
+		}
+	}
+}
+
+CompressedGraph CompressedGraph::GetTranspose() const
+{
+	CompressedGraph transpose;
+	Vector<uint64_t> position;
+
+	transpose._offsets.assign(GetVertices() + 1, 0);
+	transpose._targets.resize(GetArcs());
+	transpose._weights.resize(GetArcs());
+
+	for (uint64_t arc = 0; arc < GetArcs(); ++arc)
+		++transpose._offsets[_targets[arc] + 1];
+
+	for (uint32_t i = 0; i < GetVertices(); ++i)
+		transpose._offsets[i + 1] += transpose._offsets[i];
+
+	position = transpose._offsets;
+
+	for (uint32_t i = 0; i < GetVertices(); ++i)
+		for (uint64_t arc = _offsets[i]; arc < _offsets[i + 1]; ++arc)
+		{
+			uint64_t reversedArc = position[_targets[arc]]++;
+
+			transpose._targets[reversedArc] = i;
+			transpose._weights[reversedArc] = _weights[arc];
+		}
+
+	return transpose;
+}
+
+CompressedGraph& CompressedGraph::operator=(CompressedGraph const& source)
+{
+	if (this == &source)
+		return *this;
+
+	_offsets = source._offsets;
+	_targets = source._targets;
+	_weights = source._weights;
+
+	return *this;
+}
+
+CompressedGraph& CompressedGraph::operator=(CompressedGraph&& source)
+{
+	if (this == &source)
+		return *this;
+
+	_offsets = std::move(source._offsets);
+	_targets = std::move(source._targets);
+	_weights = std::move(source._weights);
+	source._offsets.assign(1, 0);
+
+	return *this;
+}
+
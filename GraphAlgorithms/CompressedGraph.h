@@ -0,0 +1,42 @@
+#ifndef _COMPRESSED_GRAPH_H
+#define _COMPRESSED_GRAPH_H
+
+#include "PCH.h"
+#include "Graph.h"
+
+// Read-only compressed sparse row copy of a graph's adjacency list: the arcs of vertex v are
+// [GetBegin(v), GetEnd(v)) in two flat arrays, so the kernels scan contiguous memory.
+class CompressedGraph
+{
+	public:
+		CompressedGraph() : _offsets(1, 0) { }
+		explicit CompressedGraph(Graph const& graph);
+		CompressedGraph(CompressedGraph const& source) : _offsets(source._offsets), _targets(source._targets),
+			_weights(source._weights) { }
+		CompressedGraph(CompressedGraph&& source) : _offsets(std::move(source._offsets)), _targets(std::move(source._targets)),
+			_weights(std::move(source._weights)) { source._offsets.assign(1, 0); }
+
+		uint32_t GetVertices() const { return static_cast<uint32_t>(_offsets.size() - 1); }
+		uint64_t GetArcs() const { return _targets.size(); }
+
+		uint64_t GetBegin(uint32_t const& vertex) const { return _offsets[vertex]; }
+		uint64_t GetEnd(uint32_t const& vertex) const { return _offsets[vertex + 1]; }
+		uint32_t GetDegree(uint32_t const& vertex) const { return static_cast<uint32_t>(_offsets[vertex + 1] - _offsets[vertex]); }
+
+		uint32_t GetTarget(uint64_t const& arc) const { return _targets[arc]; }
+		int32_t GetWeight(uint64_t const& arc) const { return _weights[arc]; }
+
+		// Same vertices with every arc reversed; the arcs of a vertex keep ascending source order.
+		CompressedGraph GetTranspose() const;
+
+		CompressedGraph& operator=(CompressedGraph const& source);
+		CompressedGraph& operator=(CompressedGraph&& source);
+
+	private:
+		Vector<uint64_t> _offsets;
+		Vector<uint32_t> _targets;
+		Vector<int32_t> _weights;
+};
+
+#endif
+
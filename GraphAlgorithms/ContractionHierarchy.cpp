@@ -0,0 +1,857 @@
+#include "PCH.h"
+#include "ContractionHierarchy.h"
+#include "Instrumentation.h"
+#include "Parallel.h"
+
+uint32_t const ContractionHierarchy::None;
+
+// Preprocessing state: the remaining graph as out and in arc lists, trimmed as the vertices get contracted.
+class ContractionHierarchy::Contraction
+{
+	public:
+		Contraction(Graph const& graph, uint32_t const& threads);
+
+		// Contracts everything, ranks[v] is the contraction round order and upward[side][v] the arcs v had left.
+		void Run(Vector<uint32_t>* ranks, Matrix<Arc>* upward);
+
+	private:
+		static uint32_t const WitnessSettleLimit = 50;
+		static uint32_t const MinimumRound = 256;		// Candidates a round takes at least.
+		static uint32_t const RoundShare = 8;			// And at most this share of the remaining vertices beyond that.
+
+		struct Shortcut
+		{
+			uint32_t from;
+			uint32_t to;
+			int32_t weight;
+			uint32_t middle;
+		};
+
+		// Queue entry, stale once the vertex was queued again with a newer version.
+		struct Candidate
+		{
+			int32_t priority;
+			uint32_t hash;					// Breaks ties, an odd multiplier is a bijection.
+			uint32_t vertex;
+			uint32_t version;
+
+			bool operator>(Candidate const& other) const
+				{ return priority > other.priority || (priority == other.priority && hash > other.hash); }
+		};
+
+		struct Witness
+		{
+			Witness() : epoch(0) { }
+
+			uint32_t epoch;
+			Vector<int64_t> distance;
+			Vector<uint32_t> reached;
+			Vector<uint32_t> targets;		// Epoch in which the vertex was marked as a target.
+			Vector<Pair<int64_t, uint32_t>> heap;
+		};
+
+		// Shortcuts needed to contract vertex, counted only when shortcuts is nullptr.
+		uint64_t FindShortcuts(uint32_t const& vertex, Witness* witness, Vector<Shortcut>* shortcuts) const;
+		void SearchWitnesses(uint32_t const& source, uint32_t const& vertex, int64_t const& limit, Witness* witness) const;
+
+		int32_t GetPriority(uint32_t const& vertex, Witness* witness) const;
+
+		// Adds the (owner, arc) pairs to the lists of their owners, the lighter of two arcs to one target wins. arcs
+		// keeps the pairs that changed a list.
+		void Merge(Matrix<Arc>* lists, Vector<Pair<uint32_t, Arc>>* arcs);
+		void RemoveContracted(Vector<Arc>* arcs) const;
+
+		uint32_t _threads;
+		Matrix<Arc> _out;
+		Matrix<Arc> _in;
+		Vector<int32_t> _priorities;
+		Vector<uint32_t> _contractedNeighbours;
+		Vector<uint32_t> _levels;			// Longest chain of contracted vertices below each vertex.
+		Vector<char> _contracting;		// Members of the current round, witness paths must avoid them.
+		Vector<uint32_t> _positions;		// Index of each target in the list being merged, None otherwise.
+		Vector<Witness> _witnesses;		// One per thread.
+};
+
+uint32_t const ContractionHierarchy::Contraction::WitnessSettleLimit;
+uint32_t const ContractionHierarchy::Contraction::MinimumRound;
+uint32_t const ContractionHierarchy::Contraction::RoundShare;
+
+ContractionHierarchy::Contraction::Contraction(Graph const& graph, uint32_t const& threads) :
+	_threads(Parallel::GetThreads(threads)), _out(graph.GetVertices()), _in(graph.GetVertices()),
+	_priorities(graph.GetVertices(), 0), _contractedNeighbours(graph.GetVertices(), 0), _levels(graph.GetVertices(), 0), _contracting(graph.GetVertices(), 0),
+	_positions(graph.GetVertices(), None), _witnesses(_threads)
+{
+	for (uint32_t i = 0; i < graph.GetVertices(); ++i)
+		for (AdjacencyListConstIterator itr = graph.GetNeighbours(i).begin(); itr != graph.GetNeighbours(i).end(); ++itr)
+			if (itr->first != i)
+			{
+				Arc arc = { itr->first, graph.IsWeighted() ? itr->second : 1, None };
+
+				_out[i].push_back(arc);
+				arc.target = i;
+				_in[itr->first].push_back(arc);
+			}
+
+	// Only the lightest of parallel edges matters.
+	auto compare = [](Arc const& first, Arc const& second)
+		{ return first.target < second.target || (first.target == second.target && first.weight < second.weight); };
+	auto sameTarget = [](Arc const& first, Arc const& second) { return first.target == second.target; };
+
+	Parallel::For(0, graph.GetVertices(), _threads, [&](uint64_t const& first, uint64_t const& last, uint32_t const&)
+	{
+		for (uint64_t i = first; i < last; ++i)
+		{
+			std::sort(_out[i].begin(), _out[i].end(), compare);
+			_out[i].erase(std::unique(_out[i].begin(), _out[i].end(), sameTarget), _out[i].end());
+			std::sort(_in[i].begin(), _in[i].end(), compare);
+			_in[i].erase(std::unique(_in[i].begin(), _in[i].end(), sameTarget), _in[i].end());
+		}
+	});
+}
+
+void ContractionHierarchy::Contraction::Run(Vector<uint32_t>* ranks, Matrix<Arc>* upward)
+{
+	uint32_t vertices = static_cast<uint32_t>(_out.size());
+	uint32_t rank = 0;
+	uint32_t round = 0;
+	Vector<uint32_t> versions(vertices, 0);
+	Vector<uint32_t> claims(vertices, 0);		// Last round that had the vertex as a candidate.
+	Vector<uint32_t> touched;
+	Vector<uint32_t> deferred;
+	Vector<uint32_t> stale;
+	Vector<char> isTouched(vertices, 0);
+	Vector<char> dirty(vertices, 0);		// The priority changed since the vertex was queued.
+	PriorityQueue<Candidate, Vector<Candidate>, std::greater<Candidate>> queue;
+
+	ranks->assign(vertices, None);
+	upward[0].assign(vertices, Vector<Arc>());
+	upward[1].assign(vertices, Vector<Arc>());
+
+	Parallel::ForDynamic(0, vertices, 256, _threads, [&](uint64_t const& first, uint64_t const& last, uint32_t const& thread)
+	{
+		for (uint64_t i = first; i < last; ++i)
+			_priorities[i] = GetPriority(static_cast<uint32_t>(i), &_witnesses[thread]);
+	});
+
+	auto enqueue = [&](uint32_t const& vertex)
+		{
+			Candidate candidate = { _priorities[vertex], vertex * 2654435761U, vertex, ++versions[vertex] };
+
+			queue.push(candidate);
+		};
+
+	// Claims vertex for the round, true when neither it nor a neighbour was an earlier candidate. Witness searches
+	// avoid the whole round, so two members may share a neighbour; a hub does not hold its leaves back one per round.
+	auto claim = [&](uint32_t const& vertex)
+		{
+			bool free = claims[vertex] != round;
+
+			for (uint32_t i = 0; i < _out[vertex].size(); ++i)
+				free = free && claims[_out[vertex][i].target] != round;
+
+			for (uint32_t i = 0; i < _in[vertex].size(); ++i)
+				free = free && claims[_in[vertex][i].target] != round;
+
+			claims[vertex] = round;
+
+			return free;
+		};
+
+	for (uint32_t i = 0; i < vertices; ++i)
+		enqueue(i);
+
+	while (!queue.empty())
+	{
+		uint32_t limit = std::max(MinimumRound, (vertices - rank) / RoundShare);
+		uint32_t popped = 0;
+		Vector<uint32_t> batch;
+
+		++round;
+
+		// The lowest candidates leave the queue in priority order. A dirty one is only reevaluated and queued again, one
+		// next to an earlier candidate of the round is not a local minimum and waits for the next round, and the others
+		// form an independent set.
+		while (!queue.empty() && popped < limit)
+		{
+			Candidate candidate = queue.top();
+
+			queue.pop();
+
+			if (candidate.version != versions[candidate.vertex])
+				continue;
+
+			++popped;
+
+			if (dirty[candidate.vertex])
+				stale.push_back(candidate.vertex);
+			else if (claim(candidate.vertex))
+			{
+				batch.push_back(candidate.vertex);
+				_contracting[candidate.vertex] = 1;
+			}
+			else
+				deferred.push_back(candidate.vertex);
+		}
+
+		Matrix<Shortcut> shortcuts(batch.size());
+
+		Parallel::ForDynamic(0, batch.size(), 16, _threads, [&](uint64_t const& first, uint64_t const& last, uint32_t const& thread)
+		{
+			for (uint64_t i = first; i < last; ++i)
+				FindShortcuts(batch[i], &_witnesses[thread], &shortcuts[i]);
+		});
+
+		// The round is independent, so the neighbours of a contracted vertex are all still in the graph.
+		for (uint32_t i = 0; i < batch.size(); ++i)
+		{
+			uint32_t vertex = batch[i];
+
+			(*ranks)[vertex] = rank++;
+
+			for (uint32_t j = 0; j < _in[vertex].size(); ++j)
+			{
+				++_contractedNeighbours[_in[vertex][j].target];
+				_levels[_in[vertex][j].target] = std::max(_levels[_in[vertex][j].target], _levels[vertex] + 1);
+				touched.push_back(_in[vertex][j].target);
+			}
+
+			for (uint32_t j = 0; j < _out[vertex].size(); ++j)
+			{
+				++_contractedNeighbours[_out[vertex][j].target];
+				_levels[_out[vertex][j].target] = std::max(_levels[_out[vertex][j].target], _levels[vertex] + 1);
+				touched.push_back(_out[vertex][j].target);
+			}
+
+			upward[0][vertex].swap(_out[vertex]);
+			upward[1][vertex].swap(_in[vertex]);
+		}
+
+		uint32_t kept = 0;
+
+		for (uint32_t i = 0; i < touched.size(); ++i)
+			if (!isTouched[touched[i]])
+			{
+				isTouched[touched[i]] = 1;
+				touched[kept++] = touched[i];
+			}
+
+		touched.resize(kept);
+
+		// Every neighbour drops its arcs to the round in one pass over its lists.
+		Parallel::ForDynamic(0, touched.size(), 64, _threads, [&](uint64_t const& first, uint64_t const& last, uint32_t const&)
+		{
+			for (uint64_t i = first; i < last; ++i)
+			{
+				RemoveContracted(&_out[touched[i]]);
+				RemoveContracted(&_in[touched[i]]);
+			}
+		});
+
+		for (uint32_t i = 0; i < batch.size(); ++i)
+			_contracting[batch[i]] = 0;
+
+		Vector<Pair<uint32_t, Arc>> arcs;
+
+		for (uint32_t i = 0; i < shortcuts.size(); ++i)
+			for (uint32_t j = 0; j < shortcuts[i].size(); ++j)
+			{
+				Arc arc = { shortcuts[i][j].to, shortcuts[i][j].weight, shortcuts[i][j].middle };
+
+				arcs.push_back(std::make_pair(shortcuts[i][j].from, arc));
+			}
+
+		Merge(&_out, &arcs);
+
+		for (uint64_t i = 0; i < arcs.size(); ++i)
+			std::swap(arcs[i].first, arcs[i].second.target);
+
+		Merge(&_in, &arcs);
+
+		// Only the neighbours of the round changed priority. They keep their entries until these come up, so a hub
+		// touched in every round is not reevaluated in every round.
+		for (uint32_t i = 0; i < touched.size(); ++i)
+		{
+			isTouched[touched[i]] = 0;
+			dirty[touched[i]] = 1;
+		}
+
+		Parallel::ForDynamic(0, stale.size(), 64, _threads, [&](uint64_t const& first, uint64_t const& last, uint32_t const& thread)
+		{
+			for (uint64_t i = first; i < last; ++i)
+				_priorities[stale[i]] = GetPriority(stale[i], &_witnesses[thread]);
+		});
+
+		for (uint32_t i = 0; i < stale.size(); ++i)
+		{
+			dirty[stale[i]] = 0;
+			enqueue(stale[i]);
+		}
+
+		for (uint32_t i = 0; i < deferred.size(); ++i)
+			enqueue(deferred[i]);
+
+		deferred.clear();
+		stale.clear();
+		touched.clear();
+	}
+}
+
+uint64_t ContractionHierarchy::Contraction::FindShortcuts(uint32_t const& vertex, Witness* witness, Vector<Shortcut>* shortcuts) const
+{
+	uint64_t count = 0;
+
+	for (uint32_t i = 0; i < _in[vertex].size(); ++i)
+	{
+		uint32_t source = _in[vertex][i].target;
+		int64_t limit = -1;
+
+		for (uint32_t j = 0; j < _out[vertex].size(); ++j)
+			if (_out[vertex][j].target != source)
+				limit = std::max<int64_t>(limit, static_cast<int64_t>(_in[vertex][i].weight) + _out[vertex][j].weight);
+
+		if (limit < 0)
+			continue;
+
+		SearchWitnesses(source, vertex, limit, witness);
+
+		for (uint32_t j = 0; j < _out[vertex].size(); ++j)
+		{
+			uint32_t target = _out[vertex][j].target;
+			int64_t length = static_cast<int64_t>(_in[vertex][i].weight) + _out[vertex][j].weight;
+
+			if (target == source || (witness->reached[target] == witness->epoch && witness->distance[target] <= length))
+				continue;
+
+			++count;
+
+			if (shortcuts)
+			{
+				Shortcut shortcut = { source, target, static_cast<int32_t>(length), vertex };
+
+				shortcuts->push_back(shortcut);
+			}
+		}
+	}
+
+	return count;
+}
+
+void ContractionHierarchy::Contraction::SearchWitnesses(uint32_t const& source, uint32_t const& vertex, int64_t const& limit,
+	Witness* witness) const
+{
+	std::greater<Pair<int64_t, uint32_t>> compare;
+	uint32_t settled = 0;
+
+	if (witness->distance.empty())
+	{
+		witness->distance.resize(_out.size());
+		witness->reached.assign(_out.size(), 0);
+		witness->targets.assign(_out.size(), 0);
+	}
+
+	if (++witness->epoch == 0)
+	{
+		std::fill(witness->reached.begin(), witness->reached.end(), 0);
+		std::fill(witness->targets.begin(), witness->targets.end(), 0);
+		witness->epoch = 1;
+	}
+
+	uint32_t targets = 0;
+
+	for (uint32_t i = 0; i < _out[vertex].size(); ++i)
+		if (_out[vertex][i].target != source)
+		{
+			witness->targets[_out[vertex][i].target] = witness->epoch;
+			++targets;
+		}
+
+	witness->heap.clear();
+	witness->distance[source] = 0;
+	witness->reached[source] = witness->epoch;
+	witness->heap.push_back(std::make_pair(0, source));
+
+	// Bounded Dijkstra that avoids the contracted vertex and the rest of its round, it stops once every target is
+	// settled. Giving up early only costs superfluous shortcuts.
+	while (!witness->heap.empty() && settled < WitnessSettleLimit)
+	{
+		std::pop_heap(witness->heap.begin(), witness->heap.end(), compare);
+
+		int64_t length = witness->heap.back().first;
+		uint32_t element = witness->heap.back().second;
+
+		witness->heap.pop_back();
+
+		if (length > witness->distance[element])
+			continue;
+
+		if (length > limit)
+			break;
+
+		if (witness->targets[element] == witness->epoch && --targets == 0)
+			break;
+
+		++settled;
+
+		for (uint32_t i = 0; i < _out[element].size(); ++i)
+		{
+			uint32_t neighbour = _out[element][i].target;
+			int64_t candidate = length + _out[element][i].weight;
+
+			if (neighbour == vertex || _contracting[neighbour])
+				continue;
+
+			if (witness->reached[neighbour] != witness->epoch || candidate < witness->distance[neighbour])
+			{
+				witness->distance[neighbour] = candidate;
+				witness->reached[neighbour] = witness->epoch;
+				witness->heap.push_back(std::make_pair(candidate, neighbour));
+				std::push_heap(witness->heap.begin(), witness->heap.end(), compare);
+			}
+		}
+	}
+}
+
+int32_t ContractionHierarchy::Contraction::GetPriority(uint32_t const& vertex, Witness* witness) const
+{
+	// Edge difference weighted double, plus the contracted neighbours and the level to spread the contraction evenly. A
+	// hub can need more shortcuts than an int32_t holds.
+	int64_t difference = static_cast<int64_t>(FindShortcuts(vertex, witness, nullptr)) - static_cast<int64_t>(_in[vertex].size() + _out[vertex].size());
+
+	return static_cast<int32_t>(std::min<int64_t>(2 * difference + _contractedNeighbours[vertex] + _levels[vertex], INT32_MAX));
+}
+
+void ContractionHierarchy::Contraction::Merge(Matrix<Arc>* lists, Vector<Pair<uint32_t, Arc>>* arcs)
+{
+	auto compare = [](Pair<uint32_t, Arc> const& first, Pair<uint32_t, Arc> const& second)
+		{ return first.first < second.first || (first.first == second.first && first.second.target < second.second.target); };
+	uint64_t kept = 0;
+
+	std::sort(arcs->begin(), arcs->end(), compare);
+
+	// Each owner's list is indexed once through _positions instead of scanned for every arc.
+	for (uint64_t i = 0; i < arcs->size();)
+	{
+		uint32_t owner = (*arcs)[i].first;
+		Vector<Arc>& list = (*lists)[owner];
+
+		for (uint32_t j = 0; j < list.size(); ++j)
+			_positions[list[j].target] = j;
+
+		for (; i < arcs->size() && (*arcs)[i].first == owner; ++i)
+		{
+			Arc const& arc = (*arcs)[i].second;
+			uint32_t position = _positions[arc.target];
+
+			if (position == None)
+			{
+				_positions[arc.target] = static_cast<uint32_t>(list.size());
+				list.push_back(arc);
+			}
+			else if (arc.weight < list[position].weight)
+				list[position] = arc;
+			else
+				continue;
+
+			(*arcs)[kept++] = (*arcs)[i];
+		}
+
+		for (uint32_t j = 0; j < list.size(); ++j)
+			_positions[list[j].target] = None;
+	}
+
+	arcs->resize(kept);
+}
+
+void ContractionHierarchy::Contraction::RemoveContracted(Vector<Arc>* arcs) const
+{
+	arcs->erase(std::remove_if(arcs->begin(), arcs->end(), [this](Arc const& arc) { return _contracting[arc.target] != 0; }),
+		arcs->end());
+}
+
+ContractionHierarchy::ContractionHierarchy(Graph const& graph, uint32_t const& threads) : _vertices(graph.GetVertices())
+{
+	GRAPH_STATS_COLLECTOR();
+
+	Matrix<Arc> upward[2];
+
+	{
+		GRAPH_STATS_PHASE("ch_contraction");
+
+		Contraction contraction(graph, threads);
+
+		contraction.Run(&_ranks, upward);
+	}
+
+	GRAPH_STATS_PHASE("ch_upward_graph");
+
+	for (uint32_t side = 0; side < 2; ++side)
+	{
+		_offsets[side].assign(_vertices + 1, 0);
+
+		for (uint32_t i = 0; i < _vertices; ++i)
+			_offsets[side][i + 1] = _offsets[side][i] + upward[side][i].size();
+
+		_arcs[side].reserve(_offsets[side].back());
+
+		for (uint32_t i = 0; i < _vertices; ++i)
+		{
+			_arcs[side].insert(_arcs[side].end(), upward[side][i].begin(), upward[side][i].end());
+			Vector<Arc>().swap(upward[side][i]);
+		}
+	}
+}
+
+int64_t ContractionHierarchy::Query(uint32_t const& source, uint32_t const& target, Vector<uint32_t>* path) const
+{
+	Workspace workspace;
+
+	return Query(source, target, &workspace, path);
+}
+
+int64_t ContractionHierarchy::Query(uint32_t const& source, uint32_t const& target, Workspace* workspace,
+	Vector<uint32_t>* path) const
+{
+	if (path)
+		path->clear();
+
+	if (source >= _vertices || target >= _vertices)
+		return -1;
+
+	Search* searches = workspace->_searches;
+	int64_t shortest = INT64_MAX;
+	uint32_t meeting = None;
+
+	Start(&searches[0], source);
+	Start(&searches[1], target);
+
+	// Each side stops on its own once its smallest key reaches the best meeting found so far.
+	while (true)
+	{
+		int64_t forwardKey = GetTopKey(&searches[0]);
+		int64_t backwardKey = GetTopKey(&searches[1]);
+
+		if (std::min(forwardKey, backwardKey) >= shortest)
+			break;
+
+		uint32_t side = (forwardKey <= backwardKey) ? 0 : 1;
+		uint32_t vertex = SettleNext(side, &searches[side]);
+		Search const& other = searches[1 - side];
+
+		if (IsReached(other, vertex) && searches[side].distance[vertex] + other.distance[vertex] < shortest)
+		{
+			shortest = searches[side].distance[vertex] + other.distance[vertex];
+			meeting = vertex;
+		}
+	}
+
+	if (shortest == INT64_MAX)
+		return -1;
+
+	if (path)
+	{
+		Vector<uint32_t> upwardPath;
+
+		for (uint32_t vertex = meeting; vertex != None; vertex = searches[0].parent[vertex])
+			upwardPath.push_back(vertex);
+
+		std::reverse(upwardPath.begin(), upwardPath.end());
+
+		for (uint32_t vertex = searches[1].parent[meeting]; vertex != None; vertex = searches[1].parent[vertex])
+			upwardPath.push_back(vertex);
+
+		path->push_back(upwardPath[0]);
+
+		for (uint32_t i = 1; i < upwardPath.size(); ++i)
+			Unpack(upwardPath[i - 1], upwardPath[i], path);
+	}
+
+	return shortest;
+}
+
+Vector<int64_t> ContractionHierarchy::GetDistanceTable(Vector<uint32_t> const& sources, Vector<uint32_t> const& targets,
+	uint32_t const& threads) const
+{
+	GRAPH_STATS_COLLECTOR();
+
+	uint32_t threadCount = Parallel::GetThreads(threads);
+	Vector<int64_t> table(sources.size() * targets.size(), INT64_MAX);
+	Vector<Search> searches(threadCount);
+	Matrix<Pair<uint32_t, Pair<uint32_t, int64_t>>> entries(threadCount);
+	Vector<uint64_t> bucketOffsets(_vertices + 1, 0);
+	Vector<Pair<uint32_t, int64_t>> buckets;
+
+	{
+		GRAPH_STATS_PHASE("ch_table_buckets");
+
+		// (vertex, (target index, distance to the target)) for everything the backward searches settle.
+		Parallel::ForDynamic(0, targets.size(), 16, threadCount, [&](uint64_t const& first, uint64_t const& last, uint32_t const& thread)
+		{
+			for (uint64_t i = first; i < last; ++i)
+			{
+				if (targets[i] >= _vertices)
+					continue;
+
+				Start(&searches[thread], targets[i]);
+
+				while (GetTopKey(&searches[thread]) != INT64_MAX)
+				{
+					uint32_t vertex = SettleNext(1, &searches[thread]);
+
+					entries[thread].push_back(std::make_pair(vertex, std::make_pair(static_cast<uint32_t>(i), searches[thread].distance[vertex])));
+				}
+			}
+		});
+
+		for (uint32_t i = 0; i < threadCount; ++i)
+			for (uint64_t j = 0; j < entries[i].size(); ++j)
+				++bucketOffsets[entries[i][j].first + 1];
+
+		for (uint32_t i = 0; i < _vertices; ++i)
+			bucketOffsets[i + 1] += bucketOffsets[i];
+
+		Vector<uint64_t> position(bucketOffsets.begin(), bucketOffsets.end() - 1);
+
+		buckets.resize(bucketOffsets.back());
+
+		for (uint32_t i = 0; i < threadCount; ++i)
+		{
+			for (uint64_t j = 0; j < entries[i].size(); ++j)
+				buckets[position[entries[i][j].first]++] = entries[i][j].second;
+
+			Vector<Pair<uint32_t, Pair<uint32_t, int64_t>>>().swap(entries[i]);
+		}
+	}
+
+	GRAPH_STATS_PHASE("ch_table_sources");
+
+	Parallel::ForDynamic(0, sources.size(), 16, threadCount, [&](uint64_t const& first, uint64_t const& last, uint32_t const& thread)
+	{
+		for (uint64_t i = first; i < last; ++i)
+		{
+			if (sources[i] >= _vertices)
+				continue;
+
+			int64_t* row = &table[i * targets.size()];
+
+			Start(&searches[thread], sources[i]);
+
+			while (GetTopKey(&searches[thread]) != INT64_MAX)
+			{
+				uint32_t vertex = SettleNext(0, &searches[thread]);
+				int64_t distance = searches[thread].distance[vertex];
+
+				for (uint64_t j = bucketOffsets[vertex]; j < bucketOffsets[vertex + 1]; ++j)
+					row[buckets[j].first] = std::min(row[buckets[j].first], distance + buckets[j].second);
+			}
+		}
+	});
+
+	for (uint64_t i = 0; i < table.size(); ++i)
+		if (table[i] == INT64_MAX)
+			table[i] = -1;
+
+	return table;
+}
+
+void ContractionHierarchy::Save(std::ofstream& ofs) const
+{
+	uint32_t const version = 1;
+	uint64_t arcs[2] = { _arcs[0].size(), _arcs[1].size() };
+
+	ofs.write("GACH", 4);
+	ofs.write(reinterpret_cast<char const*>(&version), sizeof(version));
+	ofs.write(reinterpret_cast<char const*>(&_vertices), sizeof(_vertices));
+	ofs.write(reinterpret_cast<char const*>(arcs), sizeof(arcs));
+	ofs.write(reinterpret_cast<char const*>(_ranks.data()), static_cast<std::streamsize>(_ranks.size() * sizeof(uint32_t)));
+
+	for (uint32_t side = 0; side < 2; ++side)
+	{
+		ofs.write(reinterpret_cast<char const*>(_offsets[side].data()), static_cast<std::streamsize>(_offsets[side].size() * sizeof(uint64_t)));
+		ofs.write(reinterpret_cast<char const*>(_arcs[side].data()), static_cast<std::streamsize>(_arcs[side].size() * sizeof(Arc)));
+	}
+}
+
+bool ContractionHierarchy::Load(std::ifstream& ifs)
+{
+	char magic[4];
+	uint32_t version = 0;
+	uint32_t vertices = 0;
+	uint64_t arcs[2] = { 0, 0 };
+
+	ifs.read(magic, 4);
+	ifs.read(reinterpret_cast<char*>(&version), sizeof(version));
+	ifs.read(reinterpret_cast<char*>(&vertices), sizeof(vertices));
+	ifs.read(reinterpret_cast<char*>(arcs), sizeof(arcs));
+
+	if (!ifs || std::string(magic, 4) != "GACH" || version != 1)
+		return false;
+
+	ContractionHierarchy hierarchy;
+	uint64_t offsets = static_cast<uint64_t>(vertices) + 1;
+
+	hierarchy._vertices = vertices;
+	hierarchy._ranks.resize(vertices);
+	ifs.read(reinterpret_cast<char*>(hierarchy._ranks.data()), static_cast<std::streamsize>(vertices * sizeof(uint32_t)));
+
+	for (uint32_t side = 0; side < 2 && ifs; ++side)
+	{
+		hierarchy._offsets[side].resize(offsets);
+		ifs.read(reinterpret_cast<char*>(hierarchy._offsets[side].data()), static_cast<std::streamsize>(offsets * sizeof(uint64_t)));
+
+		if (!ifs || hierarchy._offsets[side][0] != 0 || hierarchy._offsets[side].back() != arcs[side])
+			return false;
+
+		for (uint32_t i = 0; i < vertices; ++i)
+			if (hierarchy._offsets[side][i] > hierarchy._offsets[side][i + 1])
+				return false;
+
+		hierarchy._arcs[side].resize(arcs[side]);
+		ifs.read(reinterpret_cast<char*>(hierarchy._arcs[side].data()), static_cast<std::streamsize>(arcs[side] * sizeof(Arc)));
+	}
+
+	if (!ifs || !hierarchy.IsValid())
+		return false;
+
+	_vertices = hierarchy._vertices;
+	_ranks.swap(hierarchy._ranks);
+
+	for (uint32_t side = 0; side < 2; ++side)
+	{
+		_offsets[side].swap(hierarchy._offsets[side]);
+		_arcs[side].swap(hierarchy._arcs[side]);
+	}
+
+	return true;
+}
+
+bool ContractionHierarchy::IsValid() const
+{
+	Vector<char> seen(_vertices, 0);
+
+	for (uint32_t i = 0; i < _vertices; ++i)
+	{
+		if (_ranks[i] >= _vertices || seen[_ranks[i]])
+			return false;
+
+		seen[_ranks[i]] = 1;
+	}
+
+	// Arcs lead upward and a shortcut skips a vertex below both ends, so the searches and Unpack terminate.
+	for (uint32_t side = 0; side < 2; ++side)
+		for (uint32_t i = 0; i < _vertices; ++i)
+			for (uint64_t arc = _offsets[side][i]; arc < _offsets[side][i + 1]; ++arc)
+			{
+				Arc const& current = _arcs[side][arc];
+
+				if (current.target >= _vertices || _ranks[current.target] <= _ranks[i])
+					return false;
+
+				if (current.middle != None && (current.middle >= _vertices || _ranks[current.middle] >= _ranks[i]))
+					return false;
+			}
+
+	return true;
+}
+
+void ContractionHierarchy::Start(Search* search, uint32_t const& vertex) const
+{
+	if (search->distance.size() != _vertices)
+	{
+		search->distance.resize(_vertices);
+		search->parent.resize(_vertices);
+		search->reached.assign(_vertices, 0);
+		search->epoch = 0;
+	}
+
+	if (++search->epoch == 0)
+	{
+		std::fill(search->reached.begin(), search->reached.end(), 0);
+		search->epoch = 1;
+	}
+
+	search->heap.clear();
+	search->distance[vertex] = 0;
+	search->parent[vertex] = None;
+	search->reached[vertex] = search->epoch;
+	search->heap.push_back(std::make_pair(0, vertex));
+}
+
+int64_t ContractionHierarchy::GetTopKey(Search* search) const
+{
+	std::greater<Pair<int64_t, uint32_t>> compare;
+
+	while (!search->heap.empty() && search->heap.front().first > search->distance[search->heap.front().second])
+	{
+		std::pop_heap(search->heap.begin(), search->heap.end(), compare);
+		search->heap.pop_back();
+	}
+
+	return search->heap.empty() ? INT64_MAX : search->heap.front().first;
+}
+
+uint32_t ContractionHierarchy::SettleNext(uint32_t const& side, Search* search) const
+{
+	std::greater<Pair<int64_t, uint32_t>> compare;
+
+	std::pop_heap(search->heap.begin(), search->heap.end(), compare);
+
+	int64_t length = search->heap.back().first;
+	uint32_t vertex = search->heap.back().second;
+
+	search->heap.pop_back();
+
+	for (uint64_t arc = _offsets[side][vertex]; arc < _offsets[side][vertex + 1]; ++arc)
+	{
+		uint32_t neighbour = _arcs[side][arc].target;
+		int64_t candidate = length + _arcs[side][arc].weight;
+
+		if (search->reached[neighbour] != search->epoch || candidate < search->distance[neighbour])
+		{
+			search->distance[neighbour] = candidate;
+			search->parent[neighbour] = vertex;
+			search->reached[neighbour] = search->epoch;
+			search->heap.push_back(std::make_pair(candidate, neighbour));
+			std::push_heap(search->heap.begin(), search->heap.end(), compare);
+		}
+	}
+
+	return vertex;
+}
+
+uint32_t ContractionHierarchy::GetMiddle(uint32_t const& from, uint32_t const& to) const
+{
+	// The arc is stored at its lower ranked end.
+	uint32_t side = (_ranks[from] < _ranks[to]) ? 0 : 1;
+	uint32_t owner = (side == 0) ? from : to;
+	uint32_t other = (side == 0) ? to : from;
+
+	for (uint64_t arc = _offsets[side][owner]; arc < _offsets[side][owner + 1]; ++arc)
+		if (_arcs[side][arc].target == other)
+			return _arcs[side][arc].middle;
+
+	return None;
+}
+
+void ContractionHierarchy::Unpack(uint32_t const& from, uint32_t const& to, Vector<uint32_t>* path) const
+{
+	Vector<Pair<uint32_t, uint32_t>> stack(1, std::make_pair(from, to));
+
+	// Appends the vertices after from, the shortcut halves are expanded depth first in path order.
+	while (!stack.empty())
+	{
+		Pair<uint32_t, uint32_t> arc = stack.back();
+		uint32_t middle = GetMiddle(arc.first, arc.second);
+
+		stack.pop_back();
+
+		if (middle == None)
+		{
+			path->push_back(arc.second);
+			continue;
+		}
+
+		stack.push_back(std::make_pair(middle, arc.second));
+		stack.push_back(std::make_pair(arc.first, middle));
+	}
+}
+
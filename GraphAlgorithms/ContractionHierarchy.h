@@ -0,0 +1,95 @@
+#ifndef _CONTRACTION_HIERARCHY_H
+#define _CONTRACTION_HIERARCHY_H
+
+#include "PCH.h"
+#include "Graph.h"
+
+// Contraction hierarchy of a directed or undirected graph with non-negative weights, an unweighted graph counts hops.
+// The vertices are contracted in order of edge difference from a lazily updated queue, an independent set of the lowest
+// per round in parallel, and every query is a pair of upward searches over the shortcuts. Path lengths must fit an
+// int32_t.
+//
+// Binary file: "GACH" magic, uint32 version, uint32 vertices, uint64 upward and downward arc counts, the uint32 ranks,
+// then per direction the uint64 offsets and the arcs as uint32 target, int32 weight, uint32 middle, in host byte order.
+class ContractionHierarchy
+{
+	public:
+		class Workspace;
+
+		ContractionHierarchy() : _vertices(0) { }
+		explicit ContractionHierarchy(Graph const& graph, uint32_t const& threads = 0);
+
+		uint32_t GetVertices() const { return _vertices; }
+		uint64_t GetArcs() const { return _arcs[0].size() + _arcs[1].size(); }
+		uint32_t GetRank(uint32_t const& vertex) const { return _ranks[vertex]; }
+
+		// Length of the shortest path, -1 when the target is unreachable or a vertex is invalid. The path gets the
+		// original vertices from source to target with the shortcuts unpacked, it is left empty when there is none.
+		// Concurrent queries take a workspace each, the overload without one allocates its own.
+		int64_t Query(uint32_t const& source, uint32_t const& target, Vector<uint32_t>* path = nullptr) const;
+		int64_t Query(uint32_t const& source, uint32_t const& target, Workspace* workspace,
+			Vector<uint32_t>* path = nullptr) const;
+
+		// Row-major sources x targets lengths, -1 where unreachable. The backward searches of the targets are stored
+		// in buckets on the vertices they reach, then every source only runs its forward search.
+		Vector<int64_t> GetDistanceTable(Vector<uint32_t> const& sources, Vector<uint32_t> const& targets,
+			uint32_t const& threads = 0) const;
+
+		void Save(std::ofstream& ofs) const;
+		bool Load(std::ifstream& ifs);	// False when the file is not a valid hierarchy or is truncated.
+
+	private:
+		class Contraction;
+
+		static uint32_t const None = UINT32_MAX;
+
+		struct Arc
+		{
+			uint32_t target;
+			int32_t weight;
+			uint32_t middle;			// Contracted vertex the shortcut skips, None for an original edge.
+		};
+
+		struct Search
+		{
+			Search() : epoch(0) { }
+
+			uint32_t epoch;
+			Vector<int64_t> distance;
+			Vector<uint32_t> parent;
+			Vector<uint32_t> reached;	// Epoch in which distance and parent were last set.
+			Vector<Pair<int64_t, uint32_t>> heap;
+		};
+
+		bool IsValid() const;	// Ranks are a permutation and the arcs fit them, checked on Load.
+
+		void Start(Search* search, uint32_t const& vertex) const;
+		int64_t GetTopKey(Search* search) const;	// INT64_MAX once the search is exhausted.
+		uint32_t SettleNext(uint32_t const& side, Search* search) const;
+		bool IsReached(Search const& search, uint32_t const& vertex) const { return search.reached[vertex] == search.epoch; }
+
+		uint32_t GetMiddle(uint32_t const& from, uint32_t const& to) const;
+		void Unpack(uint32_t const& from, uint32_t const& to, Vector<uint32_t>* path) const;
+
+		uint32_t _vertices;
+		Vector<uint32_t> _ranks;
+
+		// [0] holds the arcs from each vertex to higher ranked ones, [1] the arcs from higher ranked vertices into it.
+		Vector<uint64_t> _offsets[2];
+		Vector<Arc> _arcs[2];
+};
+
+// Search state of one query at a time, reused across queries so they only touch what they reach.
+class ContractionHierarchy::Workspace
+{
+	public:
+		Workspace() { }
+
+	private:
+		friend class ContractionHierarchy;
+
+		Search _searches[2];
+};
+
+#endif
+
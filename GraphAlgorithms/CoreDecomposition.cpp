@@ -0,0 +1,223 @@
+#include "PCH.h"
+#include "CoreDecomposition.h"
+#include "Instrumentation.h"
+#include "Parallel.h"
+
+uint32_t const CoreDecomposition::None;
+uint32_t const CoreDecomposition::SerialVertices;
+
+CoreDecomposition::CoreDecomposition(UndirectedGraph const& graph, uint32_t const& threads) : _degeneracy(0)
+{
+	Compute(CompressedGraph(graph), threads);
+}
+
+CoreDecomposition::CoreDecomposition(DirectedGraph const& graph, Kind const& kind, uint32_t const& threads) : _degeneracy(0)
+{
+	// Removing a vertex takes an in arc from each of its out-neighbours, or an out arc from each of its in-neighbours.
+	if (kind == InCore)
+		Compute(CompressedGraph(graph), threads);
+	else
+		Compute(CompressedGraph(graph).GetTranspose(), threads);
+}
+
+Vector<uint32_t> CoreDecomposition::GetCoreVertices(uint32_t const& k) const
+{
+	Vector<uint32_t> vertices;
+
+	for (uint32_t i = 0; i < _cores.size(); ++i)
+		if (_cores[i] >= k)
+			vertices.push_back(i);
+
+	return vertices;
+}
+
+void CoreDecomposition::Compute(CompressedGraph const& peeled, uint32_t const& threads)
+{
+	GRAPH_STATS_COLLECTOR();
+	GRAPH_STATS_ADD(VerticesVisited, peeled.GetVertices());
+	GRAPH_STATS_ADD(EdgesScanned, peeled.GetArcs());
+
+	Vector<uint32_t> degrees(peeled.GetVertices(), 0);
+
+	for (uint32_t i = 0; i < peeled.GetVertices(); ++i)
+		for (uint64_t arc = peeled.GetBegin(i); arc < peeled.GetEnd(i); ++arc)
+			if (peeled.GetTarget(arc) != i)
+				++degrees[peeled.GetTarget(arc)];
+
+	if (Parallel::GetThreads(threads) == 1)
+		PeelBuckets(peeled, &degrees);
+	else
+		PeelLevels(peeled, degrees, threads);
+
+	for (uint32_t i = 0; i < _cores.size(); ++i)
+		_degeneracy = std::max(_degeneracy, _cores[i]);
+}
+
+void CoreDecomposition::PeelBuckets(CompressedGraph const& peeled, Vector<uint32_t>* degrees)
+{
+	uint32_t vertices = peeled.GetVertices();
+	uint32_t maximum = 0;
+
+	for (uint32_t i = 0; i < vertices; ++i)
+		maximum = std::max(maximum, (*degrees)[i]);
+
+	// _order is sorted by current degree, bins[d] is where the vertices of degree d start and positions the inverse.
+	Vector<uint32_t> bins(maximum + 1, 0);
+	Vector<uint32_t> positions(vertices);
+
+	_order.resize(vertices);
+
+	for (uint32_t i = 0; i < vertices; ++i)
+		++bins[(*degrees)[i]];
+
+	for (uint32_t i = 0, start = 0; i <= maximum; ++i)
+	{
+		uint32_t count = bins[i];
+
+		bins[i] = start;
+		start += count;
+	}
+
+	for (uint32_t i = 0; i < vertices; ++i)
+	{
+		positions[i] = bins[(*degrees)[i]]++;
+		_order[positions[i]] = i;
+	}
+
+	for (uint32_t i = maximum; i > 0; --i)
+		bins[i] = bins[i - 1];
+
+	bins[0] = 0;
+
+	// A decremented neighbour swaps with the first vertex of its bin, which then starts one later.
+	for (uint32_t i = 0; i < vertices; ++i)
+	{
+		uint32_t vertex = _order[i];
+
+		for (uint64_t arc = peeled.GetBegin(vertex); arc < peeled.GetEnd(vertex); ++arc)
+		{
+			uint32_t neighbour = peeled.GetTarget(arc);
+			uint32_t degree = (*degrees)[neighbour];
+
+			if (degree <= (*degrees)[vertex])
+				continue;
+
+			uint32_t first = _order[bins[degree]];
+
+			if (first != neighbour)
+			{
+				std::swap(_order[positions[neighbour]], _order[bins[degree]]);
+				std::swap(positions[neighbour], positions[first]);
+			}
+
+			++bins[degree];
+			--(*degrees)[neighbour];
+		}
+	}
+
+	_cores.swap(*degrees);
+}
+
+void CoreDecomposition::PeelLevels(CompressedGraph const& peeled, Vector<uint32_t> const& degrees, uint32_t const& threads)
+{
+	uint32_t vertices = peeled.GetVertices();
+	uint32_t count = Parallel::GetThreads(threads);
+	uint32_t level = 0;
+	Vector<std::atomic<uint32_t>> remaining(vertices);
+	Vector<uint32_t> survivors(vertices);
+	Vector<uint32_t> frontier;
+	Vector<Vector<uint32_t>> buffers(count);
+	Vector<uint32_t> minima(count);
+
+	_cores.assign(vertices, None);
+	_order.reserve(vertices);
+
+	for (uint32_t i = 0; i < vertices; ++i)
+	{
+		remaining[i] = degrees[i];
+		survivors[i] = i;
+	}
+
+	// A pass over fewer than SerialVertices vertices, as most sub-rounds are, is not worth starting threads for.
+	auto threadsFor = [&](uint64_t const& size) { return (size < SerialVertices) ? 1 : count; };
+
+	// Moves the per thread buffers, in thread order, into target. Parallel::For runs fewer threads than count on a
+	// short range, so every buffer is left empty for the next pass.
+	auto gather = [&](Vector<uint32_t>* target)
+	{
+		target->clear();
+
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			target->insert(target->end(), buffers[i].begin(), buffers[i].end());
+			buffers[i].clear();
+		}
+	};
+
+	while (true)
+	{
+		// Drops the vertices peeled at the previous level and finds the smallest degree left, the next level.
+		std::fill(minima.begin(), minima.end(), UINT32_MAX);
+
+		Parallel::For(0, survivors.size(), threadsFor(survivors.size()),
+			[&](uint64_t const& first, uint64_t const& last, uint32_t const& thread)
+		{
+			for (uint64_t i = first; i < last; ++i)
+				if (_cores[survivors[i]] == None)
+				{
+					buffers[thread].push_back(survivors[i]);
+					minima[thread] = std::min<uint32_t>(minima[thread], remaining[survivors[i]]);
+				}
+		});
+
+		gather(&survivors);
+
+		if (survivors.empty())
+			break;
+
+		level = std::max(level, *std::min_element(minima.begin(), minima.end()));
+
+		Parallel::For(0, survivors.size(), threadsFor(survivors.size()),
+			[&](uint64_t const& first, uint64_t const& last, uint32_t const& thread)
+		{
+			for (uint64_t i = first; i < last; ++i)
+				if (remaining[survivors[i]] <= level)
+					buffers[thread].push_back(survivors[i]);
+		});
+
+		gather(&frontier);
+
+		// Sub-rounds: a neighbour that the peeled vertices bring down to the level is peeled in the next one. Only the
+		// decrement that lands on the level queues it, one that would go below is undone.
+		while (!frontier.empty())
+		{
+			for (uint32_t i = 0; i < frontier.size(); ++i)
+			{
+				_cores[frontier[i]] = level;
+				_order.push_back(frontier[i]);
+			}
+
+			Parallel::For(0, frontier.size(), threadsFor(frontier.size()),
+				[&](uint64_t const& first, uint64_t const& last, uint32_t const& thread)
+			{
+				for (uint64_t i = first; i < last; ++i)
+					for (uint64_t arc = peeled.GetBegin(frontier[i]); arc < peeled.GetEnd(frontier[i]); ++arc)
+					{
+						uint32_t neighbour = peeled.GetTarget(arc);
+
+						if (_cores[neighbour] != None || remaining[neighbour] <= level)
+							continue;
+
+						uint32_t degree = remaining[neighbour]--;
+
+						if (degree == level + 1)
+							buffers[thread].push_back(neighbour);
+						else if (degree <= level)
+							++remaining[neighbour];
+					}
+			});
+
+			gather(&frontier);
+		}
+	}
+}
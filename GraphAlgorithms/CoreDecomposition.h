@@ -0,0 +1,54 @@
+#ifndef _CORE_DECOMPOSITION_H
+#define _CORE_DECOMPOSITION_H
+
+#include "PCH.h"
+#include "UndirectedGraph.h"
+#include "DirectedGraph.h"
+#include "CompressedGraph.h"
+
+// Core numbers: the k-core is the largest subgraph in which every vertex keeps at least k neighbours, and a vertex's
+// core number is the largest k whose core holds it. One thread peels by Batagelj and Zaversnik's bucket sort in
+// O(V + E), always removing a vertex of the smallest remaining degree. More threads peel level by level: every vertex
+// at or below the current level leaves at once, its neighbours are decremented atomically, and those that drop to
+// the level join the next sub-round, which keeps the work O(V + E) apart from one scan of the survivors per level.
+// Either way the removal order is a degeneracy order: every vertex has at most its core number of neighbours after
+// it. Parallel edges count each, self loops are ignored.
+class CoreDecomposition
+{
+	public:
+		// A directed graph is peeled by the arcs into every vertex, or by the arcs out of it.
+		enum Kind { InCore, OutCore };
+
+		// threads = 1 uses the bucket sort, otherwise the level peeling splits among them, 0 uses every hardware thread.
+		explicit CoreDecomposition(UndirectedGraph const& graph, uint32_t const& threads = 1);
+		CoreDecomposition(DirectedGraph const& graph, Kind const& kind, uint32_t const& threads = 1);
+
+		uint32_t GetCore(uint32_t const& vertex) const { return _cores[vertex]; }
+		Vector<uint32_t> const& GetCores() const { return _cores; }
+
+		// The largest core number, 0 without vertices.
+		uint32_t GetDegeneracy() const { return _degeneracy; }
+
+		// The vertices in removal order. Within a level the parallel mode's order depends on the thread timing, the
+		// core numbers never do.
+		Vector<uint32_t> const& GetOrder() const { return _order; }
+
+		// The vertices of the k-core in ascending order.
+		Vector<uint32_t> GetCoreVertices(uint32_t const& k) const;
+
+	private:
+		static uint32_t const None = UINT32_MAX;
+		static uint32_t const SerialVertices = 4096;	// Shorter scans and sub-rounds run on the calling thread.
+
+		// peeled lists, for every vertex, the vertices whose degree drops when it is removed; the degree of a vertex is
+		// the number of times it is listed.
+		void Compute(CompressedGraph const& peeled, uint32_t const& threads);
+		void PeelBuckets(CompressedGraph const& peeled, Vector<uint32_t>* degrees);
+		void PeelLevels(CompressedGraph const& peeled, Vector<uint32_t> const& degrees, uint32_t const& threads);
+
+		Vector<uint32_t> _cores;
+		Vector<uint32_t> _order;
+		uint32_t _degeneracy;
+};
+
+#endif
@@ -1,307 +1,374 @@
-#include "PCH.h"
-#include "DirectedGraph.h"
-
-DirectedGraph::DirectedGraph(std::ifstream& ifs, bool weighted)
-{
-	uint32_t vertices;
-	_weighted = weighted;
-	ifs >> vertices >> _edges;
-	_adjacencyList.resize(vertices);
-
-	if (!IsWeighted())
-		for (uint32_t i = 0; i < GetEdges(); ++i)
-		{
-			uint32_t x, y;
-
-			ifs >> x >> y;
-			_adjacencyList[x].push_back(std::make_pair(y, 0));
-		}
-	else
-		for (uint32_t i = 0; i < GetEdges(); ++i)
-		{
-			uint32_t x, y, w;
-
-			ifs >> x >> y >> w;
-			_adjacencyList[x].push_back(std::make_pair(y, w));
-		}
-}
-
-bool DirectedGraph::IsComplete() const
-{
-	for (uint32_t i = 0; i < GetVertices(); ++i)
-	{
-		if (GetOutDegree(i) < (GetVertices() - 1))
-			return false;
-
-		Vector<bool> visited(GetVertices(), false);
-		visited[i] = true;
-
-		for (uint32_t j = 0; j < GetOutDegree(i); ++j)
-			visited[_adjacencyList[i][j].first] = true;
-
-		for (uint32_t j = 0; j < visited.size(); ++j)
-			if (!visited[j])
-				return false;
-	}
-
-	return true;
-}
-
-bool DirectedGraph::IsRegular() const
-{
-	for (uint32_t i = 1; i < GetVertices(); ++i)
-		if ((GetInDegree(i) != GetInDegree(i - 1)) || (GetOutDegree(i) != GetOutDegree(i - 1)))
-			return false;
-
-	return true;
-}
-
-bool DirectedGraph::IsStronglyConnected() const
-{
-	for (uint32_t i = 0; i < GetVertices(); ++i)
-	{
-		Vector<int> roadDistance = GetRoadDistance(i);
-
-		for (uint32_t j = 0; j < roadDistance.size(); ++j)
-			if (roadDistance[j] == -1)
-				return false;
-	}
-
-	return true;
-}
-
-Stack<uint32_t> DirectedGraph::GetTopologicalSort() const
-{
-	Stack<uint32_t> topSort;
-	Vector<bool> visited(GetVertices(), false);
-
-	for (uint32_t i = 0; i < GetVertices(); ++i)
-		if (!visited[i])
-			TopologicalSort(i, &visited, &topSort);
-
-	return topSort;
-}
-
-Matrix<uint32_t> DirectedGraph::GetStronglyConnectedComponents() const
-{
-	Stack<uint32_t> stack;
-	Vector<uint32_t> low(GetVertices(), 0);						// Represents the lowest depth of a vertex connected to the index vertex through a back-edge in DFS-tree.
-	Vector<uint32_t> depth(GetVertices(), 0);					// Represents the depth of the vertex in DFS-tree.
-	Vector<bool> isInStack(GetVertices(), false);
-	Matrix<uint32_t> stronglyConnectedComponents;
-
-	for (uint32_t i = 0; i < GetVertices(); ++i)
-		if (!depth[i])
-			GetStronglyConnectedComponents(i, &depth, &low, &isInStack, &stack, &stronglyConnectedComponents);
-
-	return stronglyConnectedComponents;
-}
-
-Matrix<bool> DirectedGraph::GetRoadMatrix() const
-{
-	Matrix<bool> roadMatrix(GetVertices());
-
-	for (uint32_t i = 0; i < GetVertices(); ++i)
-	{
-		Vector<int> roadDistance = GetRoadDistance(i);
-
-		for (uint32_t j = 0; j < roadDistance.size(); ++j)
-			if (roadDistance[j] != -1)
-				roadMatrix[i][j] = true;
-	}
-
-	return roadMatrix;
-}
-
-DirectedGraph& DirectedGraph::operator=(DirectedGraph const& source)
-{
-	if (this == &source)
-		return *this;
-
-	_weighted = source._weighted;
-	_edges = source._edges;
-	_adjacencyList = source._adjacencyList;
-
-	return *this;
-}
-
-DirectedGraph DirectedGraph::operator+(DirectedGraph const& source) const
-{
-	if (this->GetVertices() != source.GetVertices() || this->GetVertices() == 0)
-		return DirectedGraph();
-
-	DirectedGraph sumGraph;
-	sumGraph._adjacencyList.resize(this->GetVertices());
-
-	for (uint32_t i = 0; i < sumGraph.GetVertices(); ++i)
-	{
-		for (uint32_t j = 0; j < this->GetOutDegree(i); ++j)
-			sumGraph._adjacencyList[i].push_back(this->_adjacencyList[i][j]);
-
-		for (uint32_t j = 0; j < source.GetOutDegree(i); ++j)
-		{
-			bool found = false;
-
-			for (uint32_t k = 0; k < sumGraph.GetOutDegree(i); ++k)
-				if (sumGraph._adjacencyList[i][k] == source._adjacencyList[i][j])
-					found = true;
-
-			if (!found)
-				sumGraph._adjacencyList[i].push_back(source._adjacencyList[i][j]);
-		}
-	}
-
-	return sumGraph;
-}
-
-DirectedGraph DirectedGraph::operator-(DirectedGraph const& source) const
-{
-	// TODO: better way to handle this
-	if (this->GetVertices() != this->GetVertices() || source.GetVertices() == 0)
-		return DirectedGraph();
-
-	DirectedGraph difGraph;
-	difGraph._adjacencyList.resize(this->GetVertices());
-
-	for (uint32_t i = 0; i < this->GetVertices(); ++i)
-	{
-		for (uint32_t j = 0; j < this->GetOutDegree(i); ++j)
-		{
-			bool found = false;
-			for (uint32_t k = 0; k < this->GetOutDegree(i); ++k)
-				if (this->_adjacencyList[i][j] == source._adjacencyList[i][k])
-					found = true;
-
-			if (!found)
-				difGraph._adjacencyList[i].push_back(this->_adjacencyList[i][j]);
-		}
-	}
-
-	return difGraph;
-}
-
-bool DirectedGraph::operator==(DirectedGraph const& source) const
-{
-	if (this->GetVertices() != source.GetVertices() || this->GetEdges() != source.GetEdges())
-		return false;
-
-	if (((*this) + source).GetEdges() != this->GetEdges())
-		return false;
-
-	return true;
-}
-
-void DirectedGraph::TopologicalSort(uint32_t const& vertex, Vector<bool>* visited, Stack<uint32_t>* topSort) const
-{
-	(*visited)[vertex] = true;
-
-	for (uint32_t i = 0; i < GetOutDegree(vertex); ++i)
-		if (!(*visited)[_adjacencyList[vertex][i].first])
-			TopologicalSort(_adjacencyList[vertex][i].first, visited, topSort);
-
-	topSort->push(vertex);
-}
-
-void DirectedGraph::GetStronglyConnectedComponents(uint32_t const& vertex, Vector<uint32_t>* depth, Vector<uint32_t>* low,
-	Vector<bool>* isInStack, Stack<uint32_t>* stack, Matrix<uint32_t>* stronglyConnectedComponents) const
-{
-	if (!IsValidVertex(vertex))
-		return;
-
-	static uint32_t currentDepth = 0;
-	stack->push(vertex);
-	(*isInStack)[vertex] = true;
-	(*depth)[vertex] = (*low)[vertex] = ++currentDepth;
-
-	for (AdjacencyListConstIterator neighbour = _adjacencyList[vertex].begin(); neighbour != _adjacencyList[vertex].end(); ++neighbour)
-	{
-		if (!(*depth)[neighbour->first])
-		{
-			GetStronglyConnectedComponents(neighbour->first, depth, low, isInStack, stack, stronglyConnectedComponents);
-			(*low)[vertex] = std::min((*low)[vertex], (*low)[neighbour->first]);
-		}
-		else if ((*isInStack)[neighbour->first])
-			(*low)[vertex] = std::min((*low)[vertex], (*depth)[neighbour->first]);
-	}
-
-	if ((*low)[vertex] == (*depth)[vertex])
-	{
-		Matrix<uint32_t>::reverse_iterator itr;
-		stronglyConnectedComponents->push_back(Vector<uint32_t>());
-		itr = stronglyConnectedComponents->rbegin();
-
-		while (stack->top() != vertex)
-		{
-			itr->push_back(stack->top());
-			(*isInStack)[stack->top()] = false;
-			stack->pop();
-		}
-
-		itr->push_back(stack->top());
-		(*isInStack)[stack->top()] = false;
-		stack->pop();
-	}
-}
-
-std::istream& operator>>(std::istream& is, DirectedGraph& graph)
-{
-	uint16_t weighted;
-	uint32_t vertices;
-	is >> vertices >> graph._edges >> weighted;
-
-	graph._adjacencyList.~vector();
-	graph._adjacencyList.resize(vertices);
-
-	graph._weighted = weighted ? true : false;
-
-	if (!graph.IsWeighted())
-		for (uint32_t i = 0; i < graph.GetEdges(); ++i)
-		{
-			uint32_t x, y;
-
-			is >> x >> y;
-			graph._adjacencyList[x].push_back(std::make_pair(y, 0));
-		}
-	else
-		for (uint32_t i = 0; i < graph.GetEdges(); ++i)
-		{
-			uint32_t x, y, w;
-
-			is >> x >> y >> w;
-			graph._adjacencyList[x].push_back(std::make_pair(y, w));
-		}
-
-	return is;
-}
-
-std::ifstream& operator>>(std::ifstream& ifs, DirectedGraph& graph)
-{
-	uint16_t weighted;
-	uint32_t vertices;
-	ifs >> vertices >> graph._edges >> weighted;
-
-	graph._adjacencyList.~vector();
-	graph._adjacencyList.resize(vertices);
-
-	graph._weighted = weighted ? true : false;
-
-	if (!graph.IsWeighted())
-		for (uint32_t i = 0; i < graph.GetEdges(); ++i)
-		{
-			uint32_t x, y;
-
-			ifs >> x >> y;
-			graph._adjacencyList[x].push_back(std::make_pair(y, 0));
-		}
-	else
-		for (uint32_t i = 0; i < graph.GetEdges(); ++i)
-		{
-			uint32_t x, y, w;
-
-			ifs >> x >> y >> w;
-			graph._adjacencyList[x].push_back(std::make_pair(y, w));
-		}
-
-	return ifs;
-}
-
+#include "PCH.h"
+#include "DirectedGraph.h"
+#include "TopologicalOrder.h"
+#include "Instrumentation.h"
+#include "Traversal.h"
+
+DirectedGraph::DirectedGraph(std::ifstream& ifs, bool weighted)
+{
+	uint32_t vertices;
+	_weighted = weighted;
+	ifs >> vertices >> _edges;
+	_adjacencyList.resize(vertices);
+
+	if (!IsWeighted())
+		for (uint32_t i = 0; i < GetEdges(); ++i)
+		{
+			uint32_t x, y;
+
+			ifs >> x >> y;
+			_adjacencyList[x].push_back(std::make_pair(y, 0));
+		}
+	else
+		for (uint32_t i = 0; i < GetEdges(); ++i)
+		{
+			uint32_t x, y, w;
+
+			ifs >> x >> y >> w;
+			_adjacencyList[x].push_back(std::make_pair(y, w));
+		}
+}
+
+bool DirectedGraph::IsComplete() const
+{
+	for (uint32_t i = 0; i < GetVertices(); ++i)
+	{
+		if (GetOutDegree(i) < (GetVertices() - 1))
+			return false;
+
+		Vector<bool> visited(GetVertices(), false);
+		visited[i] = true;
+
+		for (uint32_t j = 0; j < GetOutDegree(i); ++j)
+			visited[_adjacencyList[i][j].first] = true;
+
+		for (uint32_t j = 0; j < visited.size(); ++j)
+			if (!visited[j])
+				return false;
+	}
+
+	return true;
+}
+
+bool DirectedGraph::IsRegular() const
+{
+	Vector<uint32_t> inDegrees = GetInDegrees();
+
+	for (uint32_t i = 1; i < GetVertices(); ++i)
+		if ((inDegrees[i] != inDegrees[i - 1]) || (_adjacencyList[i].size() != _adjacencyList[i - 1].size()))
+			return false;
+
+	return true;
+}
+
+bool DirectedGraph::IsEulerian() const
+{
+	Vector<int64_t> balances(GetVertices(), 0);
+	uint32_t start = GetVertices();
+	uint32_t withArcs = 0;
+
+	for (uint32_t i = 0; i < GetVertices(); ++i)
+	{
+		balances[i] += _adjacencyList[i].size();
+
+		for (AdjacencyListConstIterator itr = _adjacencyList[i].begin(); itr != _adjacencyList[i].end(); ++itr)
+			--balances[itr->first];
+	}
+
+	for (uint32_t i = 0; i < GetVertices(); ++i)
+	{
+		if (balances[i])
+			return false;
+
+		if (!_adjacencyList[i].empty() && !withArcs++)
+			start = i;
+	}
+
+	if (!withArcs)
+		return false;
+
+	// With every vertex balanced, reaching all the vertices that have arcs makes them strongly connected.
+	TraversalWorkspace workspace;
+
+	return BreadthFirstSearch(start, &workspace).size() == withArcs;
+}
+
+bool DirectedGraph::IsStronglyConnected() const
+{
+	ComponentLabels components;
+
+	GetStronglyConnectedComponents(&components);
+
+	return components.GetCount() <= 1;
+}
+
+Vector<uint32_t> DirectedGraph::GetTopologicalSort(uint32_t const& threads) const
+{
+	TopologicalOrder order(*this, threads);
+
+	return order.IsAcyclic() ? order.GetOrder() : Vector<uint32_t>();
+}
+
+Matrix<uint32_t> DirectedGraph::GetStronglyConnectedComponents() const
+{
+	GRAPH_STATS_COLLECTOR();
+	GRAPH_STATS_ADD(BytesAllocated, GetVertices() / 8 + GetVertices() * 2 * sizeof(uint32_t));
+
+	Stack<uint32_t> stack;
+	Vector<uint32_t> low(GetVertices(), 0);						// Represents the lowest depth of a vertex connected to the index vertex through a back-edge in DFS-tree.
+	Vector<uint32_t> depth(GetVertices(), 0);					// Represents the depth of the vertex in DFS-tree.
+	Vector<bool> isInStack(GetVertices(), false);
+	Matrix<uint32_t> stronglyConnectedComponents;
+	uint32_t time = 0;
+
+	for (uint32_t i = 0; i < GetVertices(); ++i)
+		if (!depth[i])
+			GetStronglyConnectedComponents(i, &depth, &low, &time, &isInStack, &stack, &stronglyConnectedComponents);
+
+	return stronglyConnectedComponents;
+}
+
+void DirectedGraph::GetStronglyConnectedComponents(ComponentLabels* components) const
+{
+	Traversal::GetStronglyConnectedComponents(Traversal::AllArcs(*this), components);
+}
+
+Matrix<bool> DirectedGraph::GetRoadMatrix() const
+{
+	return GetRoadMatrix(nullptr);
+}
+
+Matrix<bool> DirectedGraph::GetRoadMatrix(RunControl* control) const
+{
+	Matrix<bool> roadMatrix(GetVertices(), Vector<bool>(GetVertices(), false));
+	TraversalWorkspace workspace;
+
+	for (uint32_t i = 0; i < GetVertices(); ++i)
+	{
+		if (control && !control->Poll(i, GetVertices()))
+			return Matrix<bool>();
+
+		Vector<uint32_t> const& reached = BreadthFirstSearch(i, &workspace);
+
+		for (uint32_t j = 0; j < reached.size(); ++j)
+			roadMatrix[i][reached[j]] = true;
+	}
+
+	if (control)
+		control->Complete(GetVertices());
+
+	return roadMatrix;
+}
+
+DirectedGraph& DirectedGraph::operator=(DirectedGraph const& source)
+{
+	if (this == &source)
+		return *this;
+
+	_weighted = source._weighted;
+	_edges = source._edges;
+	_adjacencyList = source._adjacencyList;
+	_permutation = source._permutation;
+
+	return *this;
+}
+
+DirectedGraph& DirectedGraph::operator=(DirectedGraph&& source)
+{
+	if (this != &source)
+		MoveFrom(source);
+
+	return *this;
+}
+
+DirectedGraph DirectedGraph::operator+(DirectedGraph const& source) const
+{
+	if (this->GetVertices() != source.GetVertices() || this->GetVertices() == 0)
+		return DirectedGraph();
+
+	Matrix<Pair<uint32_t, int32_t>> buffer;
+	Matrix<Pair<uint32_t, int32_t>> const& arcs = GetAlignedArcs(source, &buffer);
+	DirectedGraph sumGraph;
+
+	sumGraph._adjacencyList.resize(this->GetVertices());
+	sumGraph._permutation = _permutation;
+
+	for (uint32_t i = 0; i < sumGraph.GetVertices(); ++i)
+	{
+		for (uint32_t j = 0; j < this->GetOutDegree(i); ++j)
+			sumGraph._adjacencyList[i].push_back(this->_adjacencyList[i][j]);
+
+		for (uint32_t j = 0; j < arcs[i].size(); ++j)
+		{
+			bool found = false;
+
+			for (uint32_t k = 0; k < sumGraph.GetOutDegree(i); ++k)
+				if (sumGraph._adjacencyList[i][k] == arcs[i][j])
+					found = true;
+
+			if (!found)
+				sumGraph._adjacencyList[i].push_back(arcs[i][j]);
+		}
+	}
+
+	uint64_t arcCount = 0;
+
+	for (uint32_t i = 0; i < sumGraph.GetVertices(); ++i)
+		arcCount += sumGraph._adjacencyList[i].size();
+
+	sumGraph._weighted = _weighted;
+	sumGraph._edges = static_cast<uint32_t>(arcCount);
+
+	return sumGraph;
+}
+
+DirectedGraph DirectedGraph::operator-(DirectedGraph const& source) const
+{
+	// TODO: better way to handle this
+	if (this->GetVertices() != source.GetVertices() || this->GetVertices() == 0)
+		return DirectedGraph();
+
+	Matrix<Pair<uint32_t, int32_t>> buffer;
+	Matrix<Pair<uint32_t, int32_t>> const& arcs = GetAlignedArcs(source, &buffer);
+	DirectedGraph difGraph;
+
+	difGraph._adjacencyList.resize(this->GetVertices());
+	difGraph._permutation = _permutation;
+
+	for (uint32_t i = 0; i < this->GetVertices(); ++i)
+	{
+		for (uint32_t j = 0; j < this->GetOutDegree(i); ++j)
+		{
+			bool found = false;
+			for (uint32_t k = 0; k < arcs[i].size(); ++k)
+				if (this->_adjacencyList[i][j] == arcs[i][k])
+					found = true;
+
+			if (!found)
+				difGraph._adjacencyList[i].push_back(this->_adjacencyList[i][j]);
+		}
+	}
+
+	uint64_t arcCount = 0;
+
+	for (uint32_t i = 0; i < difGraph.GetVertices(); ++i)
+		arcCount += difGraph._adjacencyList[i].size();
+
+	difGraph._weighted = _weighted;
+	difGraph._edges = static_cast<uint32_t>(arcCount);
+
+	return difGraph;
+}
+
+bool DirectedGraph::operator==(DirectedGraph const& source) const
+{
+	return GetEdges() == source.GetEdges() && HasSameArcs(source);
+}
+
+void DirectedGraph::GetStronglyConnectedComponents(uint32_t const& vertex, Vector<uint32_t>* depth, Vector<uint32_t>* low,
+	uint32_t* time, Vector<bool>* isInStack, Stack<uint32_t>* stack, Matrix<uint32_t>* stronglyConnectedComponents) const
+{
+	if (!IsValidVertex(vertex))
+		return;
+
+	GRAPH_STATS_COLLECTOR();
+	GRAPH_STATS_RECURSION();
+	GRAPH_STATS_ADD(VerticesVisited, 1);
+	GRAPH_STATS_ADD(EdgesScanned, _adjacencyList[vertex].size());
+
+	stack->push(vertex);
+	(*isInStack)[vertex] = true;
+	(*depth)[vertex] = (*low)[vertex] = ++(*time);
+
+	for (AdjacencyListConstIterator neighbour = _adjacencyList[vertex].begin(); neighbour != _adjacencyList[vertex].end(); ++neighbour)
+	{
+		if (!(*depth)[neighbour->first])
+		{
+			GetStronglyConnectedComponents(neighbour->first, depth, low, time, isInStack, stack, stronglyConnectedComponents);
+			(*low)[vertex] = std::min((*low)[vertex], (*low)[neighbour->first]);
+		}
+		else if ((*isInStack)[neighbour->first])
+			(*low)[vertex] = std::min((*low)[vertex], (*depth)[neighbour->first]);
+	}
+
+	if ((*low)[vertex] == (*depth)[vertex])
+	{
+		Matrix<uint32_t>::reverse_iterator itr;
+		stronglyConnectedComponents->push_back(Vector<uint32_t>());
+		itr = stronglyConnectedComponents->rbegin();
+
+		while (stack->top() != vertex)
+		{
+			itr->push_back(stack->top());
+			(*isInStack)[stack->top()] = false;
+			stack->pop();
+		}
+
+		itr->push_back(stack->top());
+		(*isInStack)[stack->top()] = false;
+		stack->pop();
+	}
+}
+
+std::istream& operator>>(std::istream& is, DirectedGraph& graph)
+{
+	uint16_t weighted;
+	uint32_t vertices;
+	is >> vertices >> graph._edges >> weighted;
+
+	graph._adjacencyList.assign(vertices, Vector<Pair<uint32_t, int32_t>>());
+
+	graph._weighted = weighted ? true : false;
+	graph._permutation = VertexPermutation();
+
+	if (!graph.IsWeighted())
+		for (uint32_t i = 0; i < graph.GetEdges(); ++i)
+		{
+			uint32_t x, y;
+
+			is >> x >> y;
+			graph._adjacencyList[x].push_back(std::make_pair(y, 0));
+		}
+	else
+		for (uint32_t i = 0; i < graph.GetEdges(); ++i)
+		{
+			uint32_t x, y, w;
+
+			is >> x >> y >> w;
+			graph._adjacencyList[x].push_back(std::make_pair(y, w));
+		}
+
+	return is;
+}
+
+std::ifstream& operator>>(std::ifstream& ifs, DirectedGraph& graph)
+{
+	uint16_t weighted;
+	uint32_t vertices;
+	ifs >> vertices >> graph._edges >> weighted;
+
+	graph._adjacencyList.assign(vertices, Vector<Pair<uint32_t, int32_t>>());
+
+	graph._weighted = weighted ? true : false;
+	graph._permutation = VertexPermutation();
+
+	if (!graph.IsWeighted())
+		for (uint32_t i = 0; i < graph.GetEdges(); ++i)
+		{
+			uint32_t x, y;
+
+			ifs >> x >> y;
+			graph._adjacencyList[x].push_back(std::make_pair(y, 0));
+		}
+	else
+		for (uint32_t i = 0; i < graph.GetEdges(); ++i)
+		{
+			uint32_t x, y, w;
+
+			ifs >> x >> y >> w;
+			graph._adjacencyList[x].push_back(std::make_pair(y, w));
+		}
+
+	return ifs;
+}
+
@@ -1,42 +1,54 @@
-#ifndef _DIRECTED_GRAPH_H
-#define _DIRECTED_GRAPH_H
-
-#include "PCH.h"
-#include "Graph.h"
-
-class DirectedGraph : public Graph
-{
-	public:
-		DirectedGraph() : Graph() { }
-		explicit DirectedGraph(std::ifstream& ifs, bool weighted = false);
-		DirectedGraph(DirectedGraph const& source) : Graph(source) { }
-
-		bool IsComplete() const override;
-		bool IsRegular() const override;
-		bool IsStronglyConnected() const;
-
-		Vector<Vector<bool>> GetRoadMatrix() const override;
-
-		std::stack<uint32_t> GetTopologicalSort() const;
-		Matrix<uint32_t> GetStronglyConnectedComponents() const;
-
-		DirectedGraph& operator=(DirectedGraph const& source);
-
-		DirectedGraph operator+(DirectedGraph const& source) const;
-		DirectedGraph operator-(DirectedGraph const& source) const;
-
-		bool operator==(DirectedGraph const& source) const;
-		bool operator!=(DirectedGraph const& source) const { return !((*this) == source); }
-
-		friend std::istream& operator>>(std::istream& is, DirectedGraph& graph);
-		friend std::ifstream& operator>>(std::ifstream& ifs, DirectedGraph& graph);
-
-	private:
-		void TopologicalSort(uint32_t const& vertex, Vector<bool>* visited, Stack<uint32_t>* topSort) const;
-
-		void GetStronglyConnectedComponents(uint32_t const& vertex, Vector<uint32_t>* depth, Vector<uint32_t>* low,
-			Vector<bool>* isInStack, Stack<uint32_t>* stack, Matrix<uint32_t>* stronglyConnectedComponents) const;
-};
-
-#endif
-
+#ifndef _DIRECTED_GRAPH_H
+#define _DIRECTED_GRAPH_H
+
+#include "PCH.h"
+#include "Graph.h"
+#include "ComponentLabels.h"
+#include "RunControl.h"
+
+class DirectedGraph : public Graph
+{
+	public:
+		DirectedGraph() : Graph() { }
+		explicit DirectedGraph(std::ifstream& ifs, bool weighted = false);
+		DirectedGraph(uint32_t const& vertices, EdgesVector const& edges, bool weighted = false) :
+			Graph(vertices, edges, weighted, true) { }
+		DirectedGraph(DirectedGraph const& source) : Graph(source) { }
+		DirectedGraph(DirectedGraph&& source) : Graph(std::move(source)) { }
+
+		bool IsComplete() const override;
+		bool IsRegular() const override;
+		bool IsStronglyConnected() const;
+		bool IsEulerian() const;		// Isolated vertices are ignored, EulerianPath gives the circuit.
+
+		Vector<Vector<bool>> GetRoadMatrix() const override;
+
+		// One BFS per source; empty when the control stops the run. Progress counts sources.
+		Matrix<bool> GetRoadMatrix(RunControl* control) const;
+
+		// Empty when the graph has a cycle, TopologicalOrder reports it along with the levels and critical path.
+		Vector<uint32_t> GetTopologicalSort(uint32_t const& threads = 1) const;
+		Matrix<uint32_t> GetStronglyConnectedComponents() const;
+
+		// Iterative Tarjan that refills components in place, the components come in reverse topological order.
+		void GetStronglyConnectedComponents(ComponentLabels* components) const;
+
+		DirectedGraph& operator=(DirectedGraph const& source);
+		DirectedGraph& operator=(DirectedGraph&& source);
+
+		DirectedGraph operator+(DirectedGraph const& source) const;
+		DirectedGraph operator-(DirectedGraph const& source) const;
+
+		bool operator==(DirectedGraph const& source) const;
+		bool operator!=(DirectedGraph const& source) const { return !((*this) == source); }
+
+		friend std::istream& operator>>(std::istream& is, DirectedGraph& graph);
+		friend std::ifstream& operator>>(std::ifstream& ifs, DirectedGraph& graph);
+
+	private:
+		void GetStronglyConnectedComponents(uint32_t const& vertex, Vector<uint32_t>* depth, Vector<uint32_t>* low,
+			uint32_t* time, Vector<bool>* isInStack, Stack<uint32_t>* stack, Matrix<uint32_t>* stronglyConnectedComponents) const;
+};
+
+#endif
+
@@ -0,0 +1,176 @@
+#include "PCH.h"
+#include "EulerianPath.h"
+#include "Instrumentation.h"
+
+EulerianPath::EulerianPath(UndirectedGraph const& graph)
+{
+	uint32_t vertices = graph.GetVertices();
+	uint32_t start = vertices;
+	uint32_t odd = 0;
+	Vector<uint64_t> offsets(vertices + 1, 0);
+
+	for (uint32_t i = 0; i < vertices; ++i)
+	{
+		offsets[i + 1] = offsets[i] + graph.GetNeighbours(i).size();
+
+		// A path starts at one of the two odd vertices, a circuit anywhere.
+		if (graph.GetNeighbours(i).size() & 1)
+		{
+			if (!odd++)
+				start = i;
+		}
+		else if (start == vertices && !graph.GetNeighbours(i).empty())
+			start = i;
+	}
+
+	if ((odd != 0 && odd != 2) || start == vertices)
+		return;
+
+	// Both arcs of an edge in one pass of counting sorts: into holds the arcs ending at every vertex ordered by their
+	// source, sorted the arcs leaving it ordered by their target, so the i-th of each are the two arcs of one edge.
+	// Parallel edges pair up in the order they were added, self loops with their next copy.
+	uint64_t arcs = offsets.back();
+	Vector<uint64_t> mates(arcs);
+	Vector<uint64_t> into(arcs);
+	Vector<uint64_t> sorted(arcs);
+	Vector<uint32_t> sources(arcs);
+	Vector<uint64_t> nextInto(offsets.begin(), offsets.end() - 1);
+	Vector<uint64_t> nextSorted(nextInto);
+
+	for (uint32_t i = 0; i < vertices; ++i)
+	{
+		uint64_t loop = arcs;
+
+		for (uint32_t j = 0; j < graph.GetNeighbours(i).size(); ++j)
+		{
+			uint64_t arc = offsets[i] + j;
+			uint32_t target = graph.GetNeighbours(i)[j].first;
+
+			sources[arc] = i;
+
+			if (target != i)
+				into[nextInto[target]++] = arc;
+			else if (loop == arcs)
+				loop = arc;
+			else
+			{
+				mates[loop] = arc;
+				mates[arc] = loop;
+				loop = arcs;
+			}
+		}
+	}
+
+	for (uint32_t i = 0; i < vertices; ++i)
+		for (uint64_t j = offsets[i]; j < nextInto[i]; ++j)
+			sorted[nextSorted[sources[into[j]]]++] = into[j];
+
+	for (uint32_t i = 0; i < vertices; ++i)
+		for (uint64_t j = offsets[i]; j < nextInto[i]; ++j)
+			mates[sorted[j]] = into[j];
+
+	Vector<uint64_t>().swap(into);
+	Vector<uint64_t>().swap(sorted);
+	Vector<uint32_t>().swap(sources);
+
+	Build(graph, start, arcs / 2, offsets, mates);
+}
+
+EulerianPath::EulerianPath(DirectedGraph const& graph)
+{
+	uint32_t vertices = graph.GetVertices();
+	Vector<int64_t> balances(vertices, 0);
+	Vector<uint64_t> offsets(vertices + 1, 0);
+
+	for (uint32_t i = 0; i < vertices; ++i)
+	{
+		offsets[i + 1] = offsets[i] + graph.GetNeighbours(i).size();
+		balances[i] += graph.GetNeighbours(i).size();
+
+		for (AdjacencyListConstIterator itr = graph.GetNeighbours(i).begin(); itr != graph.GetNeighbours(i).end(); ++itr)
+			--balances[itr->first];
+	}
+
+	// A path starts at the vertex with one more out arc than in arcs, a circuit anywhere.
+	uint32_t start = vertices;
+	uint32_t unbalanced = 0;
+
+	for (uint32_t i = 0; i < vertices; ++i)
+		if (balances[i] == 1)
+		{
+			start = i;
+			++unbalanced;
+		}
+		else if (balances[i] != 0 && balances[i] != -1)
+			return;
+
+	if (unbalanced > 1)
+		return;
+
+	for (uint32_t i = 0; i < vertices && start == vertices; ++i)
+		if (!graph.GetNeighbours(i).empty())
+			start = i;
+
+	if (start == vertices)
+		return;
+
+	Build(graph, start, offsets.back(), offsets, Vector<uint64_t>());
+}
+
+void EulerianPath::Build(Graph const& graph, uint32_t const& start, uint64_t const& edges, Vector<uint64_t> const& offsets,
+	Vector<uint64_t> const& mates)
+{
+	GRAPH_STATS_COLLECTOR();
+	GRAPH_STATS_ADD(VerticesVisited, graph.GetVertices());
+	GRAPH_STATS_ADD(EdgesScanned, offsets.back());
+
+	// The walk is extended from the top of the stack until it gets stuck, which can only happen where it closes (or at
+	// the path's end); the stuck vertices come off in reverse walk order. Every entry keeps the neighbour index of the
+	// arc that led to it.
+	Vector<uint32_t> cursors(graph.GetVertices(), 0);
+	Vector<bool> used(mates.size(), false);
+	Vector<Pair<uint32_t, uint32_t>> stack(1, std::make_pair(start, 0U));
+
+	_path.reserve(edges + 1);
+	_indices.reserve(edges + 1);
+
+	while (!stack.empty())
+	{
+		uint32_t vertex = stack.back().first;
+		uint32_t& cursor = cursors[vertex];
+		uint32_t degree = static_cast<uint32_t>(graph.GetNeighbours(vertex).size());
+
+		if (!mates.empty())
+			while (cursor < degree && used[offsets[vertex] + cursor])
+				++cursor;
+
+		if (cursor < degree)
+		{
+			if (!mates.empty())
+			{
+				used[offsets[vertex] + cursor] = true;
+				used[mates[offsets[vertex] + cursor]] = true;
+			}
+
+			stack.push_back(std::make_pair(graph.GetNeighbours(vertex)[cursor].first, cursor));
+			++cursor;
+			continue;
+		}
+
+		_path.push_back(vertex);
+		_indices.push_back(stack.back().second);
+		stack.pop_back();
+	}
+
+	// Edges left over are out of the start's reach.
+	if (_path.size() != edges + 1)
+	{
+		_path.clear();
+		_indices.clear();
+		return;
+	}
+
+	_indices.pop_back();
+	std::reverse(_path.begin(), _path.end());
+	std::reverse(_indices.begin(), _indices.end());
+}
@@ -0,0 +1,36 @@
+#ifndef _EULERIAN_PATH_H
+#define _EULERIAN_PATH_H
+
+#include "PCH.h"
+#include "UndirectedGraph.h"
+#include "DirectedGraph.h"
+
+// Eulerian circuit or path by iterative Hierholzer in O(V + E): a cursor per vertex walks its arcs once and an
+// undirected edge is marked used on both of its arcs, so there is no recursion and no rescanning. Isolated vertices are
+// ignored; a graph without edges has no path. A self loop is one edge, as are parallel edges each.
+class EulerianPath
+{
+	public:
+		explicit EulerianPath(UndirectedGraph const& graph);
+		explicit EulerianPath(DirectedGraph const& graph);
+
+		bool HasPath() const { return !_path.empty(); }
+		bool IsCircuit() const { return HasPath() && _path.front() == _path.back(); }
+
+		// The E + 1 vertices of the walk, a circuit starts and ends at the same vertex.
+		Vector<uint32_t> const& GetPath() const { return _path; }
+
+		// The i-th edge leaves GetPath()[i] through its neighbour GetIndices()[i], which tells apart parallel edges and
+		// gives the weights.
+		Vector<uint32_t> const& GetIndices() const { return _indices; }
+
+	private:
+		// mates is empty for a directed graph, else it holds the other arc of every arc's edge.
+		void Build(Graph const& graph, uint32_t const& start, uint64_t const& edges, Vector<uint64_t> const& offsets,
+			Vector<uint64_t> const& mates);
+
+		Vector<uint32_t> _path;
+		Vector<uint32_t> _indices;
+};
+
+#endif
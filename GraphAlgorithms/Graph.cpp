@@ -1,268 +1,477 @@
-#include "PCH.h"
-#include "Graph.h"
-
-uint32_t Graph::GetDegree(uint32_t const& vertex) const
-{
-	if (!IsValidVertex(vertex))
-		return 0;
-
-	return GetInDegree(vertex) + GetOutDegree(vertex);
-}
-
-uint32_t Graph::GetInDegree(uint32_t const& vertex) const
-{
-	if (!IsValidVertex(vertex))
-		return 0;
-
-	uint32_t count = 0;
-
-	for (uint32_t i = 0; i < GetVertices(); ++i)
-	{
-		for (uint32_t j = 0; j < _adjacencyList[i].size(); ++j)
-			if (_adjacencyList[i][j].first == vertex)
-				++count;
-	}
-
-	return count;
-}
-
-uint32_t Graph::GetOutDegree(uint32_t const& vertex) const
-{
-	if (!IsValidVertex(vertex))
-		return 0;
-
-	return static_cast<uint32_t>(_adjacencyList[vertex].size());
-}
-
-uint32_t Graph::GetMinDegree() const
-{
-	if (!HasVertices() || !HasEdges() || GetVertices() == 1)
-		return 0;
-
-	uint32_t minDegree = UINT32_MAX;
-
-	for (uint32_t i = 0; i < GetVertices(); ++i)
-		if (GetDegree(i) < minDegree)
-			minDegree = GetDegree(i);
-
-	return minDegree;
-}
-
-uint32_t Graph::GetMaxDegree() const
-{
-	if (!HasVertices() || !HasEdges() || GetVertices() == 1)
-		return 0;
-
-	uint32_t maxDegree = 0;
-
-	for (uint32_t i = 0; i < GetVertices(); ++i)
-		if (GetDegree(i) > maxDegree)
-			maxDegree = GetDegree(i);
-
-	return maxDegree;
-}
-
-uint32_t Graph::GetMinInDegree() const
-{
-	if (!HasVertices() || !HasEdges() || GetVertices() == 1)
-		return 0;
-
-	uint32_t minInDegree = UINT32_MAX;
-
-	for (uint32_t i = 0; i < GetVertices(); ++i)
-		if (GetInDegree(i) < minInDegree)
-			minInDegree = GetInDegree(i);
-
-	return minInDegree;
-}
-
-uint32_t Graph::GetMinOutDegree() const
-{
-	if (!HasVertices() || !HasEdges() || GetVertices() == 1)
-		return 0;
-
-	uint32_t minOutDegree = UINT32_MAX;
-
-	for (uint32_t i = 0; i < GetVertices(); ++i)
-		if (GetOutDegree(i) < minOutDegree)
-			minOutDegree = GetOutDegree(i);
-
-	return minOutDegree;
-}
-
-uint32_t Graph::GetMaxInDegree() const
-{
-	if (!HasVertices() || !HasEdges() || GetVertices() == 1)
-		return 0;
-
-	uint32_t maxInDegree = 0;
-
-	for (uint32_t i = 0; i < GetVertices(); ++i)
-		if (GetInDegree(i) > maxInDegree)
-			maxInDegree = GetInDegree(i);
-
-	return maxInDegree;
-}
-
-uint32_t Graph::GetMaxOutDegree() const
-{
-	if (!HasVertices() || !HasEdges() || GetVertices() == 1)
-		return 0;
-
-	uint32_t maxOutDegree = 0;
-
-	for (uint32_t i = 0; i < GetVertices(); ++i)
-		if (GetOutDegree(i) > maxOutDegree)
-			maxOutDegree = GetOutDegree(i);
-
-	return maxOutDegree;
-}
-
-double Graph::GetDensity() const
-{
-	return (static_cast<double>(_edges) / static_cast<double>(GetVertices() * (GetVertices() - 1)));
-}
-
-Vector<uint32_t> Graph::BreadthFirstSearch(uint32_t const& vertex) const
-{
-	if (!IsValidVertex(vertex))
-		return Vector<uint32_t>();
-
-	Vector<bool> visited(GetVertices());
-	Queue<uint32_t> queue;
-	Vector<uint32_t> connectedComponent;
-
-	queue.push(vertex);
-	visited[vertex] = true;
-	connectedComponent.push_back(vertex);
-
-	while (!queue.empty())
-	{
-		uint32_t element = queue.front();
-
-		for (uint32_t i = 0; i < _adjacencyList[element].size(); ++i)
-			if (!visited[_adjacencyList[element][i].first])
-			{
-				queue.push(_adjacencyList[element][i].first);
-				visited[_adjacencyList[element][i].first] = true;
-				connectedComponent.push_back(_adjacencyList[element][i].first);
-			}
-
-		queue.pop();
-	}
-
-	return connectedComponent;
-}
-
-Vector<uint32_t> Graph::DepthFirstSearch(uint32_t const& vertex) const
-{
-	if (!IsValidVertex(vertex))
-		return Vector<uint32_t>();
-
-	Vector<bool> visited(GetVertices());
-	Stack<uint32_t> stack;
-	Vector<uint32_t> connectedComponent;
-
-	stack.push(vertex);
-	visited[vertex] = true;
-	connectedComponent.push_back(vertex);
-
-	while (!stack.empty())
-	{
-		uint32_t index, element = stack.top();
-		bool found = false;
-
-		for (index = 0; index < _adjacencyList[element].size() && !found; ++index)
-			if (!visited[_adjacencyList[element][index].first])
-				found = true;
-
-		if (found)
-		{
-			--index;
-			stack.push(_adjacencyList[element][index].first);
-			visited[_adjacencyList[element][index].first] = true;
-			connectedComponent.push_back(_adjacencyList[element][index].first);
-			continue;
-		}
-
-		stack.pop();
-	}
-
-	return connectedComponent;
-}
-
-Vector<int> Graph::GetRoadDistance(uint32_t const& vertex) const
-{
-	if (!IsValidVertex(vertex))
-		return Vector<int>();
-
-	Vector<bool> visited(GetVertices());
-	Vector<int> roadDistance(GetVertices(), -1);
-	PriorityQueue<Pair<uint32_t, int32_t>, Vector<Pair<uint32_t, int32_t>>, VerticesCostComparator<false>> pQueue;
-
-	roadDistance[vertex] = 0;
-	pQueue.push(std::make_pair(vertex, roadDistance[vertex]));
-
-	while (!pQueue.empty())
-	{
-		uint32_t element = pQueue.top().first;
-
-		pQueue.pop();
-
-		if (visited[element])
-			continue;
-
-		visited[element] = true;
-
-		for (AdjacencyListConstIterator itr = _adjacencyList[element].begin(); itr != _adjacencyList[element].end(); ++itr)
-		{
-			uint32_t neighbour = itr->first;
-			int32_t distance = itr->second;
-
-			if ((roadDistance[neighbour] > (roadDistance[element] + distance)) || (roadDistance[neighbour] < 0))
-			{
-				roadDistance[neighbour] = roadDistance[element] + distance;
-				pQueue.push(std::make_pair(neighbour, roadDistance[neighbour]));
-			}
-		}
-	}
-
-	return roadDistance;
-}
-
-std::ostream& operator<<(std::ostream& os, Graph const& graph)
-{
-	for (uint32_t i = 0; i < graph._adjacencyList.size(); ++i)
-	{
-		os << i << " | ";
-
-		for (uint32_t j = 0; j < graph._adjacencyList[i].size(); ++j)
-			if (!graph.IsWeighted())
-				os << graph._adjacencyList[i][j].first << ", ";
-			else
-				os << graph._adjacencyList[i][j].first << " - " << graph._adjacencyList[i][j].second << ", ";
-
-		os << "\n";
-	}
-
-	return os;
-}
-
-std::ofstream& operator<<(std::ofstream& ofs, Graph const& graph)
-{
-	for (uint32_t i = 0; i < graph._adjacencyList.size(); ++i)
-	{
-		ofs << i << " | ";
-
-		for (uint32_t j = 0; j < graph._adjacencyList[i].size(); ++j)
-			if (!graph.IsWeighted())
-				ofs << graph._adjacencyList[i][j].first << ", ";
-			else
-				ofs << graph._adjacencyList[i][j].first << " - " << graph._adjacencyList[i][j].second << ", ";
-
-		ofs << "\n";
-	}
-
-	return ofs;
-}
-
+#include "PCH.h"
+#include "Graph.h"
+#include "GraphWriter.h"
+#include "Instrumentation.h"
+#include "Traversal.h"
+
+Graph::Graph(uint32_t const& vertices, EdgesVector const& edges, bool weighted, bool directed) : _weighted(weighted),
+	_edges(static_cast<uint32_t>(edges.size())), _adjacencyList(vertices)
+{
+	Vector<uint32_t> degrees(vertices, 0);
+
+	for (EdgesVector::const_iterator itr = edges.begin(); itr != edges.end(); ++itr)
+	{
+		++degrees[itr->first.first];
+
+		if (!directed)
+			++degrees[itr->first.second];
+	}
+
+	for (uint32_t i = 0; i < vertices; ++i)
+		_adjacencyList[i].reserve(degrees[i]);
+
+	for (EdgesVector::const_iterator itr = edges.begin(); itr != edges.end(); ++itr)
+	{
+		int32_t weight = weighted ? itr->second : 0;
+
+		_adjacencyList[itr->first.first].push_back(std::make_pair(itr->first.second, weight));
+
+		if (!directed)
+			_adjacencyList[itr->first.second].push_back(std::make_pair(itr->first.first, weight));
+	}
+}
+
+uint32_t Graph::GetDegree(uint32_t const& vertex) const
+{
+	if (!IsValidVertex(vertex))
+		return 0;
+
+	return GetInDegree(vertex) + GetOutDegree(vertex);
+}
+
+uint32_t Graph::GetInDegree(uint32_t const& vertex) const
+{
+	if (!IsValidVertex(vertex))
+		return 0;
+
+	uint32_t count = 0;
+
+	for (uint32_t i = 0; i < GetVertices(); ++i)
+	{
+		for (uint32_t j = 0; j < _adjacencyList[i].size(); ++j)
+			if (_adjacencyList[i][j].first == vertex)
+				++count;
+	}
+
+	return count;
+}
+
+uint32_t Graph::GetOutDegree(uint32_t const& vertex) const
+{
+	if (!IsValidVertex(vertex))
+		return 0;
+
+	return static_cast<uint32_t>(_adjacencyList[vertex].size());
+}
+
+Vector<uint32_t> Graph::GetDegrees() const
+{
+	Vector<uint32_t> degrees = GetInDegrees();
+
+	for (uint32_t i = 0; i < GetVertices(); ++i)
+		degrees[i] += static_cast<uint32_t>(_adjacencyList[i].size());
+
+	return degrees;
+}
+
+Vector<uint32_t> Graph::GetInDegrees() const
+{
+	Vector<uint32_t> inDegrees(GetVertices(), 0);
+
+	for (uint32_t i = 0; i < GetVertices(); ++i)
+		for (uint32_t j = 0; j < _adjacencyList[i].size(); ++j)
+			++inDegrees[_adjacencyList[i][j].first];
+
+	return inDegrees;
+}
+
+uint32_t Graph::GetMinDegree() const
+{
+	if (!HasVertices() || !HasEdges() || GetVertices() == 1)
+		return 0;
+
+	Vector<uint32_t> degrees = GetDegrees();
+
+	return *std::min_element(degrees.begin(), degrees.end());
+}
+
+uint32_t Graph::GetMaxDegree() const
+{
+	if (!HasVertices() || !HasEdges() || GetVertices() == 1)
+		return 0;
+
+	Vector<uint32_t> degrees = GetDegrees();
+
+	return *std::max_element(degrees.begin(), degrees.end());
+}
+
+uint32_t Graph::GetMinInDegree() const
+{
+	if (!HasVertices() || !HasEdges() || GetVertices() == 1)
+		return 0;
+
+	Vector<uint32_t> inDegrees = GetInDegrees();
+
+	return *std::min_element(inDegrees.begin(), inDegrees.end());
+}
+
+uint32_t Graph::GetMinOutDegree() const
+{
+	if (!HasVertices() || !HasEdges() || GetVertices() == 1)
+		return 0;
+
+	uint32_t minOutDegree = UINT32_MAX;
+
+	for (uint32_t i = 0; i < GetVertices(); ++i)
+		minOutDegree = std::min(minOutDegree, static_cast<uint32_t>(_adjacencyList[i].size()));
+
+	return minOutDegree;
+}
+
+uint32_t Graph::GetMaxInDegree() const
+{
+	if (!HasVertices() || !HasEdges() || GetVertices() == 1)
+		return 0;
+
+	Vector<uint32_t> inDegrees = GetInDegrees();
+
+	return *std::max_element(inDegrees.begin(), inDegrees.end());
+}
+
+uint32_t Graph::GetMaxOutDegree() const
+{
+	if (!HasVertices() || !HasEdges() || GetVertices() == 1)
+		return 0;
+
+	uint32_t maxOutDegree = 0;
+
+	for (uint32_t i = 0; i < GetVertices(); ++i)
+		maxOutDegree = std::max(maxOutDegree, static_cast<uint32_t>(_adjacencyList[i].size()));
+
+	return maxOutDegree;
+}
+
+double Graph::GetDensity() const
+{
+	return (static_cast<double>(_edges) / static_cast<double>(GetVertices() * (GetVertices() - 1)));
+}
+
+Vector<uint32_t> Graph::BreadthFirstSearch(uint32_t const& vertex) const
+{
+	if (!IsValidVertex(vertex))
+		return Vector<uint32_t>();
+
+	GRAPH_STATS_COLLECTOR();
+	GRAPH_STATS_ADD(BytesAllocated, GetVertices() / 8);
+
+	Vector<bool> visited(GetVertices());
+	Queue<uint32_t> queue;
+	Vector<uint32_t> connectedComponent;
+
+	queue.push(vertex);
+	visited[vertex] = true;
+	connectedComponent.push_back(vertex);
+
+	while (!queue.empty())
+	{
+		uint32_t element = queue.front();
+
+		GRAPH_STATS_ADD(VerticesVisited, 1);
+		GRAPH_STATS_ADD(EdgesScanned, _adjacencyList[element].size());
+
+		for (uint32_t i = 0; i < _adjacencyList[element].size(); ++i)
+			if (!visited[_adjacencyList[element][i].first])
+			{
+				queue.push(_adjacencyList[element][i].first);
+				visited[_adjacencyList[element][i].first] = true;
+				connectedComponent.push_back(_adjacencyList[element][i].first);
+			}
+
+		queue.pop();
+	}
+
+	return connectedComponent;
+}
+
+Vector<uint32_t> Graph::DepthFirstSearch(uint32_t const& vertex) const
+{
+	if (!IsValidVertex(vertex))
+		return Vector<uint32_t>();
+
+	GRAPH_STATS_COLLECTOR();
+	GRAPH_STATS_ADD(BytesAllocated, GetVertices() / 8);
+
+	Vector<bool> visited(GetVertices());
+	Stack<uint32_t> stack;
+	Vector<uint32_t> connectedComponent;
+
+	stack.push(vertex);
+	visited[vertex] = true;
+	connectedComponent.push_back(vertex);
+
+	while (!stack.empty())
+	{
+		uint32_t index, element = stack.top();
+		bool found = false;
+
+		for (index = 0; index < _adjacencyList[element].size() && !found; ++index)
+			if (!visited[_adjacencyList[element][index].first])
+				found = true;
+
+		GRAPH_STATS_ADD(EdgesScanned, index);
+
+		if (found)
+		{
+			--index;
+			stack.push(_adjacencyList[element][index].first);
+			visited[_adjacencyList[element][index].first] = true;
+			connectedComponent.push_back(_adjacencyList[element][index].first);
+			GRAPH_STATS_ADD(VerticesVisited, 1);
+			continue;
+		}
+
+		stack.pop();
+	}
+
+	return connectedComponent;
+}
+
+Vector<int> Graph::GetRoadDistance(uint32_t const& vertex) const
+{
+	if (!IsValidVertex(vertex))
+		return Vector<int>();
+
+	GRAPH_STATS_COLLECTOR();
+	GRAPH_STATS_ADD(BytesAllocated, GetVertices() / 8 + GetVertices() * sizeof(int));
+
+	Vector<bool> visited(GetVertices());
+	Vector<int> roadDistance(GetVertices(), -1);
+	PriorityQueue<Pair<uint32_t, int32_t>, Vector<Pair<uint32_t, int32_t>>, VerticesCostComparator<false>> pQueue;
+
+	roadDistance[vertex] = 0;
+	pQueue.push(std::make_pair(vertex, roadDistance[vertex]));
+	GRAPH_STATS_ADD(HeapPushes, 1);
+
+	while (!pQueue.empty())
+	{
+		uint32_t element = pQueue.top().first;
+
+		pQueue.pop();
+		GRAPH_STATS_ADD(HeapPops, 1);
+
+		if (visited[element])
+		{
+			GRAPH_STATS_ADD(StaleHeapPops, 1);
+			continue;
+		}
+
+		visited[element] = true;
+		GRAPH_STATS_ADD(VerticesVisited, 1);
+		GRAPH_STATS_ADD(EdgesScanned, _adjacencyList[element].size());
+
+		for (AdjacencyListConstIterator itr = _adjacencyList[element].begin(); itr != _adjacencyList[element].end(); ++itr)
+		{
+			uint32_t neighbour = itr->first;
+			int32_t distance = itr->second;
+
+			if ((roadDistance[neighbour] > (roadDistance[element] + distance)) || (roadDistance[neighbour] < 0))
+			{
+				roadDistance[neighbour] = roadDistance[element] + distance;
+				pQueue.push(std::make_pair(neighbour, roadDistance[neighbour]));
+				GRAPH_STATS_ADD(EdgesRelaxed, 1);
+				GRAPH_STATS_ADD(HeapPushes, 1);
+			}
+		}
+	}
+
+	return roadDistance;
+}
+
+Vector<uint32_t> const& Graph::BreadthFirstSearch(uint32_t const& vertex, TraversalWorkspace* workspace) const
+{
+	return Traversal::BreadthFirstSearch(Traversal::AllArcs(*this), vertex, UINT32_MAX, workspace);
+}
+
+bool Graph::IsReachable(uint32_t const& source, uint32_t const& target, TraversalWorkspace* workspace) const
+{
+	Traversal::BreadthFirstSearch(Traversal::AllArcs(*this), source, target, workspace);
+
+	return IsValidVertex(source) && IsValidVertex(target) && workspace->IsReached(target);
+}
+
+Vector<uint32_t> const& Graph::DepthFirstSearch(uint32_t const& vertex, TraversalWorkspace* workspace) const
+{
+	return Traversal::DepthFirstSearch(Traversal::AllArcs(*this), vertex, workspace);
+}
+
+Vector<uint32_t> const& Graph::GetRoadDistance(uint32_t const& vertex, TraversalWorkspace* workspace, int64_t const& radius) const
+{
+	workspace->Begin(GetVertices(), true);
+
+	if (!IsValidVertex(vertex))
+		return workspace->_order;
+
+	GRAPH_STATS_COLLECTOR();
+
+	Vector<Pair<int64_t, uint32_t>>& heap = workspace->_heap;
+	std::greater<Pair<int64_t, uint32_t>> compare;
+
+	workspace->Reach(vertex);
+	workspace->SetDistance(vertex, 0);
+	heap.push_back(std::make_pair(0, vertex));
+	GRAPH_STATS_ADD(HeapPushes, 1);
+
+	while (!heap.empty())
+	{
+		std::pop_heap(heap.begin(), heap.end(), compare);
+
+		int64_t length = heap.back().first;
+		uint32_t element = heap.back().second;
+
+		heap.pop_back();
+		GRAPH_STATS_ADD(HeapPops, 1);
+
+		if (workspace->IsSettled(element) || length > workspace->_distances[element])
+		{
+			GRAPH_STATS_ADD(StaleHeapPops, 1);
+			continue;
+		}
+
+		if (length > radius)
+			break;
+
+		workspace->Settle(element);
+		workspace->_order.push_back(element);
+		GRAPH_STATS_ADD(VerticesVisited, 1);
+		GRAPH_STATS_ADD(EdgesScanned, _adjacencyList[element].size());
+
+		for (AdjacencyListConstIterator itr = _adjacencyList[element].begin(); itr != _adjacencyList[element].end(); ++itr)
+		{
+			int64_t candidate = length + itr->second;
+
+			if (!workspace->IsReached(itr->first) || (!workspace->IsSettled(itr->first) && candidate < workspace->_distances[itr->first]))
+			{
+				workspace->Reach(itr->first);
+				workspace->SetDistance(itr->first, candidate);
+				heap.push_back(std::make_pair(candidate, itr->first));
+				std::push_heap(heap.begin(), heap.end(), compare);
+				GRAPH_STATS_ADD(EdgesRelaxed, 1);
+				GRAPH_STATS_ADD(HeapPushes, 1);
+			}
+		}
+	}
+
+	return workspace->_order;
+}
+
+VertexPermutation const& Graph::Reorder(VertexOrder const& order)
+{
+	VertexPermutation permutation = VertexPermutation::Compute(_adjacencyList, order);
+
+	Relabel(permutation);
+	_permutation = _permutation.Then(permutation);
+
+	return _permutation;
+}
+
+void Graph::Relabel(VertexPermutation const& permutation)
+{
+	if (permutation.IsIdentity())
+		return;
+
+	Matrix<Pair<uint32_t, int32_t>> adjacencyList(GetVertices());
+
+	for (uint32_t i = 0; i < GetVertices(); ++i)
+	{
+		Vector<Pair<uint32_t, int32_t>>& neighbours = adjacencyList[permutation.ToInternal(i)];
+
+		neighbours.swap(_adjacencyList[i]);
+
+		for (uint32_t j = 0; j < neighbours.size(); ++j)
+			neighbours[j].first = permutation.ToInternal(neighbours[j].first);
+
+		// Scanning the neighbours in id order walks the relabeled vertices front to back.
+		std::sort(neighbours.begin(), neighbours.end());
+	}
+
+	_adjacencyList.swap(adjacencyList);
+}
+
+bool Graph::HasSameArcs(Graph const& source) const
+{
+	if (GetVertices() != source.GetVertices())
+		return false;
+
+	Matrix<Pair<uint32_t, int32_t>> buffer;
+	Matrix<Pair<uint32_t, int32_t>> const& arcs = GetAlignedArcs(source, &buffer);
+	Vector<Pair<uint32_t, int32_t>> row;
+	Vector<Pair<uint32_t, int32_t>> sourceRow;
+
+	for (uint32_t i = 0; i < GetVertices(); ++i)
+	{
+		if (_adjacencyList[i].size() != arcs[i].size())
+			return false;
+
+		// The buffers keep their capacity, so only the first rows allocate.
+		row.assign(_adjacencyList[i].begin(), _adjacencyList[i].end());
+		sourceRow.assign(arcs[i].begin(), arcs[i].end());
+		std::sort(row.begin(), row.end());
+		std::sort(sourceRow.begin(), sourceRow.end());
+
+		if (row != sourceRow)
+			return false;
+	}
+
+	return true;
+}
+
+Matrix<Pair<uint32_t, int32_t>> const& Graph::GetAlignedArcs(Graph const& source, Matrix<Pair<uint32_t, int32_t>>* buffer) const
+{
+	if (GetVertices() != source.GetVertices() || _permutation.GetNewToOriginal() == source._permutation.GetNewToOriginal())
+		return source._adjacencyList;
+
+	buffer->assign(GetVertices(), Vector<Pair<uint32_t, int32_t>>());
+
+	for (uint32_t i = 0; i < source.GetVertices(); ++i)
+	{
+		Vector<Pair<uint32_t, int32_t>>& row = (*buffer)[_permutation.ToInternal(source._permutation.ToOriginal(i))];
+
+		for (uint32_t j = 0; j < source._adjacencyList[i].size(); ++j)
+			row.push_back(std::make_pair(_permutation.ToInternal(source._permutation.ToOriginal(source._adjacencyList[i][j].first)),
+				source._adjacencyList[i][j].second));
+	}
+
+	return *buffer;
+}
+
+void Graph::MoveFrom(Graph& source)
+{
+	_weighted = source._weighted;
+	_edges = source._edges;
+	_adjacencyList = std::move(source._adjacencyList);
+	_permutation = std::move(source._permutation);
+	source.Clear();
+}
+
+void Graph::Clear()
+{
+	_weighted = false;
+	_edges = 0;
+	_adjacencyList.clear();
+	_permutation = VertexPermutation();
+}
+
+std::ostream& operator<<(std::ostream& os, Graph const& graph)
+{
+	GraphWriter(os).WriteAdjacency(graph);
+
+	return os;
+}
+
+std::ofstream& operator<<(std::ofstream& ofs, Graph const& graph)
+{
+	GraphWriter(ofs).WriteAdjacency(graph);
+
+	return ofs;
+}
+
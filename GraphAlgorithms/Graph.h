@@ -1,95 +1,142 @@
-#ifndef _GRAPH_H
-#define _GRAPH_H
-
-#include "PCH.h"
-
-using AdjacencyListConstIterator = Vector<Pair<uint32_t, int32_t>>::const_iterator;
-
-class Graph
-{
-	public:
-		virtual ~Graph() { }
-
-		bool IsWeighted() const { return _weighted; }
-		bool HasVertices() const { return (GetVertices() != 0) ? true : false; }
-		bool HasEdges() const { return (GetEdges() != 0) ? true : false; }
-
-		uint32_t GetVertices() const { return _adjacencyList.size(); }
-		uint32_t GetEdges() const { return _edges; }
-
-		virtual uint32_t GetDegree(uint32_t const& vertex) const;
-		virtual uint32_t GetInDegree(uint32_t const& vertex) const;
-		virtual uint32_t GetOutDegree(uint32_t const& vertex) const final;
-
-		virtual uint32_t GetMinDegree() const;
-		virtual uint32_t GetMaxDegree() const;
-
-		virtual uint32_t GetMinInDegree() const final;
-		virtual uint32_t GetMinOutDegree() const final;
-		virtual uint32_t GetMaxInDegree() const final;
-		virtual uint32_t GetMaxOutDegree() const final;
-
-		virtual double GetDensity() const;
-
-		virtual bool IsComplete() const = 0;
-		virtual bool IsRegular() const = 0;
-
-		virtual Vector<uint32_t> BreadthFirstSearch(uint32_t const& vertex) const;
-		virtual Vector<uint32_t> DepthFirstSearch(uint32_t const& vertex) const;
-
-		virtual Matrix<bool> GetRoadMatrix() const = 0;
-		virtual Vector<int> GetRoadDistance(uint32_t const& vertex) const;
-
-		friend std::ostream& operator<<(std::ostream& os, Graph const& graph);
-		friend std::ofstream& operator<<(std::ofstream& ofs, Graph const& graph);
-
-	protected:
-		Graph() : _weighted(false), _edges(0), _adjacencyList(0) { }
-
-		explicit Graph(uint32_t const& vertices) : _weighted(false), _edges(vertices - 1), 
-			_adjacencyList(vertices) { }
-
-		Graph(Graph const& source) : _weighted(source._weighted), _edges(source._edges), 
-			_adjacencyList(source._adjacencyList) { }
-
-		bool IsValidVertex(uint32_t const& vertex) const { return !(vertex > (GetVertices() - 1)); };
-
-		bool _weighted;
-		uint32_t  _edges;
-		Matrix<Pair<uint32_t, int32_t>> _adjacencyList;	// It's an adjacency list dispite the type name.
-};
-
-class EdgesCostComparator
-{
-	public:
-		EdgesCostComparator(bool ascending) : _ascending(ascending) { }
-
-		bool operator()(Pair<Pair<uint32_t, uint32_t>, int32_t> const& firstEdge,
-			Pair<Pair<uint32_t, uint32_t>, int32_t> const& secondEdge) const
-		{
-			if (_ascending)
-				return firstEdge.second < secondEdge.second ? true : false;
-			
-			return firstEdge.second > secondEdge.second ? true : false;
-		}
-
-	private:
-		bool _ascending;
-};
-
-template <bool ascending>
-class VerticesCostComparator
-{
-	public:
-		bool operator()(Pair<uint32_t, int32_t> const& firstPair,
-			Pair<uint32_t, int32_t> const& secondPair) const
-		{
-			if (ascending)
-				return firstPair.second < secondPair.second ? true : false;
-
-			return firstPair.second > secondPair.second ? true : false;
-		}
-};
-
-#endif
-
+#ifndef _GRAPH_H
+#define _GRAPH_H
+
+#include "PCH.h"
+#include "VertexOrdering.h"
+#include "TraversalWorkspace.h"
+
+using AdjacencyListConstIterator = Vector<Pair<uint32_t, int32_t>>::const_iterator;
+using EdgesVector = Vector<Pair<Pair<uint32_t, uint32_t>, int32_t>>;
+
+// The const methods keep their state in locals or in caller provided workspaces, so any number of threads may query a
+// graph at once as long as none of them modifies it.
+class Graph
+{
+	public:
+		virtual ~Graph() { }
+
+		bool IsWeighted() const { return _weighted; }
+		bool HasVertices() const { return (GetVertices() != 0) ? true : false; }
+		bool HasEdges() const { return (GetEdges() != 0) ? true : false; }
+
+		uint32_t GetVertices() const { return _adjacencyList.size(); }
+		uint32_t GetEdges() const { return _edges; }
+
+		Vector<Pair<uint32_t, int32_t>> const& GetNeighbours(uint32_t const& vertex) const { return _adjacencyList[vertex]; }
+
+		virtual uint32_t GetDegree(uint32_t const& vertex) const;
+		virtual uint32_t GetInDegree(uint32_t const& vertex) const;
+		virtual uint32_t GetOutDegree(uint32_t const& vertex) const final;
+
+		// Every vertex's degree in one pass over the arcs, where GetInDegree scans all of them for one vertex.
+		virtual Vector<uint32_t> GetDegrees() const;
+		virtual Vector<uint32_t> GetInDegrees() const;
+
+		virtual uint32_t GetMinDegree() const;
+		virtual uint32_t GetMaxDegree() const;
+
+		virtual uint32_t GetMinInDegree() const final;
+		virtual uint32_t GetMinOutDegree() const final;
+		virtual uint32_t GetMaxInDegree() const final;
+		virtual uint32_t GetMaxOutDegree() const final;
+
+		virtual double GetDensity() const;
+
+		virtual bool IsComplete() const = 0;
+		virtual bool IsRegular() const = 0;
+
+		virtual Vector<uint32_t> BreadthFirstSearch(uint32_t const& vertex) const;
+		virtual Vector<uint32_t> DepthFirstSearch(uint32_t const& vertex) const;
+
+		virtual Matrix<bool> GetRoadMatrix() const = 0;
+		// Dijkstra, the weights must not be negative; BellmanFord handles negative ones.
+		virtual Vector<int> GetRoadDistance(uint32_t const& vertex) const;
+
+		// The same traversals on a reusable workspace, so their setup does not depend on V. They return the workspace's
+		// order, valid until its next traversal; GetRoadDistance leaves the distances in it and stops settling beyond
+		// radius, so only the vertices of the returned order have final distances.
+		Vector<uint32_t> const& BreadthFirstSearch(uint32_t const& vertex, TraversalWorkspace* workspace) const;
+		Vector<uint32_t> const& DepthFirstSearch(uint32_t const& vertex, TraversalWorkspace* workspace) const;
+		Vector<uint32_t> const& GetRoadDistance(uint32_t const& vertex, TraversalWorkspace* workspace,
+			int64_t const& radius = INT64_MAX) const;
+
+		// Whether target can be reached from source, the BFS stops as soon as it reaches target.
+		bool IsReachable(uint32_t const& source, uint32_t const& target, TraversalWorkspace* workspace) const;
+
+		// Relabels the vertices for memory locality. Every API works on internal ids afterwards, use
+		// GetPermutation() to translate vertices and per-vertex results from and to the original ids.
+		VertexPermutation const& Reorder(VertexOrder const& order);
+		VertexPermutation const& GetPermutation() const { return _permutation; }
+
+		friend std::ostream& operator<<(std::ostream& os, Graph const& graph);
+		friend std::ofstream& operator<<(std::ofstream& ofs, Graph const& graph);
+
+	protected:
+		Graph() : _weighted(false), _edges(0), _adjacencyList(0) { }
+
+		explicit Graph(uint32_t const& vertices) : _weighted(false), _edges(vertices - 1), 
+			_adjacencyList(vertices) { }
+
+		Graph(uint32_t const& vertices, EdgesVector const& edges, bool weighted, bool directed);
+
+		Graph(Graph const& source) : _weighted(source._weighted), _edges(source._edges), 
+			_adjacencyList(source._adjacencyList), _permutation(source._permutation) { }
+
+		// The source is left an empty graph.
+		Graph(Graph&& source) : _weighted(source._weighted), _edges(source._edges),
+			_adjacencyList(std::move(source._adjacencyList)), _permutation(std::move(source._permutation)) { source.Clear(); }
+
+		bool IsValidVertex(uint32_t const& vertex) const { return !(vertex > (GetVertices() - 1)); };
+
+		void Relabel(VertexPermutation const& permutation);
+
+		void MoveFrom(Graph& source);
+		void Clear();
+
+		// Same vertices and the same multiset of (target, weight) arcs on every vertex, whatever their order.
+		bool HasSameArcs(Graph const& source) const;
+
+		// The rows of source in this graph's internal ids, so graphs reordered differently combine by original ids. They
+		// are source's own rows when both share a permutation, else translated into buffer.
+		Matrix<Pair<uint32_t, int32_t>> const& GetAlignedArcs(Graph const& source, Matrix<Pair<uint32_t, int32_t>>* buffer) const;
+
+		bool _weighted;
+		uint32_t  _edges;
+		Matrix<Pair<uint32_t, int32_t>> _adjacencyList;	// It's an adjacency list dispite the type name.
+		VertexPermutation _permutation;					// Original ids <-> internal ids, identity unless Reorder was called.
+};
+
+class EdgesCostComparator
+{
+	public:
+		EdgesCostComparator(bool ascending) : _ascending(ascending) { }
+
+		bool operator()(Pair<Pair<uint32_t, uint32_t>, int32_t> const& firstEdge,
+			Pair<Pair<uint32_t, uint32_t>, int32_t> const& secondEdge) const
+		{
+			if (_ascending)
+				return firstEdge.second < secondEdge.second ? true : false;
+			
+			return firstEdge.second > secondEdge.second ? true : false;
+		}
+
+	private:
+		bool _ascending;
+};
+
+template <bool ascending>
+class VerticesCostComparator
+{
+	public:
+		bool operator()(Pair<uint32_t, int32_t> const& firstPair,
+			Pair<uint32_t, int32_t> const& secondPair) const
+		{
+			if (ascending)
+				return firstPair.second < secondPair.second ? true : false;
+
+			return firstPair.second > secondPair.second ? true : false;
+		}
+};
+
+#endif
+
@@ -0,0 +1,291 @@
+#include "PCH.h"
+#include "GraphFingerprint.h"
+#include "Instrumentation.h"
+#include "Parallel.h"
+
+uint32_t const GraphFingerprint::None;
+
+GraphFingerprint::GraphFingerprint(UndirectedGraph const& graph, uint32_t const& threads) : _graph(graph), _directed(false),
+	_rounds(0)
+{
+	Refine(threads);
+}
+
+GraphFingerprint::GraphFingerprint(DirectedGraph const& graph, uint32_t const& threads) : _graph(graph), _directed(true),
+	_inOffsets(graph.GetVertices() + 1, 0), _rounds(0)
+{
+	for (uint32_t i = 0; i < graph.GetVertices(); ++i)
+		for (AdjacencyListConstIterator itr = graph.GetNeighbours(i).begin(); itr != graph.GetNeighbours(i).end(); ++itr)
+			++_inOffsets[itr->first + 1];
+
+	for (uint32_t i = 0; i < graph.GetVertices(); ++i)
+		_inOffsets[i + 1] += _inOffsets[i];
+
+	Vector<uint64_t> next(_inOffsets.begin(), _inOffsets.end() - 1);
+
+	_inArcs.resize(_inOffsets.back());
+
+	for (uint32_t i = 0; i < graph.GetVertices(); ++i)
+		for (AdjacencyListConstIterator itr = graph.GetNeighbours(i).begin(); itr != graph.GetNeighbours(i).end(); ++itr)
+			_inArcs[next[itr->first]++] = std::make_pair(i, itr->second);
+
+	Refine(threads);
+}
+
+uint64_t GraphFingerprint::Mix(uint64_t value)
+{
+	// The splitmix64 finalizer.
+	value += 0x9E3779B97F4A7C15ULL;
+	value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+
+	return value ^ (value >> 31);
+}
+
+void GraphFingerprint::Refine(uint32_t const& threads)
+{
+	GRAPH_STATS_COLLECTOR();
+
+	uint32_t vertices = _graph.GetVertices();
+	uint64_t arcs = 0;
+	Vector<uint64_t> next(vertices);
+	Vector<uint64_t> sorted;
+
+	_colors.resize(vertices);
+
+	for (uint32_t i = 0; i < vertices; ++i)
+	{
+		uint64_t inDegree = _directed ? _inOffsets[i + 1] - _inOffsets[i] : 0;
+
+		_colors[i] = Mix(_graph.GetNeighbours(i).size() ^ (inDegree << 32));
+		arcs += _graph.GetNeighbours(i).size();
+	}
+
+	// The number of color classes, leaving the colors sorted.
+	auto countClasses = [&](Vector<uint64_t> const& colors)
+	{
+		sorted.assign(colors.begin(), colors.end());
+		std::sort(sorted.begin(), sorted.end());
+
+		return static_cast<uint32_t>(std::unique(sorted.begin(), sorted.end()) - sorted.begin());
+	};
+
+	uint32_t classes = countClasses(_colors);
+
+	while (true)
+	{
+		// Sums of mixed terms hash the neighbour multisets whatever the arc order.
+		Parallel::For(0, vertices, threads, [&](uint64_t const& first, uint64_t const& last, uint32_t const&)
+		{
+			for (uint64_t i = first; i < last; ++i)
+			{
+				uint64_t out = 0;
+				uint64_t in = 0;
+
+				for (AdjacencyListConstIterator itr = _graph.GetNeighbours(i).begin(); itr != _graph.GetNeighbours(i).end(); ++itr)
+					out += Mix(_colors[itr->first] ^ Mix(static_cast<uint32_t>(itr->second)));
+
+				for (uint64_t j = _directed ? _inOffsets[i] : 0; j < (_directed ? _inOffsets[i + 1] : 0); ++j)
+					in += Mix(Mix(_colors[_inArcs[j].first]) ^ static_cast<uint32_t>(_inArcs[j].second));
+
+				next[i] = Mix(Mix(_colors[i] ^ Mix(out)) + in);
+			}
+		});
+
+		GRAPH_STATS_ADD(VerticesVisited, vertices);
+		GRAPH_STATS_ADD(EdgesScanned, arcs * (_directed ? 2 : 1));
+
+		uint32_t refined = countClasses(next);
+
+		_colors.swap(next);
+		++_rounds;
+
+		if (refined == classes)
+			break;
+
+		classes = refined;
+	}
+
+	countClasses(_colors);
+
+	_fingerprint.low = Mix(vertices ^ (static_cast<uint64_t>(_directed) << 63));
+	_fingerprint.high = Mix(arcs);
+
+	for (uint32_t i = 0; i < vertices; ++i)
+	{
+		_fingerprint.low = Mix(_fingerprint.low ^ sorted[i]);
+		_fingerprint.high = Mix(_fingerprint.high + sorted[i] * 0xC2B2AE3D27D4EB4FULL);
+	}
+}
+
+bool GraphFingerprint::IsIsomorphic(GraphFingerprint const& source) const
+{
+	GRAPH_STATS_COLLECTOR();
+
+	uint32_t vertices = _graph.GetVertices();
+
+	if (_directed != source._directed || _fingerprint != source._fingerprint || vertices != source._graph.GetVertices())
+		return false;
+
+	if (!vertices)
+		return true;
+
+	// The source vertices grouped by color are the candidates for a vertex of that color.
+	Vector<Pair<uint64_t, uint32_t>> candidates(vertices);
+
+	for (uint32_t i = 0; i < vertices; ++i)
+		candidates[i] = std::make_pair(source._colors[i], i);
+
+	std::sort(candidates.begin(), candidates.end());
+
+	auto firstCandidate = [&](uint32_t const& vertex)
+	{
+		return static_cast<uint32_t>(std::lower_bound(candidates.begin(), candidates.end(), std::make_pair(_colors[vertex], 0U)) -
+			candidates.begin());
+	};
+
+	// Vertices are mapped in BFS order from the rarest colors first, so every choice is checked against mapped
+	// neighbours as early as possible.
+	Vector<Pair<uint32_t, uint32_t>> rarity(vertices);
+	Vector<uint32_t> order;
+	Vector<bool> ordered(vertices, false);
+
+	for (uint32_t i = 0; i < vertices; ++i)
+	{
+		uint32_t first = firstCandidate(i);
+		uint32_t last = first;
+
+		while (last < vertices && candidates[last].first == _colors[i])
+			++last;
+
+		rarity[i] = std::make_pair(last - first, i);
+	}
+
+	std::sort(rarity.begin(), rarity.end());
+
+	for (uint32_t i = 0; i < vertices; ++i)
+	{
+		if (ordered[rarity[i].second])
+			continue;
+
+		ordered[rarity[i].second] = true;
+		order.push_back(rarity[i].second);
+
+		for (uint64_t head = order.size() - 1; head < order.size(); ++head)
+		{
+			uint32_t vertex = order[head];
+
+			for (AdjacencyListConstIterator itr = _graph.GetNeighbours(vertex).begin(); itr != _graph.GetNeighbours(vertex).end(); ++itr)
+				if (!ordered[itr->first])
+				{
+					ordered[itr->first] = true;
+					order.push_back(itr->first);
+				}
+
+			for (uint64_t j = _directed ? _inOffsets[vertex] : 0; j < (_directed ? _inOffsets[vertex + 1] : 0); ++j)
+				if (!ordered[_inArcs[j].first])
+				{
+					ordered[_inArcs[j].first] = true;
+					order.push_back(_inArcs[j].first);
+				}
+		}
+	}
+
+	// Depth-first over the order without recursion: next[depth] is the following candidate to try for order[depth].
+	Vector<uint32_t> forward(vertices, None);
+	Vector<uint32_t> backward(vertices, None);
+	Vector<uint32_t> next(vertices);
+	Vector<Pair<uint32_t, int32_t>> arcs;
+	Vector<Pair<uint32_t, int32_t>> sourceArcs;
+	int64_t depth = 0;
+	uint64_t tried = 0;
+
+	next[0] = firstCandidate(order[0]);
+
+	while (depth >= 0)
+	{
+		if (depth == vertices)
+		{
+			GRAPH_STATS_ADD(VerticesVisited, tried);
+			return true;
+		}
+
+		uint32_t vertex = order[depth];
+		bool mapped = false;
+
+		if (forward[vertex] != None)
+		{
+			backward[forward[vertex]] = None;
+			forward[vertex] = None;
+		}
+
+		while (!mapped && next[depth] < vertices && candidates[next[depth]].first == _colors[vertex])
+		{
+			uint32_t image = candidates[next[depth]++].second;
+
+			if (backward[image] != None)
+				continue;
+
+			++tried;
+			forward[vertex] = image;
+			backward[image] = vertex;
+			mapped = IsConsistent(source, vertex, forward, backward, &arcs, &sourceArcs);
+
+			if (!mapped)
+			{
+				forward[vertex] = None;
+				backward[image] = None;
+			}
+		}
+
+		if (!mapped)
+		{
+			--depth;
+			continue;
+		}
+
+		if (++depth < vertices)
+			next[depth] = firstCandidate(order[depth]);
+	}
+
+	GRAPH_STATS_ADD(VerticesVisited, tried);
+
+	return false;
+}
+
+bool GraphFingerprint::IsConsistent(GraphFingerprint const& source, uint32_t const& vertex, Vector<uint32_t> const& forward,
+	Vector<uint32_t> const& backward, Vector<Pair<uint32_t, int32_t>>* arcs, Vector<Pair<uint32_t, int32_t>>* sourceArcs) const
+{
+	// The arcs of an undirected graph are symmetric, the out arcs cover them.
+	for (uint32_t in = 0; in < (_directed ? 2U : 1U); ++in)
+	{
+		GetMappedArcs(vertex, in != 0, forward, true, arcs);
+		source.GetMappedArcs(forward[vertex], in != 0, backward, false, sourceArcs);
+
+		if (*arcs != *sourceArcs)
+			return false;
+	}
+
+	return true;
+}
+
+void GraphFingerprint::GetMappedArcs(uint32_t const& vertex, bool in, Vector<uint32_t> const& map, bool translate,
+	Vector<Pair<uint32_t, int32_t>>* arcs) const
+{
+	arcs->clear();
+
+	if (in)
+	{
+		for (uint64_t i = _inOffsets[vertex]; i < _inOffsets[vertex + 1]; ++i)
+			if (map[_inArcs[i].first] != None)
+				arcs->push_back(std::make_pair(translate ? map[_inArcs[i].first] : _inArcs[i].first, _inArcs[i].second));
+	}
+	else
+	{
+		for (AdjacencyListConstIterator itr = _graph.GetNeighbours(vertex).begin(); itr != _graph.GetNeighbours(vertex).end(); ++itr)
+			if (map[itr->first] != None)
+				arcs->push_back(std::make_pair(translate ? map[itr->first] : itr->first, itr->second));
+	}
+
+	std::sort(arcs->begin(), arcs->end());
+}
@@ -0,0 +1,75 @@
+#ifndef _GRAPH_FINGERPRINT_H
+#define _GRAPH_FINGERPRINT_H
+
+#include "PCH.h"
+#include "UndirectedGraph.h"
+#include "DirectedGraph.h"
+
+// 128 bits that isomorphic graphs always share, and different graphs share only by a hash collision or when color
+// refinement cannot tell them apart.
+struct Fingerprint
+{
+	uint64_t high;
+	uint64_t low;
+
+	bool operator==(Fingerprint const& source) const { return high == source.high && low == source.low; }
+	bool operator!=(Fingerprint const& source) const { return !((*this) == source); }
+	bool operator<(Fingerprint const& source) const { return high < source.high || (high == source.high && low < source.low); }
+};
+
+// For unordered containers keyed by fingerprint.
+struct FingerprintHasher
+{
+	size_t operator()(Fingerprint const& fingerprint) const { return static_cast<size_t>(fingerprint.low ^ fingerprint.high); }
+};
+
+// Weisfeiler-Lehman color refinement: a vertex starts from its degrees and every round hashes its color with the
+// multiset of its neighbours' colors (and arc weights, and in a directed graph the in and out arcs apart), the vertices
+// of a round in parallel, until a round splits no color class. The fingerprint hashes the sorted final colors, so two
+// fingerprints decide inequality in O(1); IsIsomorphic confirms a match by a backtracking search that only pairs
+// vertices of equal colors. The graph must outlive the fingerprint.
+class GraphFingerprint
+{
+	public:
+		explicit GraphFingerprint(UndirectedGraph const& graph, uint32_t const& threads = 1);
+		explicit GraphFingerprint(DirectedGraph const& graph, uint32_t const& threads = 1);
+
+		Fingerprint const& GetFingerprint() const { return _fingerprint; }
+
+		// The refined color of every vertex, equal for the vertices an isomorphism can swap.
+		Vector<uint64_t> const& GetColors() const { return _colors; }
+		uint32_t GetRounds() const { return _rounds; }
+
+		// Exact, but exponential in the worst case on graphs refinement cannot split, e.g. strongly regular ones. Both
+		// graphs have to be of the same kind.
+		bool IsIsomorphic(GraphFingerprint const& source) const;
+
+	private:
+		static uint32_t const None = UINT32_MAX;
+
+		static uint64_t Mix(uint64_t value);
+
+		void Refine(uint32_t const& threads);
+
+		// Whether mapping vertex to its image keeps the arcs between the mapped vertices, in both directions.
+		bool IsConsistent(GraphFingerprint const& source, uint32_t const& vertex, Vector<uint32_t> const& forward,
+			Vector<uint32_t> const& backward, Vector<Pair<uint32_t, int32_t>>* arcs, Vector<Pair<uint32_t, int32_t>>* sourceArcs) const;
+
+		// The arcs of vertex, or the arcs into it, whose other end is mapped, as (map[end], weight) or with translate
+		// off as (end, weight), sorted.
+		void GetMappedArcs(uint32_t const& vertex, bool in, Vector<uint32_t> const& map, bool translate,
+			Vector<Pair<uint32_t, int32_t>>* arcs) const;
+
+		Graph const& _graph;
+		bool _directed;
+
+		// Arcs into every vertex as (source, weight) in compressed sparse row order, only for a directed graph.
+		Vector<uint64_t> _inOffsets;
+		Vector<Pair<uint32_t, int32_t>> _inArcs;
+
+		Vector<uint64_t> _colors;
+		uint32_t _rounds;
+		Fingerprint _fingerprint;
+};
+
+#endif
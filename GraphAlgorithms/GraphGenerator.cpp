@@ -0,0 +1,454 @@
+#include "PCH.h"
+#include "GraphGenerator.h"
+#include "GraphWriter.h"
+#include "Parallel.h"
+
+RandomEngine::RandomEngine(uint64_t seed)
+{
+	for (uint32_t i = 0; i < 4; ++i)
+	{
+		seed += 0x9E3779B97F4A7C15ULL;
+		_state[i] = Mix(seed);
+	}
+}
+
+uint64_t RandomEngine::Next()
+{
+	uint64_t result = _state[1] * 5;
+	uint64_t shifted = _state[1] << 17;
+
+	result = ((result << 7) | (result >> 57)) * 9;
+
+	_state[2] ^= _state[0];
+	_state[3] ^= _state[1];
+	_state[1] ^= _state[2];
+	_state[0] ^= _state[3];
+	_state[2] ^= shifted;
+	_state[3] = (_state[3] << 45) | (_state[3] >> 19);
+
+	return result;
+}
+
+uint64_t RandomEngine::NextBelow(uint64_t const& bound)
+{
+	// Reject the low values that would make the modulo biased.
+	uint64_t threshold = (0 - bound) % bound;
+	uint64_t value = Next();
+
+	while (value < threshold)
+		value = Next();
+
+	return value % bound;
+}
+
+double RandomEngine::NextDouble()
+{
+	return static_cast<double>(Next() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+uint64_t RandomEngine::Mix(uint64_t value)
+{
+	value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+
+	return value ^ (value >> 31);
+}
+
+void GraphGenerator::SetWeights(int32_t const& minimum, int32_t const& maximum)
+{
+	_minimumWeight = std::min(minimum, maximum);
+	_maximumWeight = std::max(minimum, maximum);
+}
+
+EdgesVector GraphGenerator::GetRMatEdges(uint32_t const& scale, uint32_t const& edgeFactor, double const& a,
+	double const& b, double const& c) const
+{
+	uint64_t edges = static_cast<uint64_t>(edgeFactor) << scale;
+	EdgesVector rMatEdges(edges);
+
+	Parallel::ForDynamic(0, edges, BlockSize, _threads, [&](uint64_t const& first, uint64_t const& last, uint32_t const&)
+		{ GenerateRMatEdges(scale, first, last, a, b, c, rMatEdges.data() + first); });
+
+	return rMatEdges;
+}
+
+EdgesVector GraphGenerator::GetGnpEdges(uint32_t const& vertices, double const& probability, bool directed) const
+{
+	if (vertices < 2 || probability <= 0)
+		return EdgesVector();
+
+	uint32_t const rowsPerChunk = 1024;
+	uint32_t chunks = (vertices + rowsPerChunk - 1) / rowsPerChunk;
+	bool complete = probability >= 1;
+	double logQ = complete ? 0 : std::log1p(-probability);
+	Matrix<Pair<Pair<uint32_t, uint32_t>, int32_t>> chunkEdges(chunks);
+
+	// Every row skips geometrically distributed gaps between its edges, O(V + E) instead of O(V^2) coin flips. log1p
+	// keeps a tiny probability from rounding to a zero logQ, and probability 1 takes every slot without drawing.
+	Parallel::ForDynamic(0, vertices, rowsPerChunk, _threads, [&](uint64_t const& first, uint64_t const& last, uint32_t const&)
+		{
+			EdgesVector& edges = chunkEdges[first / rowsPerChunk];
+
+			for (uint32_t i = static_cast<uint32_t>(first); i < last; ++i)
+			{
+				RandomEngine random(GetSeed(Gnp, i));
+				uint64_t slots = directed ? (vertices - 1) : (vertices - 1 - i);
+
+				for (uint64_t slot = 0; ; ++slot)
+				{
+					if (!complete)
+					{
+						double gap = std::floor(std::log1p(-random.NextDouble()) / logQ);
+
+						if (static_cast<double>(slot) + gap >= slots)
+							break;
+
+						slot += static_cast<uint64_t>(gap);
+					}
+
+					if (slot >= slots)
+						break;
+
+					uint32_t j = static_cast<uint32_t>(directed ? ((slot >= i) ? slot + 1 : slot) : (i + 1 + slot));
+					int32_t weight = IsWeighted() ? _minimumWeight + static_cast<int32_t>(random.NextBelow(
+						static_cast<uint64_t>(_maximumWeight - _minimumWeight) + 1)) : 0;
+
+					edges.push_back(std::make_pair(std::make_pair(i, j), weight));
+				}
+			}
+		});
+
+	EdgesVector gnpEdges;
+	uint64_t size = 0;
+
+	for (uint32_t i = 0; i < chunks; ++i)
+		size += chunkEdges[i].size();
+
+	gnpEdges.reserve(size);
+
+	for (uint32_t i = 0; i < chunks; ++i)
+	{
+		gnpEdges.insert(gnpEdges.end(), chunkEdges[i].begin(), chunkEdges[i].end());
+		EdgesVector().swap(chunkEdges[i]);
+	}
+
+	return gnpEdges;
+}
+
+EdgesVector GraphGenerator::GetGnmEdges(uint32_t const& vertices, uint32_t const& edges, bool directed) const
+{
+	if (vertices < 2)
+		return EdgesVector();
+
+	uint64_t pairs = static_cast<uint64_t>(vertices) * (vertices - 1) / (directed ? 1 : 2);
+	uint64_t target = std::min<uint64_t>(edges, pairs);
+	Vector<uint64_t> keys;
+
+	// Sample the missing edges, drop the duplicates and repeat until exactly target distinct pairs are left.
+	for (uint64_t round = 0; keys.size() < target; ++round)
+	{
+		uint64_t missing = target - keys.size();
+		uint64_t offset = keys.size();
+
+		keys.resize(target);
+
+		Parallel::ForDynamic(0, missing, BlockSize, _threads, [&](uint64_t const& first, uint64_t const& last, uint32_t const&)
+			{
+				RandomEngine random(GetSeed(Gnm, (round << 40) + first / BlockSize));
+
+				for (uint64_t i = first; i < last; ++i)
+				{
+					uint64_t x = random.NextBelow(vertices);
+					uint64_t y = random.NextBelow(vertices - 1);
+
+					if (y >= x)
+						++y;
+
+					if (!directed && y < x)
+						std::swap(x, y);
+
+					keys[offset + i] = x * vertices + y;
+				}
+			});
+
+		std::sort(keys.begin(), keys.end());
+		keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+	}
+
+	EdgesVector gnmEdges(keys.size());
+
+	Parallel::For(0, keys.size(), _threads, [&](uint64_t const& first, uint64_t const& last, uint32_t const&)
+		{
+			for (uint64_t i = first; i < last; ++i)
+				gnmEdges[i] = std::make_pair(std::make_pair(static_cast<uint32_t>(keys[i] / vertices),
+					static_cast<uint32_t>(keys[i] % vertices)), GetWeight(Gnm, keys[i]));
+		});
+
+	return gnmEdges;
+}
+
+EdgesVector GraphGenerator::GetGridEdges(uint32_t const& width, uint32_t const& height, uint32_t const& depth) const
+{
+	uint64_t rows = static_cast<uint64_t>(height) * depth;
+	Vector<uint64_t> rowOffsets(rows + 1, 0);
+
+	if (!width || !rows)
+		return EdgesVector();
+
+	// Every row of the grid owns its +x, +y and +z edges, the prefix sums give each row its slice of the output.
+	for (uint64_t row = 0; row < rows; ++row)
+	{
+		uint64_t y = row % height, z = row / height;
+
+		rowOffsets[row + 1] = rowOffsets[row] + (width - 1) + ((y + 1 < height) ? width : 0) + ((z + 1 < depth) ? width : 0);
+	}
+
+	EdgesVector gridEdges(rowOffsets[rows]);
+
+	Parallel::For(0, rows, _threads, [&](uint64_t const& first, uint64_t const& last, uint32_t const&)
+		{
+			for (uint64_t row = first; row < last; ++row)
+			{
+				uint64_t y = row % height, z = row / height;
+				uint64_t index = rowOffsets[row];
+
+				auto addEdge = [&](uint64_t const& from, uint64_t const& to)
+					{
+						gridEdges[index] = std::make_pair(std::make_pair(static_cast<uint32_t>(from), static_cast<uint32_t>(to)),
+							GetWeight(Grid, index));
+						++index;
+					};
+
+				for (uint64_t x = 0; x < width; ++x)
+				{
+					uint64_t vertex = row * width + x;
+
+					if (x + 1 < width)
+						addEdge(vertex, vertex + 1);
+
+					if (y + 1 < height)
+						addEdge(vertex, vertex + width);
+
+					if (z + 1 < depth)
+						addEdge(vertex, vertex + static_cast<uint64_t>(width) * height);
+				}
+			}
+		});
+
+	return gridEdges;
+}
+
+EdgesVector GraphGenerator::GetRoadEdges(uint32_t const& rows, uint32_t const& columns) const
+{
+	if (!rows || !columns)
+		return EdgesVector();
+
+	Vector<uint64_t> rowOffsets(rows + 1, 0);
+
+	// Stateless per vertex randomness: the jitter and the highway choice only depend on the seed and the vertex.
+	auto getCoordinate = [this](uint64_t const& vertex, uint64_t const& axis, uint64_t const& position)
+		{ return position + (static_cast<double>(RandomEngine::Mix(GetSeed(Road, vertex * 4 + axis)) >> 11) / 9007199254740992.0 - 0.5) * 0.6; };
+	auto hasHighway = [this](uint64_t const& vertex) { return (RandomEngine::Mix(GetSeed(Road, vertex * 4 + 2)) & 15) == 0; };
+	auto getLength = [&](uint64_t const& first, uint64_t const& second, double const& speed)
+		{
+			double dx = getCoordinate(first, 0, first % columns) - getCoordinate(second, 0, second % columns);
+			double dy = getCoordinate(first, 1, first / columns) - getCoordinate(second, 1, second / columns);
+
+			return std::max<int32_t>(1, static_cast<int32_t>(std::sqrt(dx * dx + dy * dy) * 100 / speed));
+		};
+
+	for (uint64_t row = 0; row < rows; ++row)
+	{
+		uint64_t count = (columns - 1) + ((row + 1 < rows) ? columns : 0);
+
+		if (row + 1 < rows)
+			for (uint64_t column = 0; column + 1 < columns; ++column)
+				if (hasHighway(row * columns + column))
+					++count;
+
+		rowOffsets[row + 1] = rowOffsets[row] + count;
+	}
+
+	EdgesVector roadEdges(rowOffsets[rows]);
+
+	Parallel::For(0, rows, _threads, [&](uint64_t const& first, uint64_t const& last, uint32_t const&)
+		{
+			for (uint64_t row = first; row < last; ++row)
+			{
+				uint64_t index = rowOffsets[row];
+
+				for (uint64_t column = 0; column < columns; ++column)
+				{
+					uint64_t vertex = row * columns + column;
+					double speed = 0.5 + RandomEngine::Mix(GetSeed(Road, vertex * 4 + 3)) % 512 / 1024.0;	// Street speed in [0.5, 1).
+
+					if (column + 1 < columns)
+						roadEdges[index++] = std::make_pair(std::make_pair(static_cast<uint32_t>(vertex),
+							static_cast<uint32_t>(vertex + 1)), getLength(vertex, vertex + 1, speed));
+
+					if (row + 1 < rows)
+						roadEdges[index++] = std::make_pair(std::make_pair(static_cast<uint32_t>(vertex),
+							static_cast<uint32_t>(vertex + columns)), getLength(vertex, vertex + columns, speed));
+
+					if (row + 1 < rows && column + 1 < columns && hasHighway(vertex))
+						roadEdges[index++] = std::make_pair(std::make_pair(static_cast<uint32_t>(vertex),
+							static_cast<uint32_t>(vertex + columns + 1)), getLength(vertex, vertex + columns + 1, 2.0));
+				}
+			}
+		});
+
+	return roadEdges;
+}
+
+Tree GraphGenerator::GetRandomTree(uint32_t const& vertices) const
+{
+	if (vertices < 2)
+		return Tree(vertices, EdgesVector());
+
+	RandomEngine random(GetSeed(Pruefer, 0));
+	Vector<uint32_t> sequence(vertices - 2);
+	Vector<uint32_t> degree(vertices, 1);
+	EdgesVector treeEdges;
+
+	for (uint32_t i = 0; i < sequence.size(); ++i)
+	{
+		sequence[i] = static_cast<uint32_t>(random.NextBelow(vertices));
+		++degree[sequence[i]];
+	}
+
+	treeEdges.reserve(vertices - 1);
+
+	// Linear decoding: ptr scans for the smallest leaf, a vertex that becomes a smaller leaf is used right away.
+	uint32_t ptr = 0;
+
+	while (degree[ptr] != 1)
+		++ptr;
+
+	uint32_t leaf = ptr;
+
+	for (uint32_t i = 0; i < sequence.size(); ++i)
+	{
+		uint32_t vertex = sequence[i];
+
+		treeEdges.push_back(std::make_pair(std::make_pair(leaf, vertex), GetWeight(Pruefer, i)));
+
+		if (--degree[vertex] == 1 && vertex < ptr)
+			leaf = vertex;
+		else
+		{
+			++ptr;
+
+			while (degree[ptr] != 1)
+				++ptr;
+
+			leaf = ptr;
+		}
+	}
+
+	treeEdges.push_back(std::make_pair(std::make_pair(leaf, vertices - 1), GetWeight(Pruefer, sequence.size())));
+
+	return Tree(vertices, treeEdges, IsWeighted());
+}
+
+void GraphGenerator::WriteRMatBinary(std::ofstream& ofs, uint32_t const& scale, uint32_t const& edgeFactor, double const& a,
+	double const& b, double const& c) const
+{
+	uint64_t const batchSize = static_cast<uint64_t>(BlockSize) << 6;
+	uint64_t edges = static_cast<uint64_t>(edgeFactor) << scale;
+	EdgesVector batch(static_cast<size_t>(std::min(batchSize, edges)));
+
+	GraphWriter writer(ofs);
+
+	writer.WriteBinaryHeader(static_cast<uint32_t>(1ULL << scale), edges, IsWeighted());
+
+	// Batches are multiples of BlockSize, so the file holds exactly the edges GetRMatEdges would return.
+	for (uint64_t batchFirst = 0; batchFirst < edges; batchFirst += batchSize)
+	{
+		uint64_t batchLast = std::min(edges, batchFirst + batchSize);
+
+		Parallel::ForDynamic(batchFirst, batchLast, BlockSize, _threads, [&](uint64_t const& first, uint64_t const& last, uint32_t const&)
+			{ GenerateRMatEdges(scale, first, last, a, b, c, batch.data() + (first - batchFirst)); });
+
+		writer.WriteBinaryEdges(batch.data(), batchLast - batchFirst, IsWeighted());
+	}
+}
+
+void GraphGenerator::WriteBinary(std::ofstream& ofs, uint32_t const& vertices, EdgesVector const& edges, bool weighted)
+{
+	GraphWriter(ofs).WriteBinary(vertices, edges, weighted);
+}
+
+uint64_t GraphGenerator::GetSeed(Stream const& stream, uint64_t const& index) const
+{
+	return RandomEngine::Mix(RandomEngine::Mix(_seed ^ (static_cast<uint64_t>(stream) << 56)) + index);
+}
+
+int32_t GraphGenerator::GetWeight(Stream const& stream, uint64_t const& index) const
+{
+	if (!IsWeighted())
+		return 0;
+
+	uint64_t range = static_cast<uint64_t>(static_cast<int64_t>(_maximumWeight) - _minimumWeight) + 1;
+
+	return static_cast<int32_t>(_minimumWeight + static_cast<int64_t>(RandomEngine::Mix(GetSeed(stream, index) ^ 0x5A5A5A5AULL) % range));
+}
+
+void GraphGenerator::GenerateRMatEdges(uint32_t const& scale, uint64_t const& first, uint64_t const& last, double const& a,
+	double const& b, double const& c, Pair<Pair<uint32_t, uint32_t>, int32_t>* edges) const
+{
+	// Quadrant thresholds on 32 bit random halves: [0, a) top left, [a, a + b) top right, [a + b, a + b + c) bottom left.
+	uint64_t const unit = 1ULL << 32;
+	uint64_t thresholdA = static_cast<uint64_t>(a * unit);
+	uint64_t thresholdB = static_cast<uint64_t>((a + b) * unit);
+	uint64_t thresholdC = static_cast<uint64_t>((a + b + c) * unit);
+
+	// Bijective scramble of [0, 2^scale): odd multiplications and xor shifts, both invertible modulo 2^scale.
+	uint64_t mask = (scale >= 64) ? ~0ULL : ((1ULL << scale) - 1);
+	uint64_t firstMultiplier = RandomEngine::Mix(GetSeed(Scramble, 0)) | 1;
+	uint64_t secondMultiplier = RandomEngine::Mix(GetSeed(Scramble, 1)) | 1;
+	uint32_t shift = (scale + 1) / 2;
+	auto scramble = [&](uint64_t vertex)
+		{
+			vertex = (vertex * firstMultiplier) & mask;
+
+			if (shift < scale)
+				vertex ^= vertex >> shift;
+
+			vertex = (vertex * secondMultiplier) & mask;
+
+			if (shift < scale)
+				vertex ^= vertex >> shift;
+
+			return static_cast<uint32_t>(vertex);
+		};
+
+	for (uint64_t block = first; block < last; block += BlockSize)
+	{
+		RandomEngine random(GetSeed(RMat, block / BlockSize));
+		uint64_t blockLast = std::min(last, block + BlockSize);
+
+		for (uint64_t i = block; i < blockLast; ++i)
+		{
+			uint64_t x = 0, y = 0;
+
+			// Two levels per 64 bit draw. Branchless quadrant choice: the bottom half is [a + b, 1) and the right half
+			// [a, a + b) together with [a + b + c, 1).
+			for (uint32_t level = 0; level < scale; level += 2)
+			{
+				uint64_t bits = random.Next();
+				uint32_t count = (level + 1 < scale) ? 2 : 1;
+
+				for (uint32_t j = 0; j < count; ++j, bits >>= 32)
+				{
+					uint64_t value = bits & 0xFFFFFFFFULL;
+
+					x = (x << 1) | (value >= thresholdB);
+					y = (y << 1) | ((value >= thresholdA) & (value < thresholdB)) | (value >= thresholdC);
+				}
+			}
+
+			edges[i - first] = std::make_pair(std::make_pair(scramble(x), scramble(y)), GetWeight(RMat, i));
+		}
+	}
+}
+
@@ -0,0 +1,76 @@
+#ifndef _GRAPH_GENERATOR_H
+#define _GRAPH_GENERATOR_H
+
+#include "PCH.h"
+#include "Graph.h"
+#include "Tree.h"
+
+// xoshiro256** seeded through splitmix64. Same sequence on every platform, unlike the std distributions.
+class RandomEngine
+{
+	public:
+		explicit RandomEngine(uint64_t seed);
+
+		uint64_t Next();
+		uint64_t NextBelow(uint64_t const& bound);	// Uniform in [0, bound), bound > 0.
+		double NextDouble();						// Uniform in [0, 1).
+
+		static uint64_t Mix(uint64_t value);		// splitmix64 finalizer, used to derive independent seeds.
+
+	private:
+		uint64_t _state[4];
+};
+
+// Binary edge list: "GAEL" magic, uint32 version, uint32 vertices, uint64 edges, uint32 weighted flag,
+// followed by the edges as uint32 x, uint32 y (and int32 weight when weighted) in host byte order.
+class GraphGenerator
+{
+	public:
+		explicit GraphGenerator(uint64_t const& seed, uint32_t const& threads = 0) : _seed(seed), _threads(threads),
+			_minimumWeight(0), _maximumWeight(0) { }
+
+		// Edges get uniform weights in [minimum, maximum]. The default [0, 0] generates unweighted edges.
+		void SetWeights(int32_t const& minimum, int32_t const& maximum);
+
+		// 2^scale vertices and edgeFactor * 2^scale edges; the defaults are the Graph500 Kronecker parameters.
+		// Vertex ids are scrambled and duplicate edges and self loops are kept, as in Graph500.
+		EdgesVector GetRMatEdges(uint32_t const& scale, uint32_t const& edgeFactor, double const& a = 0.57,
+			double const& b = 0.19, double const& c = 0.19) const;
+
+		EdgesVector GetGnpEdges(uint32_t const& vertices, double const& probability, bool directed) const;
+		EdgesVector GetGnmEdges(uint32_t const& vertices, uint32_t const& edges, bool directed) const;
+
+		EdgesVector GetGridEdges(uint32_t const& rows, uint32_t const& columns) const { return GetGridEdges(columns, rows, 1); }
+		EdgesVector GetGridEdges(uint32_t const& width, uint32_t const& height, uint32_t const& depth) const;
+
+		// Jittered grid weighted by euclidean length, with slower streets and occasional diagonal highways.
+		EdgesVector GetRoadEdges(uint32_t const& rows, uint32_t const& columns) const;
+
+		// Uniformly random labeled tree decoded from a random Pruefer sequence.
+		Tree GetRandomTree(uint32_t const& vertices) const;
+
+		// Streams an R-MAT graph to disk in bounded memory, for sizes that do not fit an in-memory graph.
+		void WriteRMatBinary(std::ofstream& ofs, uint32_t const& scale, uint32_t const& edgeFactor, double const& a = 0.57,
+			double const& b = 0.19, double const& c = 0.19) const;
+
+		static void WriteBinary(std::ofstream& ofs, uint32_t const& vertices, EdgesVector const& edges, bool weighted);
+
+	private:
+		enum Stream : uint64_t { RMat = 1, Gnp, Gnm, Grid, Road, Pruefer, Scramble };
+
+		static uint32_t const BlockSize = 1 << 16;	// Edges generated from one seed, keeps the output independent of the thread count.
+
+		uint64_t GetSeed(Stream const& stream, uint64_t const& index) const;
+		int32_t GetWeight(Stream const& stream, uint64_t const& index) const;
+		bool IsWeighted() const { return _minimumWeight != 0 || _maximumWeight != 0; }
+
+		void GenerateRMatEdges(uint32_t const& scale, uint64_t const& first, uint64_t const& last, double const& a,
+			double const& b, double const& c, Pair<Pair<uint32_t, uint32_t>, int32_t>* edges) const;
+
+		uint64_t _seed;
+		uint32_t _threads;
+		int32_t _minimumWeight, _maximumWeight;
+};
+
+#endif
+
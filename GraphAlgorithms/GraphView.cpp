@@ -0,0 +1,40 @@
+#include "PCH.h"
+#include "GraphView.h"
+#include "Traversal.h"
+
+uint32_t GraphView::GetDegree(uint32_t const& vertex) const
+{
+	uint32_t degree = 0;
+
+	if (HasVertex(vertex))
+		ForEachNeighbour(vertex, [&](uint32_t const&, int32_t const&) { ++degree; });
+
+	return degree;
+}
+
+Vector<uint32_t> GraphView::BreadthFirstSearch(uint32_t const& vertex) const
+{
+	TraversalWorkspace workspace;
+
+	return BreadthFirstSearch(vertex, &workspace);
+}
+
+Vector<uint32_t> const& GraphView::BreadthFirstSearch(uint32_t const& vertex, TraversalWorkspace* workspace) const
+{
+	return Traversal::BreadthFirstSearch(*this, vertex, UINT32_MAX, workspace);
+}
+
+Vector<uint32_t> const& GraphView::DepthFirstSearch(uint32_t const& vertex, TraversalWorkspace* workspace) const
+{
+	return Traversal::DepthFirstSearch(*this, vertex, workspace);
+}
+
+void GraphView::GetConnectedComponents(ComponentLabels* components) const
+{
+	Traversal::GetConnectedComponents(*this, components);
+}
+
+void GraphView::GetStronglyConnectedComponents(ComponentLabels* components) const
+{
+	Traversal::GetStronglyConnectedComponents(*this, components);
+}
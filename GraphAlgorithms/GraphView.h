@@ -0,0 +1,83 @@
+#ifndef _GRAPH_VIEW_H
+#define _GRAPH_VIEW_H
+
+#include "PCH.h"
+#include "Graph.h"
+#include "ComponentLabels.h"
+#include "TraversalWorkspace.h"
+
+// Filtered view of a graph that copies nothing: the vertices pass the mask and the vertex filter, the arcs pass the
+// weight range and the arc filter and join two vertices that pass. Vertex ids are those of the graph and the removed
+// vertices still count in GetVertices, so per-vertex results line up with the graph's. The graph must outlive the
+// view and stay unchanged while it is used.
+class GraphView
+{
+	public:
+		using VertexFilter = std::function<bool(uint32_t const&)>;
+		using ArcFilter = std::function<bool(uint32_t const& source, uint32_t const& target, int32_t const& weight)>;
+
+		explicit GraphView(Graph const& graph) : _graph(graph), _minimumWeight(INT32_MIN), _maximumWeight(INT32_MAX) { }
+
+		// Keeps vertex v when mask[v] is set; an empty mask keeps every vertex.
+		GraphView& SetVertexMask(Vector<bool> const& mask) { _mask = mask; return *this; }
+		GraphView& SetVertexFilter(VertexFilter const& filter) { _vertexFilter = filter; return *this; }
+
+		// Keeps the arcs with a weight in [minimum, maximum].
+		GraphView& SetWeightRange(int32_t const& minimum, int32_t const& maximum)
+		{
+			_minimumWeight = minimum;
+			_maximumWeight = maximum;
+
+			return *this;
+		}
+
+		GraphView& SetArcFilter(ArcFilter const& filter) { _arcFilter = filter; return *this; }
+
+		Graph const& GetGraph() const { return _graph; }
+		uint32_t GetVertices() const { return _graph.GetVertices(); }
+
+		bool HasVertex(uint32_t const& vertex) const
+		{
+			return vertex < _graph.GetVertices() && (_mask.empty() || _mask[vertex]) && (!_vertexFilter || _vertexFilter(vertex));
+		}
+
+		// Whether the arc from source, which must be kept, to arc.first is in the view.
+		bool HasArc(uint32_t const& source, Pair<uint32_t, int32_t> const& arc) const
+		{
+			return arc.second >= _minimumWeight && arc.second <= _maximumWeight && HasVertex(arc.first) &&
+				(!_arcFilter || _arcFilter(source, arc.first, arc.second));
+		}
+
+		// The stored arcs of vertex, HasArc tells which of them are in the view.
+		Vector<Pair<uint32_t, int32_t>> const& GetArcs(uint32_t const& vertex) const { return _graph.GetNeighbours(vertex); }
+
+		// Calls function(target, weight) for the arcs of a kept vertex that are in the view.
+		template <class _Function>
+		void ForEachNeighbour(uint32_t const& vertex, _Function const& function) const
+		{
+			for (AdjacencyListConstIterator itr = GetArcs(vertex).begin(); itr != GetArcs(vertex).end(); ++itr)
+				if (HasArc(vertex, *itr))
+					function(itr->first, itr->second);
+		}
+
+		uint32_t GetDegree(uint32_t const& vertex) const;
+
+		// The Graph traversals restricted to the view, nothing when vertex is not kept.
+		Vector<uint32_t> BreadthFirstSearch(uint32_t const& vertex) const;
+		Vector<uint32_t> const& BreadthFirstSearch(uint32_t const& vertex, TraversalWorkspace* workspace) const;
+		Vector<uint32_t> const& DepthFirstSearch(uint32_t const& vertex, TraversalWorkspace* workspace) const;
+
+		// The removed vertices get ComponentLabels::None. Connected components expect a view of an undirected graph.
+		void GetConnectedComponents(ComponentLabels* components) const;
+		void GetStronglyConnectedComponents(ComponentLabels* components) const;
+
+	private:
+		Graph const& _graph;
+		Vector<bool> _mask;
+		VertexFilter _vertexFilter;
+		int32_t _minimumWeight;
+		int32_t _maximumWeight;
+		ArcFilter _arcFilter;
+};
+
+#endif
@@ -0,0 +1,194 @@
+#include "PCH.h"
+#include "GraphWriter.h"
+
+GraphWriter::GraphWriter(std::ostream& os, uint32_t const& bufferSize) : _stream(os), _buffer(std::max<uint32_t>(bufferSize, 64)),
+	_size(0)
+{
+}
+
+void GraphWriter::WriteAdjacency(Graph const& graph)
+{
+	for (uint32_t i = 0; i < graph.GetVertices(); ++i)
+	{
+		WriteUnsigned(i);
+		Write(" | ", 3);
+
+		for (AdjacencyListConstIterator itr = graph.GetNeighbours(i).begin(); itr != graph.GetNeighbours(i).end(); ++itr)
+		{
+			WriteUnsigned(itr->first);
+
+			if (graph.IsWeighted())
+			{
+				Write(" - ", 3);
+				WriteSigned(itr->second);
+			}
+
+			Write(", ", 2);
+		}
+
+		Put('\n');
+	}
+}
+
+void GraphWriter::WriteBinary(uint32_t const& vertices, EdgesVector const& edges, bool weighted)
+{
+	WriteBinaryHeader(vertices, edges.size(), weighted);
+	WriteBinaryEdges(edges.data(), edges.size(), weighted);
+}
+
+void GraphWriter::WriteBinaryHeader(uint32_t const& vertices, uint64_t const& edges, bool weighted)
+{
+	uint32_t const version = 1;
+	uint32_t weightedFlag = weighted ? 1 : 0;
+
+	Write("GAEL", 4);
+	WriteBinaryValue(version);
+	WriteBinaryValue(vertices);
+	Write(reinterpret_cast<char const*>(&edges), sizeof(edges));
+	WriteBinaryValue(weightedFlag);
+}
+
+void GraphWriter::WriteBinaryEdges(Pair<Pair<uint32_t, uint32_t>, int32_t> const* edges, uint64_t const& count, bool weighted)
+{
+	for (uint64_t i = 0; i < count; ++i)
+	{
+		WriteBinaryValue(edges[i].first.first);
+		WriteBinaryValue(edges[i].first.second);
+
+		if (weighted)
+			WriteBinaryValue(static_cast<uint32_t>(edges[i].second));
+	}
+}
+
+void GraphWriter::WriteComponents(ComponentLabels const& components)
+{
+	for (uint32_t i = 0; i < components.GetVertices(); ++i)
+	{
+		WriteUnsigned(i);
+		Put(' ');
+
+		if (components.GetComponent(i) == ComponentLabels::None)
+			Write("-1", 2);
+		else
+			WriteUnsigned(components.GetComponent(i));
+
+		Put('\n');
+	}
+}
+
+void GraphWriter::WriteUnsigned(uint64_t value)
+{
+	char digits[20];
+	uint32_t count = 0;
+
+	do
+	{
+		digits[count++] = static_cast<char>('0' + value % 10);
+		value /= 10;
+	} while (value);
+
+	if (_buffer.size() - _size < count)
+		Flush();
+
+	while (count)
+		_buffer[_size++] = digits[--count];
+}
+
+void GraphWriter::WriteSigned(int64_t const& value)
+{
+	if (value < 0)
+	{
+		Put('-');
+		WriteUnsigned(0 - static_cast<uint64_t>(value));		// Also right for INT64_MIN.
+	}
+	else
+		WriteUnsigned(static_cast<uint64_t>(value));
+}
+
+void GraphWriter::Write(char const* data, uint64_t const& size)
+{
+	if (_buffer.size() - _size < size)
+	{
+		Flush();
+
+		// Too large to be worth copying.
+		if (size >= _buffer.size())
+		{
+			_stream.write(data, static_cast<std::streamsize>(size));
+			return;
+		}
+	}
+
+	std::copy(data, data + size, _buffer.data() + _size);
+	_size += static_cast<uint32_t>(size);
+}
+
+void GraphWriter::Flush()
+{
+	if (!_size)
+		return;
+
+	_stream.write(_buffer.data(), _size);
+	_size = 0;
+}
+
+template <class _Function>
+void GraphWriter::ForEachEdge(Graph const& graph, bool directed, _Function const& function)
+{
+	for (uint32_t i = 0; i < graph.GetVertices(); ++i)
+	{
+		uint32_t selfLoops = 0;
+
+		// An undirected self loop is stored twice, next to each other, so every second copy is skipped.
+		for (AdjacencyListConstIterator itr = graph.GetNeighbours(i).begin(); itr != graph.GetNeighbours(i).end(); ++itr)
+			if (directed || i < itr->first || (i == itr->first && (selfLoops++ & 1) == 0))
+				function(i, itr->first, itr->second);
+	}
+}
+
+void GraphWriter::WriteEdgeList(Graph const& graph, bool directed)
+{
+	uint64_t edges = 0;
+
+	ForEachEdge(graph, directed, [&](uint32_t const&, uint32_t const&, int32_t const&) { ++edges; });
+
+	WriteUnsigned(graph.GetVertices());
+	Put(' ');
+	WriteUnsigned(edges);
+	Put(' ');
+	Put(graph.IsWeighted() ? '1' : '0');
+	Put('\n');
+
+	ForEachEdge(graph, directed, [&](uint32_t const& x, uint32_t const& y, int32_t const& weight)
+	{
+		WriteUnsigned(x);
+		Put(' ');
+		WriteUnsigned(y);
+
+		if (graph.IsWeighted())
+		{
+			Put(' ');
+			WriteSigned(weight);
+		}
+
+		Put('\n');
+	});
+}
+
+void GraphWriter::WriteBinary(Graph const& graph, bool directed)
+{
+	uint64_t edges = 0;
+
+	ForEachEdge(graph, directed, [&](uint32_t const&, uint32_t const&, int32_t const&) { ++edges; });
+
+	WriteBinaryHeader(graph.GetVertices(), edges, graph.IsWeighted());
+
+	ForEachEdge(graph, directed, [&](uint32_t const& x, uint32_t const& y, int32_t const& weight)
+	{
+		WriteBinaryValue(x);
+		WriteBinaryValue(y);
+
+		if (graph.IsWeighted())
+			WriteBinaryValue(static_cast<uint32_t>(weight));
+	});
+}
@@ -0,0 +1,90 @@
+#ifndef _GRAPH_WRITER_H
+#define _GRAPH_WRITER_H
+
+#include "PCH.h"
+#include "UndirectedGraph.h"
+#include "DirectedGraph.h"
+#include "ComponentLabels.h"
+
+// Buffered export of graphs and per-vertex results. Numbers are formatted by hand into one large block that goes to
+// the stream in a single write when full, so there is no per-token stream overhead. The block is flushed on
+// destruction.
+//
+// Formats:
+//   Adjacency: the operator<< text, "v | n, n, ..." or "v | n - w, ..." per vertex.
+//   EdgeList:  "vertices edges weighted" then one "x y" or "x y w" line per edge, as operator>> reads it back.
+//   Binary:    the GraphGenerator "GAEL" edge list.
+class GraphWriter
+{
+	public:
+		explicit GraphWriter(std::ostream& os, uint32_t const& bufferSize = 1 << 20);
+		~GraphWriter() { Flush(); }
+
+		void WriteAdjacency(Graph const& graph);
+
+		// An undirected edge is written once, from its smaller endpoint.
+		void WriteEdgeList(UndirectedGraph const& graph) { WriteEdgeList(graph, false); }
+		void WriteEdgeList(DirectedGraph const& graph) { WriteEdgeList(graph, true); }
+
+		void WriteBinary(UndirectedGraph const& graph) { WriteBinary(graph, false); }
+		void WriteBinary(DirectedGraph const& graph) { WriteBinary(graph, true); }
+		void WriteBinary(uint32_t const& vertices, EdgesVector const& edges, bool weighted);
+
+		// The pieces of the binary format, for writers that stream the edges in batches.
+		void WriteBinaryHeader(uint32_t const& vertices, uint64_t const& edges, bool weighted);
+		void WriteBinaryEdges(Pair<Pair<uint32_t, uint32_t>, int32_t> const* edges, uint64_t const& count, bool weighted);
+
+		// One "vertex value" line per vertex, e.g. distances or parents.
+		template <class _Type>
+		void WriteValues(Vector<_Type> const& values)
+		{
+			for (uint64_t i = 0; i < values.size(); ++i)
+			{
+				WriteUnsigned(i);
+				Put(' ');
+
+				if (std::is_signed<_Type>::value)
+					WriteSigned(static_cast<int64_t>(values[i]));
+				else
+					WriteUnsigned(static_cast<uint64_t>(values[i]));
+
+				Put('\n');
+			}
+		}
+
+		// One "vertex component" line per vertex, -1 for a vertex outside every component.
+		void WriteComponents(ComponentLabels const& components);
+
+		void WriteUnsigned(uint64_t value);
+		void WriteSigned(int64_t const& value);
+		void Write(char const* data, uint64_t const& size);
+
+		void Put(char const& character)
+		{
+			if (_size == _buffer.size())
+				Flush();
+
+			_buffer[_size++] = character;
+		}
+
+		void Flush();
+		bool IsGood() const { return _stream.good(); }
+
+	private:
+		GraphWriter(GraphWriter const&);
+		GraphWriter& operator=(GraphWriter const&);
+
+		// Calls function(x, y, weight) once per edge, undirected edges from their smaller endpoint.
+		template <class _Function>
+		static void ForEachEdge(Graph const& graph, bool directed, _Function const& function);
+
+		void WriteEdgeList(Graph const& graph, bool directed);
+		void WriteBinary(Graph const& graph, bool directed);
+		void WriteBinaryValue(uint32_t const& value) { Write(reinterpret_cast<char const*>(&value), sizeof(value)); }
+
+		std::ostream& _stream;
+		Vector<char> _buffer;
+		uint32_t _size;
+};
+
+#endif
@@ -0,0 +1,359 @@
+#include "PCH.h"
+#include "HamiltonianCycle.h"
+#include "Instrumentation.h"
+#include "Parallel.h"
+
+uint32_t const HamiltonianCycle::MaximumVertices;
+uint32_t const HamiltonianCycle::MaximumTourVertices;
+int64_t const HamiltonianCycle::Infinity;
+
+HamiltonianCycle::HamiltonianCycle(UndirectedGraph const& graph, uint32_t const& threads, RunControl* control) :
+	_vertices(graph.GetVertices()), _threads(threads), _control(control), _layer(0), _layers(0),
+	_weighted(graph.IsWeighted()), _exact(false), _optimal(false), _cost(0)
+{
+	GRAPH_STATS_COLLECTOR();
+
+	if (_vertices > MaximumVertices)
+		return;
+
+	_exact = true;
+
+	if (_vertices < 3)
+		return;
+
+	_adjacency.assign(_vertices, 0);
+	_weights.assign(_vertices * _vertices, Infinity);
+
+	for (uint32_t i = 0; i < _vertices; ++i)
+		for (AdjacencyListConstIterator itr = graph.GetNeighbours(i).begin(); itr != graph.GetNeighbours(i).end(); ++itr)
+			if (itr->first != i)
+			{
+				_adjacency[i] |= 1U << itr->first;
+				_weights[i * _vertices + itr->first] = std::min<int64_t>(GetWeight(i, itr->first), _weighted ? itr->second : 1);
+			}
+
+	{
+		GRAPH_STATS_PHASE("hamiltonian_filters");
+
+		if (HasNoCycle())
+			return;
+
+		FindByDegrees();
+	}
+
+	if (!HasCycle())
+	{
+		GRAPH_STATS_PHASE("hamiltonian_feasibility");
+
+		_layers = _vertices - 1;
+		FindFeasible();
+	}
+
+	_optimal = HasCycle() && !_weighted;
+
+	if (_control)
+		_control->Complete(_layers);
+}
+
+bool HamiltonianCycle::HasNoCycle() const
+{
+	uint32_t reached = 1;
+	uint32_t frontier = 1;
+
+	for (uint32_t i = 0; i < _vertices; ++i)
+		if (!(_adjacency[i] & (_adjacency[i] - 1)))
+			return true;
+
+	while (frontier)
+	{
+		uint32_t next = 0;
+
+		for (uint32_t i = 0; i < _vertices; ++i)
+			if ((frontier >> i) & 1)
+				next |= _adjacency[i];
+
+		frontier = next & ~reached;
+		reached |= next;
+	}
+
+	return reached != (1U << _vertices) - 1;
+}
+
+bool HamiltonianCycle::FindByDegrees()
+{
+	Vector<uint32_t> degrees(_vertices, 0);
+
+	for (uint32_t i = 0; i < _vertices; ++i)
+		for (uint32_t j = 0; j < _vertices; ++j)
+			degrees[i] += IsAdjacent(i, j);
+
+	// Ore: deg(x) + deg(y) >= V for every non adjacent pair.
+	for (uint32_t i = 0; i < _vertices; ++i)
+		for (uint32_t j = i + 1; j < _vertices; ++j)
+			if (!IsAdjacent(i, j) && degrees[i] + degrees[j] < _vertices)
+				return false;
+
+	// Palmer: while the cyclic order has a gap (a, b), rotate it to the ends as b ... a and reverse the prefix up to a
+	// j with a ~ order[j] and b ~ order[j + 1]; Ore's condition makes such a j exist and every reversal closes a gap.
+	Vector<uint32_t> order(_vertices);
+
+	for (uint32_t i = 0; i < _vertices; ++i)
+		order[i] = i;
+
+	while (true)
+	{
+		uint32_t gap = _vertices;
+
+		for (uint32_t i = 0; i < _vertices && gap == _vertices; ++i)
+			if (!IsAdjacent(order[i], order[(i + 1) % _vertices]))
+				gap = i;
+
+		if (gap == _vertices)
+			break;
+
+		std::rotate(order.begin(), order.begin() + (gap + 1) % _vertices, order.end());
+
+		uint32_t j = 0;
+
+		while (!IsAdjacent(order[_vertices - 1], order[j]) || !IsAdjacent(order[0], order[j + 1]))
+			++j;
+
+		std::reverse(order.begin(), order.begin() + j + 1);
+	}
+
+	SetCycle(order);
+
+	return true;
+}
+
+template <class _Function>
+bool HamiltonianCycle::ForEachSubset(uint32_t const& size, _Function const& function)
+{
+	uint32_t const bits = _vertices - 1;
+	Matrix<uint64_t> binomials(bits + 1, Vector<uint64_t>(size + 1, 0));
+
+	for (uint32_t n = 0; n <= bits; ++n)
+		for (uint32_t k = 0; k <= std::min(n, size); ++k)
+			binomials[n][k] = (k == 0 || k == n) ? 1 : binomials[n - 1][k - 1] + binomials[n - 1][k];
+
+	std::atomic<bool> stopped(false);
+	uint64_t layer = _layer++;
+
+	// The r-th subset in increasing order by the combinatorial number system, then the next ones by Gosper's hack.
+	Parallel::ForDynamic(0, binomials[bits][size], 1 << 14, _threads, [&](uint64_t const& first, uint64_t const& last, uint32_t const&)
+	{
+		if (stopped || (_control && !_control->Poll(layer, _layers)))
+		{
+			stopped = true;
+			return;
+		}
+
+		uint32_t subset = 0;
+		uint64_t rank = first;
+
+		for (uint32_t bit = bits, k = size; bit-- > 0 && k;)
+			if (binomials[bit][k] <= rank)
+			{
+				rank -= binomials[bit][k];
+				subset |= 1U << bit;
+				--k;
+			}
+
+		for (uint64_t i = first; i < last; ++i)
+		{
+			function(subset);
+
+			uint32_t lowest = subset & (0 - subset);
+			uint32_t carried = subset + lowest;
+
+			subset = (((carried ^ subset) >> 2) / lowest) | carried;
+		}
+	});
+
+	return !stopped;
+}
+
+bool HamiltonianCycle::FindFeasible()
+{
+	GRAPH_STATS_COLLECTOR();
+
+	// ends[s] holds bit v - 1 when a path from 0 through exactly the vertices of s can end at v.
+	uint32_t const bits = _vertices - 1;
+	Vector<uint32_t> ends(static_cast<size_t>(1) << bits, 0);
+	Vector<uint32_t> rows(_vertices);
+
+	for (uint32_t i = 0; i < _vertices; ++i)
+		rows[i] = _adjacency[i] >> 1;
+
+	for (uint32_t size = 1; size <= bits; ++size)
+		if (!ForEachSubset(size, [&](uint32_t const& subset)
+			{
+				uint32_t found = 0;
+
+				for (uint32_t v = 0; v < bits; ++v)
+					if ((subset >> v) & 1)
+					{
+						uint32_t rest = subset & ~(1U << v);
+
+						if (rest ? (ends[rest] & rows[v + 1]) != 0 : IsAdjacent(0, v + 1))
+							found |= 1U << v;
+					}
+
+				ends[subset] = found;
+			}))
+		{
+			_exact = false;
+			return false;
+		}
+
+	GRAPH_STATS_ADD(VerticesVisited, ends.size());
+
+	uint32_t subset = (1U << bits) - 1;
+
+	if (!(ends[subset] & rows[0]))
+		return false;
+
+	// Walks the table back from an end next to 0.
+	Vector<uint32_t> cycle(_vertices, 0);
+	uint32_t end = 0;
+
+	while (!(((ends[subset] & rows[0]) >> end) & 1))
+		++end;
+
+	for (uint32_t position = bits; position > 0; --position)
+	{
+		cycle[position] = end + 1;
+		subset &= ~(1U << end);
+
+		if (!subset)
+			break;
+
+		uint32_t previous = 0;
+
+		while (!(((ends[subset] & rows[end + 1]) >> previous) & 1))
+			++previous;
+
+		end = previous;
+	}
+
+	SetCycle(cycle);
+
+	return true;
+}
+
+bool HamiltonianCycle::FindOptimal()
+{
+	if (_optimal || !HasCycle() || _vertices > MaximumTourVertices)
+		return _optimal;
+
+	GRAPH_STATS_COLLECTOR();
+	GRAPH_STATS_PHASE("hamiltonian_tour");
+
+	// costs[s * (V - 1) + v - 1] is the cheapest path from 0 through exactly s that ends at v. A state is dropped when
+	// even the cheapest edge into every vertex still to enter, 0 included, takes it over the best known tour.
+	uint32_t const bits = _vertices - 1;
+	Vector<int64_t> costs((static_cast<size_t>(1) << bits) * bits, Infinity);
+	Vector<int64_t> cheapest(_vertices, Infinity);
+	int64_t upper = _cost;
+	int64_t bound = 0;
+
+	_layer = 0;
+	_layers = bits;
+
+	for (uint32_t i = 0; i < _vertices; ++i)
+	{
+		for (uint32_t j = 0; j < _vertices; ++j)
+			cheapest[i] = std::min(cheapest[i], GetWeight(i, j));
+
+		bound += cheapest[i];
+	}
+
+	for (uint32_t size = 1; size <= bits; ++size)
+		if (!ForEachSubset(size, [&](uint32_t const& subset)
+			{
+				int64_t remaining = bound;
+
+				for (uint32_t v = 0; v < bits; ++v)
+					if ((subset >> v) & 1)
+						remaining -= cheapest[v + 1];
+
+				for (uint32_t v = 0; v < bits; ++v)
+				{
+					if (!((subset >> v) & 1))
+						continue;
+
+					uint32_t rest = subset & ~(1U << v);
+					int64_t best = rest ? Infinity : GetWeight(0, v + 1);
+
+					for (uint32_t u = 0; u < bits && rest; ++u)
+						if (((rest >> u) & 1) && costs[rest * bits + u] < Infinity && IsAdjacent(u + 1, v + 1))
+							best = std::min(best, costs[rest * bits + u] + GetWeight(u + 1, v + 1));
+
+					costs[subset * bits + v] = (best < Infinity && best + remaining <= upper) ? best : Infinity;
+				}
+			}))
+		{
+			_exact = false;
+			_cycle.clear();
+			return false;
+		}
+
+	GRAPH_STATS_ADD(VerticesVisited, static_cast<uint64_t>(1) << bits);
+
+	if (_control)
+		_control->Complete(_layers);
+
+	uint32_t subset = (1U << bits) - 1;
+	uint32_t end = bits;
+	int64_t best = Infinity;
+
+	for (uint32_t v = 0; v < bits; ++v)
+		if (costs[subset * bits + v] < Infinity && IsAdjacent(v + 1, 0) && costs[subset * bits + v] + GetWeight(v + 1, 0) < best)
+		{
+			best = costs[subset * bits + v] + GetWeight(v + 1, 0);
+			end = v;
+		}
+
+	_optimal = true;
+
+	// The known tour is optimal when no state survived the bound.
+	if (end == bits)
+		return true;
+
+	Vector<uint32_t> cycle(_vertices, 0);
+
+	for (uint32_t position = bits; position > 0; --position)
+	{
+		uint32_t rest = subset & ~(1U << end);
+
+		cycle[position] = end + 1;
+
+		if (!rest)
+			break;
+
+		uint32_t previous = 0;
+
+		while (!((rest >> previous) & 1) || costs[rest * bits + previous] == Infinity || !IsAdjacent(previous + 1, end + 1) ||
+			costs[rest * bits + previous] + GetWeight(previous + 1, end + 1) != costs[subset * bits + end])
+			++previous;
+
+		subset = rest;
+		end = previous;
+	}
+
+	SetCycle(cycle);
+
+	return true;
+}
+
+void HamiltonianCycle::SetCycle(Vector<uint32_t> const& cycle)
+{
+	Vector<uint32_t>::const_iterator start = std::find(cycle.begin(), cycle.end(), 0U);
+
+	_cycle.assign(start, cycle.end());
+	_cycle.insert(_cycle.end(), cycle.begin(), start);
+	_cost = 0;
+
+	for (uint32_t i = 0; i < _vertices; ++i)
+		_cost += GetWeight(_cycle[i], _cycle[(i + 1) % _vertices]);
+}
@@ -0,0 +1,75 @@
+#ifndef _HAMILTONIAN_CYCLE_H
+#define _HAMILTONIAN_CYCLE_H
+
+#include "PCH.h"
+#include "UndirectedGraph.h"
+#include "RunControl.h"
+
+// Exact Hamiltonian cycle search and optimal tours for small graphs. Cheap tests run first: a vertex with fewer than
+// two neighbours or a disconnected graph has no cycle, and Ore's condition (which Dirac's implies) gives one at once by
+// Palmer's construction. The rest is Held-Karp over the subsets holding vertex 0: the feasibility table keeps the
+// possible path ends of every subset as a bitset, one AND with a bitset adjacency row per end. The constructor stops
+// at any cycle; FindOptimal then fills the weighted table, which prunes the states whose cost plus a completion bound
+// exceeds that cycle. Both fill one subset size at a time with the subsets of a layer shared among the threads.
+// Parallel edges count with their smallest weight, self loops are ignored.
+class HamiltonianCycle
+{
+	public:
+		static uint32_t const MaximumVertices = 30;			// The feasibility table takes 4 * 2^(V - 1) bytes.
+		static uint32_t const MaximumTourVertices = 20;		// The cost table takes 8 * (V - 1) * 2^(V - 1) bytes.
+
+		explicit HamiltonianCycle(UndirectedGraph const& graph, uint32_t const& threads = 0, RunControl* control = nullptr);
+
+		// False when the graph has more than MaximumVertices vertices or the run was stopped, then no cycle is given.
+		bool IsExact() const { return _exact; }
+
+		bool HasCycle() const { return !_cycle.empty(); }
+
+		// Whether the cycle has the smallest cost. Every cycle is optimal on an unweighted graph, on a weighted one only
+		// after FindOptimal.
+		bool IsOptimal() const { return _optimal; }
+
+		// Replaces the cycle of a weighted graph with the cheapest one, up to MaximumTourVertices vertices; the tour is
+		// only searched on the first call. Returns IsOptimal, a stopped run clears the cycle as the constructor does.
+		bool FindOptimal();
+
+		// Every vertex once, starting from 0; the cycle closes back to 0.
+		Vector<uint32_t> const& GetCycle() const { return _cycle; }
+
+		// The sum of the weights of the cycle, its length on an unweighted graph.
+		int64_t GetCost() const { return _cost; }
+
+	private:
+		static int64_t const Infinity = INT64_MAX / 4;
+
+		bool IsAdjacent(uint32_t const& x, uint32_t const& y) const { return ((_adjacency[x] >> y) & 1) != 0; }
+		int64_t GetWeight(uint32_t const& x, uint32_t const& y) const { return _weights[x * _vertices + y]; }
+
+		bool HasNoCycle() const;
+		bool FindByDegrees();
+		bool FindFeasible();
+
+		void SetCycle(Vector<uint32_t> const& cycle);
+
+		// Calls function(subset) for every subset of the vertices 1..V-1, as bits 0..V-2, with size elements; the
+		// subsets go to the threads in chunks. False once the run has to stop.
+		template <class _Function>
+		bool ForEachSubset(uint32_t const& size, _Function const& function);
+
+		uint32_t _vertices;
+		uint32_t _threads;
+		RunControl* _control;
+		uint64_t _layer;
+		uint64_t _layers;
+
+		bool _weighted;
+		Vector<uint32_t> _adjacency;		// Bit y of row x is set when x and y are adjacent.
+		Vector<int64_t> _weights;
+
+		bool _exact;
+		bool _optimal;
+		Vector<uint32_t> _cycle;
+		int64_t _cost;
+};
+
+#endif
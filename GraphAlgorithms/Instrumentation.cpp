@@ -0,0 +1,85 @@
+#include "PCH.h"
+#include "Instrumentation.h"
+
+thread_local AlgorithmStats* AlgorithmStats::_current = nullptr;
+
+void AlgorithmStats::Reset()
+{
+	for (uint32_t i = 0; i < Counters; ++i)
+		_counters[i] = 0;
+
+	_recursionDepth = 0;
+	_phases.clear();
+}
+
+void AlgorithmStats::EnterRecursion()
+{
+	if (++_recursionDepth > _counters[MaxRecursionDepth])
+		_counters[MaxRecursionDepth] = _recursionDepth;
+}
+
+void AlgorithmStats::AddPhase(char const* name, uint64_t const& nanoseconds)
+{
+	for (uint32_t i = 0; i < _phases.size(); ++i)
+		if (_phases[i].first == name)
+		{
+			_phases[i].second += nanoseconds;
+			return;
+		}
+
+	_phases.push_back(std::make_pair(std::string(name), nanoseconds));
+}
+
+void AlgorithmStats::Merge(AlgorithmStats const& source)
+{
+	for (uint32_t i = 0; i < Counters; ++i)
+		if (i == MaxRecursionDepth)
+			_counters[i] = std::max(_counters[i], source._counters[i]);
+		else
+			_counters[i] += source._counters[i];
+
+	for (uint32_t i = 0; i < source._phases.size(); ++i)
+		AddPhase(source._phases[i].first.c_str(), source._phases[i].second);
+}
+
+void AlgorithmStats::WriteJson(std::ostream& os) const
+{
+	os << "{ ";
+
+	for (uint32_t i = 0; i < Counters; ++i)
+		os << "\"" << GetCounterName(static_cast<Counter>(i)) << "\": " << _counters[i] << ", ";
+
+	os << "\"phases_ns\": { ";
+
+	for (uint32_t i = 0; i < _phases.size(); ++i)
+		os << ((i != 0) ? ", " : "") << "\"" << _phases[i].first << "\": " << _phases[i].second;
+
+	os << " } }";
+}
+
+char const* AlgorithmStats::GetCounterName(Counter const& counter)
+{
+	switch (counter)
+	{
+		case VerticesVisited: return "vertices_visited";
+		case EdgesScanned: return "edges_scanned";
+		case EdgesRelaxed: return "edges_relaxed";
+		case HeapPushes: return "heap_pushes";
+		case HeapPops: return "heap_pops";
+		case StaleHeapPops: return "stale_heap_pops";
+		case MaxRecursionDepth: return "max_recursion_depth";
+		case UnionFindFinds: return "union_find_finds";
+		case UnionFindPathLength: return "union_find_path_length";
+		case UnionFindUnions: return "union_find_unions";
+		case BytesAllocated: return "bytes_allocated";
+		default: return "unknown";
+	}
+}
+
+PhaseTimer::~PhaseTimer()
+{
+	if (_stats)
+		_stats->AddPhase(_name, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now() - _start).count()));
+}
+
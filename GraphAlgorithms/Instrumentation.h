@@ -0,0 +1,113 @@
+#ifndef _INSTRUMENTATION_H
+#define _INSTRUMENTATION_H
+
+#include "PCH.h"
+
+#include <chrono>
+#include <string>
+
+// Counters filled in by the traversal, shortest path, Tarjan, union-find and Kruskal kernels for the calls made on a
+// thread while an AlgorithmStatsScope is alive. The kernels only record anything when the library is compiled with
+// GRAPH_ALGORITHMS_INSTRUMENTATION, otherwise the GRAPH_STATS_* macros expand to nothing.
+class AlgorithmStats
+{
+	public:
+		enum Counter
+		{
+			VerticesVisited,
+			EdgesScanned,
+			EdgesRelaxed,
+			HeapPushes,
+			HeapPops,
+			StaleHeapPops,			// Pops of vertices that were already settled (lazy deletion).
+			MaxRecursionDepth,
+			UnionFindFinds,
+			UnionFindPathLength,	// Parent links followed by all the finds.
+			UnionFindUnions,
+			BytesAllocated,			// Scratch and result arrays allocated by the kernels.
+			Counters
+		};
+
+		AlgorithmStats() { Reset(); }
+
+		void Reset();
+
+		uint64_t Get(Counter const& counter) const { return _counters[counter]; }
+		void Add(Counter const& counter, uint64_t const& value) { _counters[counter] += value; }
+
+		void EnterRecursion();
+		void LeaveRecursion() { --_recursionDepth; }
+
+		void AddPhase(char const* name, uint64_t const& nanoseconds);
+		Vector<Pair<std::string, uint64_t>> const& GetPhases() const { return _phases; }
+
+		void Merge(AlgorithmStats const& source);
+
+		void WriteJson(std::ostream& os) const;
+
+		static char const* GetCounterName(Counter const& counter);
+
+		// The collector of the calling thread, nullptr outside of an AlgorithmStatsScope.
+		static AlgorithmStats* GetCurrent() { return _current; }
+
+	private:
+		friend class AlgorithmStatsScope;
+
+		static thread_local AlgorithmStats* _current;
+
+		uint64_t _counters[Counters];
+		uint64_t _recursionDepth;
+		Vector<Pair<std::string, uint64_t>> _phases;	// Accumulated nanoseconds per phase name, in first use order.
+};
+
+class AlgorithmStatsScope
+{
+	public:
+		explicit AlgorithmStatsScope(AlgorithmStats* stats) : _previous(AlgorithmStats::_current) { AlgorithmStats::_current = stats; }
+		~AlgorithmStatsScope() { AlgorithmStats::_current = _previous; }
+
+	private:
+		AlgorithmStatsScope(AlgorithmStatsScope const&);
+		AlgorithmStatsScope& operator=(AlgorithmStatsScope const&);
+
+		AlgorithmStats* _previous;
+};
+
+class PhaseTimer
+{
+	public:
+		PhaseTimer(AlgorithmStats* stats, char const* name) : _stats(stats), _name(name),
+			_start(std::chrono::steady_clock::now()) { }
+		~PhaseTimer();
+
+	private:
+		AlgorithmStats* _stats;
+		char const* _name;
+		std::chrono::steady_clock::time_point _start;
+};
+
+class RecursionGuard
+{
+	public:
+		explicit RecursionGuard(AlgorithmStats* stats) : _stats(stats) { if (_stats) _stats->EnterRecursion(); }
+		~RecursionGuard() { if (_stats) _stats->LeaveRecursion(); }
+
+	private:
+		AlgorithmStats* _stats;
+};
+
+// GRAPH_STATS_COLLECTOR() fetches the thread's collector once per call, the other macros use it.
+#ifdef GRAPH_ALGORITHMS_INSTRUMENTATION
+#define GRAPH_STATS_COLLECTOR() AlgorithmStats* const graphStats = AlgorithmStats::GetCurrent()
+#define GRAPH_STATS_ADD(counter, value) do { if (graphStats) graphStats->Add(AlgorithmStats::counter, (value)); } while (false)
+#define GRAPH_STATS_PHASE(name) PhaseTimer graphStatsPhase(graphStats, name)
+#define GRAPH_STATS_RECURSION() RecursionGuard graphStatsRecursion(graphStats)
+#else
+#define GRAPH_STATS_COLLECTOR() do { } while (false)
+#define GRAPH_STATS_ADD(counter, value) do { } while (false)
+#define GRAPH_STATS_PHASE(name) do { } while (false)
+#define GRAPH_STATS_RECURSION() do { } while (false)
+#endif
+
+#endif
+
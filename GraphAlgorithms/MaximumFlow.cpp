@@ -0,0 +1,337 @@
+#include "PCH.h"
+#include "MaximumFlow.h"
+#include "Instrumentation.h"
+
+uint32_t const MaximumFlow::None;
+
+MaximumFlow::MaximumFlow(DirectedGraph const& graph, uint32_t const& source, uint32_t const& sink) :
+	_vertices(graph.GetVertices()), _source(source), _sink(sink), _value(-1), _work(0), _highestActive(0), _highestLabel(0)
+{
+	GRAPH_STATS_COLLECTOR();
+
+	{
+		GRAPH_STATS_PHASE("flow_residual_graph");
+		Initialize(graph);
+	}
+
+	if (source >= _vertices || sink >= _vertices || source == sink)
+	{
+		_sourceSide.assign(_vertices, false);
+		return;
+	}
+
+	GRAPH_STATS_PHASE("flow_push_relabel");
+
+	// Saturate the source arcs, the labels are exact after the first global relabel.
+	_labels[_source] = _vertices;
+
+	for (uint64_t arc = _offsets[_source]; arc < _offsets[_source + 1]; ++arc)
+		_excess[_source] += _residual[arc];
+
+	for (uint64_t arc = _offsets[_source]; arc < _offsets[_source + 1]; ++arc)
+		if (_residual[arc] > 0)
+			Push(_source, arc);
+
+	GlobalRelabel();
+
+	uint64_t const globalRelabelWork = 6 * static_cast<uint64_t>(_vertices) + _heads.size();
+
+	while (true)
+	{
+		while (_highestActive != 0 && _activeHead[_highestActive] == None)
+			--_highestActive;
+
+		uint32_t vertex = _activeHead[_highestActive];
+
+		if (vertex == None)
+			break;
+
+		_activeHead[_highestActive] = _activeNext[vertex];
+		Discharge(vertex);
+
+		if (_work > globalRelabelWork)
+			GlobalRelabel();
+	}
+
+	_value = _excess[_sink];
+	ComputeSourceSide();
+}
+
+Vector<uint32_t> MaximumFlow::GetSourceSide() const
+{
+	Vector<uint32_t> sourceSide;
+
+	for (uint32_t i = 0; i < _vertices; ++i)
+		if (_sourceSide[i])
+			sourceSide.push_back(i);
+
+	return sourceSide;
+}
+
+Vector<Pair<uint32_t, uint32_t>> MaximumFlow::GetCutEdges() const
+{
+	Vector<Pair<uint32_t, uint32_t>> cutEdges;
+
+	for (uint32_t i = 0; i < _vertices; ++i)
+		if (_sourceSide[i])
+			for (uint64_t edge = _edgeOffsets[i]; edge < _edgeOffsets[i + 1]; ++edge)
+				if (!_sourceSide[_heads[_edgeArcs[edge]]])
+					cutEdges.push_back(std::make_pair(i, _heads[_edgeArcs[edge]]));
+
+	return cutEdges;
+}
+
+Vector<int64_t> MaximumFlow::GetFlows() const
+{
+	Vector<int64_t> flows(_edgeArcs.size());
+
+	for (uint64_t edge = 0; edge < _edgeArcs.size(); ++edge)
+		flows[edge] = GetFlow(edge);
+
+	return flows;
+}
+
+void MaximumFlow::Initialize(DirectedGraph const& graph)
+{
+	_edgeOffsets.assign(_vertices + 1, 0);
+	_offsets.assign(_vertices + 1, 0);
+
+	for (uint32_t i = 0; i < _vertices; ++i)
+	{
+		_edgeOffsets[i + 1] = _edgeOffsets[i] + graph.GetNeighbours(i).size();
+		_offsets[i + 1] += graph.GetNeighbours(i).size();
+
+		for (AdjacencyListConstIterator itr = graph.GetNeighbours(i).begin(); itr != graph.GetNeighbours(i).end(); ++itr)
+			++_offsets[itr->first + 1];
+	}
+
+	for (uint32_t i = 0; i < _vertices; ++i)
+		_offsets[i + 1] += _offsets[i];
+
+	_heads.resize(_offsets.back());
+	_residual.resize(_offsets.back());
+	_reverse.resize(_offsets.back());
+	_edgeArcs.resize(_edgeOffsets.back());
+
+	Vector<uint64_t> position(_offsets.begin(), _offsets.end() - 1);
+	uint64_t edge = 0;
+
+	for (uint32_t i = 0; i < _vertices; ++i)
+		for (AdjacencyListConstIterator itr = graph.GetNeighbours(i).begin(); itr != graph.GetNeighbours(i).end(); ++itr, ++edge)
+		{
+			uint64_t forward = position[i]++;
+			uint64_t backward = position[itr->first]++;
+
+			_heads[forward] = itr->first;
+			_heads[backward] = i;
+			_residual[forward] = graph.IsWeighted() ? std::max(itr->second, 0) : 1;
+			_residual[backward] = 0;
+			_reverse[forward] = backward;
+			_reverse[backward] = forward;
+			_edgeArcs[edge] = forward;
+		}
+
+	_labels.assign(_vertices, 0);
+	_excess.assign(_vertices, 0);
+	_current.assign(_offsets.begin(), _offsets.end() - 1);
+	_activeHead.assign(2 * static_cast<uint64_t>(_vertices), None);
+	_activeNext.assign(_vertices, None);
+	_labelHead.assign(_vertices, None);
+	_labelNext.assign(_vertices, None);
+	_labelPrevious.assign(_vertices, None);
+}
+
+void MaximumFlow::GlobalRelabel()
+{
+	GRAPH_STATS_COLLECTOR();
+	GRAPH_STATS_PHASE("flow_global_relabel");
+
+	uint32_t const unreached = 2 * _vertices;
+	Vector<uint32_t> queue;
+
+	// Exact distances to the sink in the residual graph, then to the source (offset by the vertex count) for the
+	// vertices that can only send their excess back.
+	_work = 0;
+	_labels.assign(_vertices, unreached);
+	_labels[_sink] = 0;
+	_labels[_source] = _vertices;
+	queue.reserve(_vertices);
+	queue.push_back(_sink);
+
+	for (uint32_t pass = 0; pass < 2; ++pass)
+	{
+		if (pass == 1)
+			queue.push_back(_source);
+
+		for (uint32_t head = static_cast<uint32_t>(queue.size()) - 1; head < queue.size(); ++head)
+		{
+			uint32_t element = queue[head];
+
+			for (uint64_t arc = _offsets[element]; arc < _offsets[element + 1]; ++arc)
+				if (_labels[_heads[arc]] == unreached && _residual[_reverse[arc]] > 0)
+				{
+					_labels[_heads[arc]] = _labels[element] + 1;
+					queue.push_back(_heads[arc]);
+				}
+		}
+	}
+
+	std::fill(_activeHead.begin(), _activeHead.end(), None);
+	std::fill(_labelHead.begin(), _labelHead.end(), None);
+	_highestActive = 0;
+	_highestLabel = 0;
+
+	for (uint32_t i = 0; i < _vertices; ++i)
+	{
+		_current[i] = _offsets[i];
+
+		if (i == _source)
+			continue;
+
+		if (_labels[i] < _vertices)
+			AddToLabel(i);
+
+		if (i != _sink && _excess[i] > 0 && _labels[i] < unreached)
+			Activate(i);
+	}
+}
+
+void MaximumFlow::Discharge(uint32_t const& vertex)
+{
+	while (_excess[vertex] > 0)
+	{
+		uint64_t arc = _current[vertex];
+
+		for (; arc < _offsets[vertex + 1]; ++arc)
+			if (_residual[arc] > 0 && _labels[vertex] == _labels[_heads[arc]] + 1)
+			{
+				Push(vertex, arc);
+
+				if (_excess[vertex] == 0)
+					break;
+			}
+
+		_current[vertex] = arc;
+
+		if (_excess[vertex] == 0)
+			return;
+
+		uint32_t label = _labels[vertex];
+
+		if (label < _vertices)
+		{
+			RemoveFromLabel(vertex);
+
+			// No vertex is left at this label, so nothing at or above it can reach the sink anymore.
+			if (_labelHead[label] == None)
+			{
+				Gap(label);
+				_labels[vertex] = _vertices;
+				_current[vertex] = _offsets[vertex];
+				continue;
+			}
+		}
+
+		uint32_t minimumLabel = 2 * _vertices;
+
+		for (arc = _offsets[vertex]; arc < _offsets[vertex + 1]; ++arc)
+			if (_residual[arc] > 0 && _labels[_heads[arc]] + 1 < minimumLabel)
+			{
+				minimumLabel = _labels[_heads[arc]] + 1;
+				_current[vertex] = arc;
+			}
+
+		_work += _offsets[vertex + 1] - _offsets[vertex] + 12;
+		_labels[vertex] = minimumLabel;
+
+		if (minimumLabel < _vertices)
+			AddToLabel(vertex);
+		else if (minimumLabel == 2 * _vertices)
+			return;
+	}
+}
+
+void MaximumFlow::Push(uint32_t const& vertex, uint64_t const& arc)
+{
+	uint32_t head = _heads[arc];
+	int64_t delta = std::min(_excess[vertex], _residual[arc]);
+
+	_residual[arc] -= delta;
+	_residual[_reverse[arc]] += delta;
+	_excess[vertex] -= delta;
+
+	if (_excess[head] == 0 && head != _source && head != _sink)
+		Activate(head);
+
+	_excess[head] += delta;
+}
+
+void MaximumFlow::Gap(uint32_t const& label)
+{
+	for (uint32_t i = label + 1; i <= _highestLabel; ++i)
+	{
+		for (uint32_t vertex = _labelHead[i]; vertex != None; vertex = _labelNext[vertex])
+		{
+			_labels[vertex] = _vertices;
+			_current[vertex] = _offsets[vertex];
+		}
+
+		_labelHead[i] = None;
+	}
+
+	_highestLabel = label;
+}
+
+void MaximumFlow::ComputeSourceSide()
+{
+	Vector<uint32_t> queue;
+
+	_sourceSide.assign(_vertices, false);
+	_sourceSide[_source] = true;
+	queue.push_back(_source);
+
+	for (uint32_t head = 0; head < queue.size(); ++head)
+		for (uint64_t arc = _offsets[queue[head]]; arc < _offsets[queue[head] + 1]; ++arc)
+			if (_residual[arc] > 0 && !_sourceSide[_heads[arc]])
+			{
+				_sourceSide[_heads[arc]] = true;
+				queue.push_back(_heads[arc]);
+			}
+}
+
+void MaximumFlow::Activate(uint32_t const& vertex)
+{
+	_activeNext[vertex] = _activeHead[_labels[vertex]];
+	_activeHead[_labels[vertex]] = vertex;
+
+	if (_labels[vertex] > _highestActive)
+		_highestActive = _labels[vertex];
+}
+
+void MaximumFlow::AddToLabel(uint32_t const& vertex)
+{
+	uint32_t label = _labels[vertex];
+
+	_labelPrevious[vertex] = None;
+	_labelNext[vertex] = _labelHead[label];
+
+	if (_labelHead[label] != None)
+		_labelPrevious[_labelHead[label]] = vertex;
+
+	_labelHead[label] = vertex;
+
+	if (label > _highestLabel)
+		_highestLabel = label;
+}
+
+void MaximumFlow::RemoveFromLabel(uint32_t const& vertex)
+{
+	if (_labelPrevious[vertex] != None)
+		_labelNext[_labelPrevious[vertex]] = _labelNext[vertex];
+	else
+		_labelHead[_labels[vertex]] = _labelNext[vertex];
+
+	if (_labelNext[vertex] != None)
+		_labelPrevious[_labelNext[vertex]] = _labelPrevious[vertex];
+}
+
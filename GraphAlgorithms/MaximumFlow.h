@@ -0,0 +1,75 @@
+#ifndef _MAXIMUM_FLOW_H
+#define _MAXIMUM_FLOW_H
+
+#include "PCH.h"
+#include "DirectedGraph.h"
+
+// Highest-label push-relabel maximum flow with global relabeling and the gap heuristic. The edge weights are the
+// capacities (negative ones count as 0), an unweighted graph has unit capacities.
+class MaximumFlow
+{
+	public:
+		MaximumFlow(DirectedGraph const& graph, uint32_t const& source, uint32_t const& sink);
+
+		// -1 when the source or the sink is not a valid vertex or they are the same vertex.
+		int64_t GetValue() const { return _value; }
+
+		// Minimum cut: the vertices still reachable from the source in the residual graph.
+		bool IsSourceSide(uint32_t const& vertex) const { return _sourceSide[vertex]; }
+		Vector<uint32_t> GetSourceSide() const;
+		Vector<Pair<uint32_t, uint32_t>> GetCutEdges() const;
+
+		// Flow on the index-th out edge of vertex, GetFlows() holds them all ordered by (vertex, index).
+		int64_t GetFlow(uint32_t const& vertex, uint32_t const& index) const { return GetFlow(_edgeOffsets[vertex] + index); }
+		Vector<int64_t> GetFlows() const;
+
+	private:
+		static uint32_t const None = UINT32_MAX;
+
+		int64_t GetFlow(uint64_t const& edge) const { return _residual[_reverse[_edgeArcs[edge]]]; }
+
+		void Initialize(DirectedGraph const& graph);
+		void GlobalRelabel();
+		void Discharge(uint32_t const& vertex);
+		void Push(uint32_t const& vertex, uint64_t const& arc);
+		void Gap(uint32_t const& label);
+		void ComputeSourceSide();
+
+		void Activate(uint32_t const& vertex);
+		void AddToLabel(uint32_t const& vertex);
+		void RemoveFromLabel(uint32_t const& vertex);
+
+		uint32_t _vertices;
+		uint32_t _source;
+		uint32_t _sink;
+		int64_t _value;
+		uint64_t _work;				// Arc scans since the last global relabel.
+
+		// Residual arcs in compressed sparse row order, every arc knows the index of its paired reverse arc.
+		Vector<uint64_t> _offsets;
+		Vector<uint32_t> _heads;
+		Vector<int64_t> _residual;
+		Vector<uint64_t> _reverse;
+
+		Vector<uint64_t> _edgeOffsets;
+		Vector<uint64_t> _edgeArcs;	// Forward residual arc of every edge of the graph.
+
+		Vector<uint32_t> _labels;
+		Vector<int64_t> _excess;
+		Vector<uint64_t> _current;
+
+		// Active vertices bucketed by label, and every vertex below label _vertices in a doubly linked list per label
+		// so a gap can lift the ones above it.
+		uint32_t _highestActive;
+		uint32_t _highestLabel;
+		Vector<uint32_t> _activeHead;
+		Vector<uint32_t> _activeNext;
+		Vector<uint32_t> _labelHead;
+		Vector<uint32_t> _labelNext;
+		Vector<uint32_t> _labelPrevious;
+
+		Vector<bool> _sourceSide;
+};
+
+#endif
+
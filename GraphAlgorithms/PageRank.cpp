@@ -0,0 +1,290 @@
+#include "PCH.h"
+#include "PageRank.h"
+#include "Instrumentation.h"
+#include "Parallel.h"
+
+uint32_t const PageRank::SegmentVertices;
+uint32_t const PageRank::BatchSeeds;
+uint32_t const PageRank::ChunkVertices;
+
+PageRank::PageRank(Graph const& graph, double const& damping, double const& tolerance, uint32_t const& maximumIterations,
+	uint32_t const& threads) : _damping(damping), _tolerance(tolerance), _maximumIterations(maximumIterations), _threads(threads)
+{
+	Build(CompressedGraph(graph));
+}
+
+PageRank::PageRank(CompressedGraph const& graph, double const& damping, double const& tolerance,
+	uint32_t const& maximumIterations, uint32_t const& threads) : _damping(damping), _tolerance(tolerance),
+	_maximumIterations(maximumIterations), _threads(threads)
+{
+	Build(graph);
+}
+
+void PageRank::Build(CompressedGraph const& graph)
+{
+	_vertices = graph.GetVertices();
+	_arcs = graph.GetArcs();
+	_danglingVertices = 0;
+	_inverseDegrees.resize(_vertices);
+
+	for (uint32_t i = 0; i < _vertices; ++i)
+	{
+		_inverseDegrees[i] = graph.GetDegree(i) ? 1.0f / graph.GetDegree(i) : 0.0f;
+
+		if (!graph.GetDegree(i))
+			++_danglingVertices;
+	}
+
+	_transpose = graph.GetTranspose();
+	_segments.resize((static_cast<uint64_t>(_vertices) + SegmentVertices - 1) / SegmentVertices);
+
+	// The transpose lists the sources of every target in ascending order, so each segment's run of them is contiguous.
+	for (uint32_t i = 0; i < _vertices; ++i)
+		for (uint64_t arc = _transpose.GetBegin(i); arc < _transpose.GetEnd(i); ++arc)
+		{
+			uint32_t source = _transpose.GetTarget(arc);
+			Segment& segment = _segments[source / SegmentVertices];
+
+			if (segment.targets.empty() || segment.targets.back() != i)
+			{
+				segment.targets.push_back(i);
+				segment.offsets.push_back(segment.sources.size());
+			}
+
+			segment.sources.push_back(source);
+		}
+
+	for (uint32_t i = 0; i < _segments.size(); ++i)
+		_segments[i].offsets.push_back(_segments[i].sources.size());
+}
+
+Vector<float> PageRank::Compute(RunControl* control, uint32_t* iterations) const
+{
+	return Compute(Vector<float>(_vertices, 1.0f), control, iterations);
+}
+
+Vector<float> PageRank::Compute(Vector<float> const& personalization, RunControl* control, uint32_t* iterations) const
+{
+	Vector<float> ranks;
+	double sum = 0;
+
+	if (iterations)
+		*iterations = 0;
+
+	if (personalization.size() != _vertices)
+		return ranks;
+
+	for (uint32_t i = 0; i < _vertices; ++i)
+	{
+		if (personalization[i] < 0)
+			return ranks;
+
+		sum += personalization[i];
+	}
+
+	if (sum <= 0)
+		return ranks;
+
+	Vector<float> teleports(_vertices);
+
+	for (uint32_t i = 0; i < _vertices; ++i)
+		teleports[i] = static_cast<float>(personalization[i] / sum);
+
+	if (!Iterate<1>(teleports, &ranks, control, 0, _maximumIterations, iterations))
+		ranks.clear();
+	else if (control)
+		control->Complete(_maximumIterations);
+
+	return ranks;
+}
+
+Matrix<float> PageRank::ComputePersonalized(Vector<uint32_t> const& seeds, RunControl* control, uint32_t* iterations) const
+{
+	Matrix<float> ranks;
+	uint64_t batches = (seeds.size() + BatchSeeds - 1) / BatchSeeds;
+	uint64_t total = batches * _maximumIterations;
+
+	if (iterations)
+		*iterations = 0;
+
+	for (uint64_t i = 0; i < seeds.size(); ++i)
+		if (seeds[i] >= _vertices)
+			return ranks;
+
+	ranks.resize(seeds.size());
+
+	for (uint64_t batch = 0; batch < batches; ++batch)
+	{
+		uint64_t first = batch * BatchSeeds;
+		uint64_t count = std::min<uint64_t>(BatchSeeds, seeds.size() - first);
+		uint32_t steps = 0;
+		Vector<float> teleports(static_cast<uint64_t>(_vertices) * BatchSeeds, 0.0f);
+		Vector<float> interleaved;
+
+		// A short last batch repeats its first seed in the spare lanes.
+		for (uint32_t lane = 0; lane < BatchSeeds; ++lane)
+			teleports[static_cast<uint64_t>(seeds[first + (lane < count ? lane : 0)]) * BatchSeeds + lane] = 1.0f;
+
+		if (!Iterate<BatchSeeds>(teleports, &interleaved, control, batch * _maximumIterations, total, &steps))
+			return Matrix<float>();
+
+		if (iterations)
+			*iterations = std::max(*iterations, steps);
+
+		for (uint32_t lane = 0; lane < count; ++lane)
+		{
+			ranks[first + lane].resize(_vertices);
+
+			for (uint32_t i = 0; i < _vertices; ++i)
+				ranks[first + lane][i] = interleaved[static_cast<uint64_t>(i) * BatchSeeds + lane];
+		}
+	}
+
+	if (control)
+		control->Complete(total);
+
+	return ranks;
+}
+
+template <uint32_t _Lanes>
+bool PageRank::Iterate(Vector<float> const& teleports, Vector<float>* ranks, RunControl* control, uint64_t const& done,
+	uint64_t const& total, uint32_t* iterations) const
+{
+	GRAPH_STATS_COLLECTOR();
+
+	uint32_t threads = Parallel::GetThreads(_threads);
+	float damping = static_cast<float>(_damping);
+	Vector<float> contributions(static_cast<uint64_t>(_vertices) * _Lanes);
+	Vector<float> next(contributions.size());
+	Vector<double> danglingSums(threads * _Lanes);
+	Vector<double> changes(threads * _Lanes);
+	uint32_t steps = 0;
+
+	*ranks = teleports;
+
+	while (steps < _maximumIterations)
+	{
+		if (control && !control->Poll(done + steps, total))
+			return false;
+
+		std::fill(danglingSums.begin(), danglingSums.end(), 0.0);
+		std::fill(changes.begin(), changes.end(), 0.0);
+
+		// What every vertex sends along each of its out arcs, and the rank of the dangling ones that sends nothing.
+		Parallel::For(0, _vertices, threads, [&](uint64_t const& first, uint64_t const& last, uint32_t const& thread)
+		{
+			double* dangling = &danglingSums[thread * _Lanes];
+
+			for (uint64_t i = first; i < last; ++i)
+			{
+				float const* rank = &(*ranks)[i * _Lanes];
+				float* contribution = &contributions[i * _Lanes];
+
+				for (uint32_t lane = 0; lane < _Lanes; ++lane)
+					contribution[lane] = rank[lane] * _inverseDegrees[i];
+
+				if (_inverseDegrees[i] == 0.0f)
+					for (uint32_t lane = 0; lane < _Lanes; ++lane)
+						dangling[lane] += rank[lane];
+			}
+		});
+
+		// Teleports and dangling rank both follow the teleport distribution, together they scale it by one factor.
+		float factors[_Lanes];
+
+		for (uint32_t lane = 0; lane < _Lanes; ++lane)
+		{
+			double dangling = 0;
+
+			for (uint32_t i = 0; i < threads; ++i)
+				dangling += danglingSums[i * _Lanes + lane];
+
+			factors[lane] = static_cast<float>(1.0 - _damping + _damping * dangling);
+		}
+
+		Parallel::ForDynamic(0, _vertices, ChunkVertices, threads,
+			[&](uint64_t const& first, uint64_t const& last, uint32_t const& thread)
+		{
+			// One rank vector gathers straight from the transpose, its contributions are small enough to stay in cache.
+			// A batch reads _Lanes times as many, so its targets sum one segment of sources after the other.
+			double* change = &changes[thread * _Lanes];
+
+			if (_Lanes == 1)
+			{
+				for (uint32_t i = static_cast<uint32_t>(first); i < last; ++i)
+				{
+					float sum = 0;
+
+					for (uint64_t arc = _transpose.GetBegin(i); arc < _transpose.GetEnd(i); ++arc)
+						sum += contributions[_transpose.GetTarget(arc)];
+
+					next[i] = teleports[i] * factors[0] + damping * sum;
+					change[0] += std::fabs(next[i] - (*ranks)[i]);
+				}
+
+				return;
+			}
+
+			std::fill(next.begin() + first * _Lanes, next.begin() + last * _Lanes, 0.0f);
+
+			for (uint32_t i = 0; i < _segments.size(); ++i)
+			{
+				Segment const& segment = _segments[i];
+				uint64_t begin = std::lower_bound(segment.targets.begin(), segment.targets.end(), first) - segment.targets.begin();
+				uint64_t end = std::lower_bound(segment.targets.begin() + begin, segment.targets.end(), last) -
+					segment.targets.begin();
+
+				for (uint64_t j = begin; j < end; ++j)
+				{
+					float sums[_Lanes] = { };
+
+					for (uint64_t arc = segment.offsets[j]; arc < segment.offsets[j + 1]; ++arc)
+					{
+						float const* contribution = &contributions[static_cast<uint64_t>(segment.sources[arc]) * _Lanes];
+
+						for (uint32_t lane = 0; lane < _Lanes; ++lane)
+							sums[lane] += contribution[lane];
+					}
+
+					float* target = &next[static_cast<uint64_t>(segment.targets[j]) * _Lanes];
+
+					for (uint32_t lane = 0; lane < _Lanes; ++lane)
+						target[lane] += sums[lane];
+				}
+			}
+
+			for (uint64_t i = first * _Lanes; i < last * _Lanes; i += _Lanes)
+				for (uint32_t lane = 0; lane < _Lanes; ++lane)
+				{
+					next[i + lane] = teleports[i + lane] * factors[lane] + damping * next[i + lane];
+					change[lane] += std::fabs(next[i + lane] - (*ranks)[i + lane]);
+				}
+		});
+
+		GRAPH_STATS_ADD(VerticesVisited, _vertices);
+		GRAPH_STATS_ADD(EdgesScanned, _arcs);
+
+		ranks->swap(next);
+		++steps;
+
+		double largest = 0;
+
+		for (uint32_t lane = 0; lane < _Lanes; ++lane)
+		{
+			double sum = 0;
+
+			for (uint32_t i = 0; i < threads; ++i)
+				sum += changes[i * _Lanes + lane];
+
+			largest = std::max(largest, sum);
+		}
+
+		if (largest < _tolerance)
+			break;
+	}
+
+	if (iterations)
+		*iterations = steps;
+
+	return true;
+}
@@ -0,0 +1,78 @@
+#ifndef _PAGE_RANK_H
+#define _PAGE_RANK_H
+
+#include "PCH.h"
+#include "Graph.h"
+#include "CompressedGraph.h"
+#include "RunControl.h"
+
+// PageRank by power iteration over the arcs into every vertex: each vertex pulls the rank its in-neighbours spread over
+// their out arcs, so the threads write disjoint ranks and need no atomics. A single rank vector pulls straight over the
+// transpose. The batched personalized ranks gather eight floats per arc, so their in arcs are also cut in segments of
+// SegmentVertices sources, every segment a compressed row per target, and the targets of a chunk sum one segment after
+// the other so the contributions they gather stay in cache. The rank of dangling vertices, those without out arcs, goes
+// back through the teleport distribution, as the random surfer does, and the iteration stops once the L1 change of a
+// step drops under the tolerance. Arcs count with their multiplicity, weights are ignored; an undirected graph takes
+// both directions of every edge. Ranks are float sums, each vector adds up to 1.
+class PageRank
+{
+	public:
+		static uint32_t const SegmentVertices = 1 << 16;	// Contributions of a segment fill 2 MiB per batch.
+		static uint32_t const BatchSeeds = 8;				// Personalized ranks computed side by side.
+		static uint32_t const ChunkVertices = 4096;			// Targets a thread takes at a time.
+
+		// threads splits every step, 0 uses every hardware thread.
+		explicit PageRank(Graph const& graph, double const& damping = 0.85, double const& tolerance = 1e-6,
+			uint32_t const& maximumIterations = 100, uint32_t const& threads = 0);
+		PageRank(CompressedGraph const& graph, double const& damping = 0.85, double const& tolerance = 1e-6,
+			uint32_t const& maximumIterations = 100, uint32_t const& threads = 0);
+
+		uint32_t GetVertices() const { return _vertices; }
+		uint32_t GetDanglingVertices() const { return _danglingVertices; }
+
+		// The control is polled once per step, progress counts steps out of the maximum. Every result is empty when the
+		// run was stopped, iterations gets the steps taken.
+		Vector<float> Compute(RunControl* control = nullptr, uint32_t* iterations = nullptr) const;
+
+		// Teleports follow personalization, one non-negative weight per vertex that is normalized to sum 1. Empty when
+		// its size is not V or it has no positive weight.
+		Vector<float> Compute(Vector<float> const& personalization, RunControl* control = nullptr,
+			uint32_t* iterations = nullptr) const;
+
+		// One rank vector per seed, teleporting to the seed alone. BatchSeeds seeds share every pass over the arcs with
+		// their ranks interleaved per vertex, so an arc adds a contiguous run of floats the compiler vectorizes. Empty
+		// when a seed is not a vertex; iterations gets the steps of the longest batch.
+		Matrix<float> ComputePersonalized(Vector<uint32_t> const& seeds, RunControl* control = nullptr,
+			uint32_t* iterations = nullptr) const;
+
+	private:
+		// In arcs of one segment's sources as a compressed row per target that has any.
+		struct Segment
+		{
+			Vector<uint32_t> targets;
+			Vector<uint64_t> offsets;		// targets.size() + 1 entries.
+			Vector<uint32_t> sources;
+		};
+
+		void Build(CompressedGraph const& graph);
+
+		// Iterates the _Lanes interleaved rank vectors to convergence. teleports holds _Lanes distributions interleaved
+		// per vertex and ranks gets the results; false when the control stopped the run.
+		template <uint32_t _Lanes>
+		bool Iterate(Vector<float> const& teleports, Vector<float>* ranks, RunControl* control, uint64_t const& done,
+			uint64_t const& total, uint32_t* iterations) const;
+
+		uint32_t _vertices;
+		double _damping;
+		double _tolerance;
+		uint32_t _maximumIterations;
+		uint32_t _threads;
+		uint64_t _arcs;
+		uint32_t _danglingVertices;
+
+		Vector<float> _inverseDegrees;	// 1 / out degree, 0 for a dangling vertex.
+		CompressedGraph _transpose;		// The sources of the arcs into every vertex.
+		Vector<Segment> _segments;		// The same arcs by source segment, for the batches.
+};
+
+#endif
@@ -0,0 +1,61 @@
+#ifndef _PARALLEL_H
+#define _PARALLEL_H
+
+#include "PCH.h"
+
+class Parallel
+{
+	public:
+		// 0 requests one thread per hardware thread.
+		static uint32_t GetThreads(uint32_t const& requested)
+		{
+			if (requested)
+				return requested;
+
+			uint32_t hardwareThreads = std::thread::hardware_concurrency();
+
+			return hardwareThreads ? hardwareThreads : 1;
+		}
+
+		// Splits [begin, end) in one contiguous range per thread and calls function(first, last, thread) on each.
+		template <class _Function>
+		static void For(uint64_t const& begin, uint64_t const& end, uint32_t const& threads, _Function const& function)
+		{
+			uint64_t size = (end > begin) ? (end - begin) : 0;
+			uint32_t count = static_cast<uint32_t>(std::min<uint64_t>(GetThreads(threads), std::max<uint64_t>(size, 1)));
+
+			if (count == 1)
+			{
+				function(begin, begin + size, 0);
+				return;
+			}
+
+			Vector<std::thread> workers;
+
+			for (uint32_t i = 0; i < count; ++i)
+				workers.push_back(std::thread(function, begin + size * i / count, begin + size * (i + 1) / count, i));
+
+			for (uint32_t i = 0; i < count; ++i)
+				workers[i].join();
+		}
+
+		// Hands out [begin, end) in chunks of chunkSize to the threads as they become idle, for irregular work.
+		template <class _Function>
+		static void ForDynamic(uint64_t const& begin, uint64_t const& end, uint64_t const& chunkSize, uint32_t const& threads,
+			_Function const& function)
+		{
+			uint64_t chunk = std::max<uint64_t>(chunkSize, 1);
+			uint64_t chunks = (end > begin) ? (end - begin + chunk - 1) / chunk : 0;
+			std::atomic<uint64_t> next(0);
+
+			For(0, std::min<uint64_t>(GetThreads(threads), std::max<uint64_t>(chunks, 1)), threads,
+				[&](uint64_t const&, uint64_t const&, uint32_t const& thread)
+				{
+					for (uint64_t i = next++; i < chunks; i = next++)
+						function(begin + i * chunk, std::min(end, begin + (i + 1) * chunk), thread);
+				});
+		}
+};
+
+#endif
+
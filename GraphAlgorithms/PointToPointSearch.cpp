@@ -0,0 +1,174 @@
+#include "PCH.h"
+#include "PointToPointSearch.h"
+#include "Instrumentation.h"
+
+uint32_t const PointToPointSearch::None;
+
+PointToPointSearch::PointToPointSearch(Graph const& graph) : _weighted(graph.IsWeighted()), _epoch(0), _settled(0),
+	_source(None), _target(None)
+{
+	_graphs[0] = CompressedGraph(graph);
+	_graphs[1] = _graphs[0].GetTranspose();
+	_directions[0].graph = &_graphs[0];
+	_directions[1].graph = &_graphs[1];
+	Initialize();
+}
+
+PointToPointSearch::PointToPointSearch(CompressedGraph const& graph, CompressedGraph const& transpose, bool weighted) :
+	_weighted(weighted), _epoch(0), _settled(0), _source(None), _target(None)
+{
+	_directions[0].graph = &graph;
+	_directions[1].graph = &transpose;
+	Initialize();
+}
+
+void PointToPointSearch::Initialize()
+{
+	uint32_t vertices = _directions[0].graph->GetVertices();
+
+	for (uint32_t side = 0; side < 2; ++side)
+	{
+		_directions[side].distance.resize(vertices);
+		_directions[side].parent.resize(vertices);
+		_directions[side].reached.assign(vertices, 0);
+		_directions[side].settled.assign(vertices, 0);
+	}
+}
+
+int64_t PointToPointSearch::Query(uint32_t const& source, uint32_t const& target, Vector<uint32_t>* path)
+{
+	GRAPH_STATS_COLLECTOR();
+
+	if (path)
+		path->clear();
+
+	if (source >= _directions[0].graph->GetVertices() || target >= _directions[0].graph->GetVertices())
+		return -1;
+
+	_source = source;
+	_target = target;
+	_settled = 0;
+	NextEpoch();
+
+	if (source == target)
+	{
+		if (path)
+			path->push_back(source);
+
+		return 0;
+	}
+
+	int64_t shortest = INT64_MAX;
+	uint32_t meeting = None;
+	std::greater<Pair<int64_t, uint32_t>> compare;
+
+	Reach(0, source, 0, None);
+	Reach(1, target, 0, None);
+	GRAPH_STATS_ADD(HeapPushes, 2);
+
+	// The keys are doubled distances plus the potential. A path through a vertex neither side has settled is at
+	// least as long as the sum of the two smallest keys over 2, so the search stops once that reaches the best path.
+	while (DiscardSettled(0) && DiscardSettled(1))
+	{
+		int64_t forwardKey = _directions[0].heap.front().first;
+		int64_t backwardKey = _directions[1].heap.front().first;
+
+		if (shortest != INT64_MAX && forwardKey + backwardKey >= 2 * shortest)
+			break;
+
+		uint32_t side = (forwardKey <= backwardKey) ? 0 : 1;
+		Direction& current = _directions[side];
+		Direction const& other = _directions[1 - side];
+
+		std::pop_heap(current.heap.begin(), current.heap.end(), compare);
+
+		uint32_t element = current.heap.back().second;
+
+		current.heap.pop_back();
+		current.settled[element] = _epoch;
+		++_settled;
+		GRAPH_STATS_ADD(HeapPops, 1);
+		GRAPH_STATS_ADD(VerticesVisited, 1);
+		GRAPH_STATS_ADD(EdgesScanned, current.graph->GetDegree(element));
+
+		for (uint64_t arc = current.graph->GetBegin(element); arc < current.graph->GetEnd(element); ++arc)
+		{
+			uint32_t neighbour = current.graph->GetTarget(arc);
+			int64_t length = current.distance[element] + (_weighted ? current.graph->GetWeight(arc) : 1);
+
+			if (current.reached[neighbour] == _epoch && length >= current.distance[neighbour])
+				continue;
+
+			Reach(side, neighbour, length, element);
+			GRAPH_STATS_ADD(EdgesRelaxed, 1);
+			GRAPH_STATS_ADD(HeapPushes, 1);
+
+			if (other.reached[neighbour] == _epoch && length + other.distance[neighbour] < shortest)
+			{
+				shortest = length + other.distance[neighbour];
+				meeting = neighbour;
+			}
+		}
+	}
+
+	if (shortest == INT64_MAX)
+		return -1;
+
+	if (path)
+	{
+		for (uint32_t vertex = meeting; vertex != None; vertex = _directions[0].parent[vertex])
+			path->push_back(vertex);
+
+		std::reverse(path->begin(), path->end());
+
+		for (uint32_t vertex = _directions[1].parent[meeting]; vertex != None; vertex = _directions[1].parent[vertex])
+			path->push_back(vertex);
+	}
+
+	return shortest;
+}
+
+void PointToPointSearch::NextEpoch()
+{
+	// Stamps from 2^32 queries ago would look current, so they are cleared when the counter wraps.
+	if (++_epoch == 0)
+	{
+		for (uint32_t side = 0; side < 2; ++side)
+		{
+			std::fill(_directions[side].reached.begin(), _directions[side].reached.end(), 0);
+			std::fill(_directions[side].settled.begin(), _directions[side].settled.end(), 0);
+		}
+
+		_epoch = 1;
+	}
+
+	_directions[0].heap.clear();
+	_directions[1].heap.clear();
+}
+
+void PointToPointSearch::Reach(uint32_t const& side, uint32_t const& vertex, int64_t const& distance, uint32_t const& parent)
+{
+	Direction& direction = _directions[side];
+	int64_t potential = GetPotential(vertex);
+
+	direction.distance[vertex] = distance;
+	direction.parent[vertex] = parent;
+	direction.reached[vertex] = _epoch;
+	direction.heap.push_back(std::make_pair(2 * distance + ((side == 0) ? potential : -potential), vertex));
+	std::push_heap(direction.heap.begin(), direction.heap.end(), std::greater<Pair<int64_t, uint32_t>>());
+}
+
+bool PointToPointSearch::DiscardSettled(uint32_t const& side)
+{
+	Direction& direction = _directions[side];
+
+	// Lazy deletion: a vertex is pushed again on every improvement, only its first pop counts.
+	while (!direction.heap.empty() && direction.settled[direction.heap.front().second] == _epoch)
+	{
+		std::pop_heap(direction.heap.begin(), direction.heap.end(), std::greater<Pair<int64_t, uint32_t>>());
+		direction.heap.pop_back();
+	}
+
+	return !direction.heap.empty();
+}
+
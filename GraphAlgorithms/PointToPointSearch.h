@@ -0,0 +1,70 @@
+#ifndef _POINT_TO_POINT_SEARCH_H
+#define _POINT_TO_POINT_SEARCH_H
+
+#include "PCH.h"
+#include "Graph.h"
+#include "CompressedGraph.h"
+
+// Bidirectional Dijkstra for single source -> target queries on non-negative weights, an unweighted graph counts
+// hops. The scratch arrays are stamped with a query epoch, so back to back queries only touch what they explore.
+// Not thread safe, use one instance per thread; instances can share one compressed graph and its transpose.
+class PointToPointSearch
+{
+	public:
+		// Lower bound of the distance between two vertices, it must be consistent (h(x, t) <= w(x, y) + h(y, t)).
+		using Heuristic = std::function<int32_t(uint32_t const&, uint32_t const&)>;
+
+		explicit PointToPointSearch(Graph const& graph);
+
+		// Searches graph, whose transpose is given, without a copy of either; both must outlive the search.
+		PointToPointSearch(CompressedGraph const& graph, CompressedGraph const& transpose, bool weighted);
+
+		// Turns the searches into A* with the average of the forward and backward potentials. An empty one resets it.
+		void SetHeuristic(Heuristic const& heuristic) { _heuristic = heuristic; }
+
+		// Length of the shortest path, -1 when the target is unreachable or a vertex is invalid. The path gets the
+		// vertices from source to target, it is left empty when there is none.
+		int64_t Query(uint32_t const& source, uint32_t const& target, Vector<uint32_t>* path = nullptr);
+
+		// Vertices settled by the last query, in both directions.
+		uint32_t GetSettled() const { return _settled; }
+
+	private:
+		static uint32_t const None = UINT32_MAX;
+
+		struct Direction
+		{
+			CompressedGraph const* graph;
+			Vector<int64_t> distance;
+			Vector<uint32_t> parent;
+			Vector<uint32_t> reached;		// Epoch in which distance and parent were last set.
+			Vector<uint32_t> settled;
+			Vector<Pair<int64_t, uint32_t>> heap;
+		};
+
+		// Twice the average potential of the forward search, the backward search uses its negation.
+		int64_t GetPotential(uint32_t const& vertex) const
+		{
+			return _heuristic ? static_cast<int64_t>(_heuristic(vertex, _target)) - _heuristic(_source, vertex) : 0;
+		}
+
+		PointToPointSearch(PointToPointSearch const&);
+		PointToPointSearch& operator=(PointToPointSearch const&);
+
+		void Initialize();
+		void NextEpoch();
+		void Reach(uint32_t const& side, uint32_t const& vertex, int64_t const& distance, uint32_t const& parent);
+		bool DiscardSettled(uint32_t const& side);	// False when the heap is left empty.
+
+		bool _weighted;
+		uint32_t _epoch;
+		uint32_t _settled;
+		uint32_t _source;
+		uint32_t _target;
+		Heuristic _heuristic;
+		Direction _directions[2];	// Forward from the source on the graph, backward from the target on its transpose.
+		CompressedGraph _graphs[2];	// The graph and its transpose when the search built them itself.
+};
+
+#endif
+
@@ -0,0 +1,92 @@
+#include "PCH.h"
+#include "QueryExecutor.h"
+#include "Parallel.h"
+
+QueryExecutor::QueryExecutor(Graph const& graph, uint32_t const& threads) : _graph(graph),
+	_scratch(Parallel::GetThreads(threads)), _pool(threads)
+{
+}
+
+std::future<QueryResult> QueryExecutor::Submit(Query const& query)
+{
+	std::shared_ptr<std::promise<QueryResult>> promise = std::make_shared<std::promise<QueryResult>>();
+
+	_pool.Submit([this, query, promise](uint32_t const& worker)
+		{
+			QueryResult result;
+
+			Run(query, worker, &result);
+			promise->set_value(std::move(result));
+		});
+
+	return promise->get_future();
+}
+
+Vector<QueryResult> QueryExecutor::Execute(Vector<Query> const& queries)
+{
+	Vector<QueryResult> results(queries.size());
+
+	for (uint64_t i = 0; i < queries.size(); ++i)
+	{
+		QueryResult* result = &results[i];
+		Query const* query = &queries[i];
+
+		_pool.Submit([this, query, result](uint32_t const& worker) { Run(*query, worker, result); });
+	}
+
+	_pool.Wait();
+
+	return results;
+}
+
+void QueryExecutor::Run(Query const& query, uint32_t const& worker, QueryResult* result)
+{
+	if (query.source >= _graph.GetVertices() ||
+		((query.type == Query::Distance || query.type == Query::Reachable) && query.target >= _graph.GetVertices()))
+		return;
+
+	Scratch& scratch = _scratch[worker];
+	TraversalWorkspace* workspace = &scratch.workspace;
+
+	switch (query.type)
+	{
+		case Query::BreadthFirstSearch:
+			result->vertices = _graph.BreadthFirstSearch(query.source, workspace);
+			result->value = static_cast<int64_t>(result->vertices.size());
+			break;
+
+		case Query::DepthFirstSearch:
+			result->vertices = _graph.DepthFirstSearch(query.source, workspace);
+			result->value = static_cast<int64_t>(result->vertices.size());
+			break;
+
+		case Query::Distances:
+			result->vertices = _graph.GetRoadDistance(query.source, workspace, query.radius);
+			result->distances.resize(result->vertices.size());
+
+			for (uint64_t i = 0; i < result->vertices.size(); ++i)
+				result->distances[i] = workspace->GetDistance(result->vertices[i]);
+
+			result->value = static_cast<int64_t>(result->vertices.size());
+			break;
+
+		case Query::Distance:
+			if (!scratch.search)
+			{
+				std::call_once(_compressedOnce, [this]()
+					{
+						_compressed = CompressedGraph(_graph);
+						_transpose = _compressed.GetTranspose();
+					});
+
+				scratch.search.reset(new PointToPointSearch(_compressed, _transpose, _graph.IsWeighted()));
+			}
+
+			result->value = scratch.search->Query(query.source, query.target, &result->vertices);
+			break;
+
+		case Query::Reachable:
+			result->value = _graph.IsReachable(query.source, query.target, workspace) ? 1 : 0;
+			break;
+	}
+}
@@ -0,0 +1,77 @@
+#ifndef _QUERY_EXECUTOR_H
+#define _QUERY_EXECUTOR_H
+
+#include "PCH.h"
+#include "Graph.h"
+#include "CompressedGraph.h"
+#include "PointToPointSearch.h"
+#include "ThreadPool.h"
+#include "TraversalWorkspace.h"
+
+struct Query
+{
+	enum Type
+	{
+		BreadthFirstSearch,		// The reached vertices in BFS order.
+		DepthFirstSearch,		// The reached vertices in DFS preorder.
+		Distances,				// The vertices within radius of the source, with their distances.
+		Distance,				// The source -> target distance and the shortest path.
+		Reachable				// Whether the target can be reached from the source.
+	};
+
+	Query(Type const& type, uint32_t const& source, uint32_t const& target = 0, int64_t const& radius = INT64_MAX) :
+		type(type), source(source), target(target), radius(radius) { }
+
+	Type type;
+	uint32_t source;
+	uint32_t target;	// Distance and Reachable only.
+	int64_t radius;		// Distances only.
+};
+
+struct QueryResult
+{
+	QueryResult() : value(-1) { }
+
+	Vector<uint32_t> vertices;	// The traversal order, the vertices within radius or the path.
+	Vector<int64_t> distances;	// Parallel to vertices, Distances only.
+	int64_t value;				// The vertex count, the distance or 1 / 0 for Reachable; -1 for an invalid vertex or no path.
+};
+
+// Runs read-only queries against one shared graph on a work stealing ThreadPool. Every worker keeps its own
+// TraversalWorkspace and, from its first Distance query on, its own PointToPointSearch over the compressed graph and
+// transpose the first such query builds for all of them, so queries allocate nothing proportional to V once the
+// workers are warm. The graph must not change while the executor exists.
+class QueryExecutor
+{
+	public:
+		explicit QueryExecutor(Graph const& graph, uint32_t const& threads = 0);
+
+		std::future<QueryResult> Submit(Query const& query);
+
+		// Runs the batch and returns the results in query order. It also waits for the queries submitted before it.
+		Vector<QueryResult> Execute(Vector<Query> const& queries);
+
+		uint32_t GetThreads() const { return _pool.GetThreads(); }
+		uint64_t GetSteals() const { return _pool.GetSteals(); }
+
+	private:
+		struct Scratch
+		{
+			TraversalWorkspace workspace;
+			std::unique_ptr<PointToPointSearch> search;
+		};
+
+		QueryExecutor(QueryExecutor const&);
+		QueryExecutor& operator=(QueryExecutor const&);
+
+		void Run(Query const& query, uint32_t const& worker, QueryResult* result);
+
+		Graph const& _graph;
+		std::once_flag _compressedOnce;
+		CompressedGraph _compressed;
+		CompressedGraph _transpose;
+		Vector<Scratch> _scratch;	// One per worker, declared before the pool so it outlives the running tasks.
+		ThreadPool _pool;
+};
+
+#endif
@@ -0,0 +1,67 @@
+#include "PCH.h"
+#include "RunControl.h"
+
+void RunControl::SetProgressCallback(ProgressCallback const& callback, std::chrono::milliseconds const& interval)
+{
+	_progress = callback;
+	_interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(interval).count();
+	_nextReport = 0;
+}
+
+bool RunControl::Poll(uint64_t const& done, uint64_t const& total)
+{
+	if (IsStopped())
+		return false;
+
+	if (_cancelled)
+	{
+		Stop(Cancelled);
+		return false;
+	}
+
+	int64_t now = std::chrono::steady_clock::now().time_since_epoch().count();
+
+	if (now >= _deadline)
+	{
+		Stop(DeadlineExceeded);
+		return false;
+	}
+
+	// The thread that wins the mutex reports, the others carry on instead of queueing behind it.
+	if (_progress && now >= _nextReport && _progressMutex.try_lock())
+	{
+		_nextReport = now + _interval;
+		_progress(done, total);
+		_progressMutex.unlock();
+	}
+
+	return true;
+}
+
+void RunControl::Complete(uint64_t const& total)
+{
+	int32_t current = _status;
+
+	while (current == Running || current == Completed)
+		if (_status.compare_exchange_weak(current, Completed))
+			break;
+
+	if (current != Running && current != Completed)
+		return;
+
+	if (_progress)
+	{
+		std::lock_guard<std::mutex> lock(_progressMutex);
+		_progress(total, total);
+	}
+}
+
+void RunControl::Stop(Status const& status)
+{
+	int32_t current = _status;
+
+	// The first reason wins, a deadline passing after a cancel does not overwrite it. A completed status is
+	// overwritten, it may come from a phase that another algorithm runs on the same control.
+	while ((current == Running || current == Completed) && !_status.compare_exchange_weak(current, status))
+		;
+}
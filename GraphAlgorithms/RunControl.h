@@ -0,0 +1,94 @@
+#ifndef _RUN_CONTROL_H
+#define _RUN_CONTROL_H
+
+#include "PCH.h"
+
+#include <chrono>
+
+// Cooperative cancellation, deadline and progress reporting for one long running call. The algorithms that accept one
+// poll it at their round, level or source boundaries and return an empty result once it says stop, GetStatus then
+// tells why. Cancel and SetDeadline may be called from any thread at any time; the progress callback is set before
+// the run starts and is never called concurrently with itself.
+class RunControl
+{
+	public:
+		enum Status { Running, Completed, Cancelled, DeadlineExceeded };
+
+		// Units of work done out of the expected total. The unit depends on the algorithm (sources, rounds, tile rounds),
+		// an algorithm that runs another one on the same control reports its phases one after the other.
+		using ProgressCallback = std::function<void(uint64_t const& done, uint64_t const& total)>;
+
+		RunControl() : _status(Running), _cancelled(false), _deadline(INT64_MAX), _interval(0), _nextReport(0) { }
+
+		void Cancel() { _cancelled = true; }
+
+		void SetDeadline(std::chrono::steady_clock::time_point const& deadline) { _deadline = deadline.time_since_epoch().count(); }
+		void SetTimeout(std::chrono::milliseconds const& timeout) { SetDeadline(std::chrono::steady_clock::now() + timeout); }
+
+		// The callback runs on one of the algorithm's threads, at most once per interval and once more on completion.
+		void SetProgressCallback(ProgressCallback const& callback, std::chrono::milliseconds const& interval =
+			std::chrono::milliseconds(100));
+
+		Status GetStatus() const { return static_cast<Status>(_status.load()); }
+		bool IsStopped() const { return GetStatus() == Cancelled || GetStatus() == DeadlineExceeded; }
+
+		// For the algorithms: false once the run has to stop. Safe to call from several threads of one run.
+		bool Poll(uint64_t const& done, uint64_t const& total);
+
+		// For the algorithms: marks a run that was not stopped as completed and reports its final progress.
+		void Complete(uint64_t const& total);
+
+	private:
+		RunControl(RunControl const&);
+		RunControl& operator=(RunControl const&);
+
+		void Stop(Status const& status);
+
+		std::atomic<int32_t> _status;
+		std::atomic<bool> _cancelled;
+		std::atomic<int64_t> _deadline;			// steady_clock ticks.
+		ProgressCallback _progress;
+		int64_t _interval;						// steady_clock ticks.
+		std::atomic<int64_t> _nextReport;
+		std::mutex _progressMutex;
+};
+
+// Runs function(RunControl*) on its own thread. Dropping an analysis cancels it and waits for the algorithm to notice,
+// which takes at most one of its polling intervals, so a caller that loses interest never leaks a running thread.
+template <class _Result>
+class AsyncAnalysis
+{
+	public:
+		template <class _Function>
+		explicit AsyncAnalysis(_Function const& function, std::shared_ptr<RunControl> const& control =
+			std::make_shared<RunControl>()) : _control(control)
+		{
+			RunControl* runControl = control.get();
+
+			// The future of std::async joins the thread in its destructor.
+			_result = std::async(std::launch::async, [function, runControl]() { return function(runControl); });
+		}
+
+		AsyncAnalysis(AsyncAnalysis&& source) : _control(std::move(source._control)), _result(std::move(source._result)) { }
+		~AsyncAnalysis() { if (_control) _control->Cancel(); }
+
+		RunControl& GetControl() const { return *_control; }
+		RunControl::Status GetStatus() const { return _control->GetStatus(); }
+
+		void Cancel() { _control->Cancel(); }
+
+		bool IsReady() const { return WaitFor(std::chrono::milliseconds(0)); }
+		bool WaitFor(std::chrono::milliseconds const& timeout) const { return _result.wait_for(timeout) == std::future_status::ready; }
+
+		// Blocks until the run ends, can be called once. The result is empty when the run was stopped.
+		_Result Get() { return _result.get(); }
+
+	private:
+		AsyncAnalysis(AsyncAnalysis const&);
+		AsyncAnalysis& operator=(AsyncAnalysis const&);
+
+		std::shared_ptr<RunControl> _control;
+		std::future<_Result> _result;
+};
+
+#endif
@@ -0,0 +1,125 @@
+#include "PCH.h"
+#include "ThreadPool.h"
+#include "Parallel.h"
+
+thread_local ThreadPool* ThreadPool::_currentPool = nullptr;
+thread_local uint32_t ThreadPool::_currentWorker = 0;
+
+ThreadPool::ThreadPool(uint32_t const& threads) : _queued(0), _unfinished(0), _next(0), _steals(0), _stopping(false)
+{
+	uint32_t count = Parallel::GetThreads(threads);
+
+	for (uint32_t i = 0; i < count; ++i)
+		_workers.push_back(std::unique_ptr<Worker>(new Worker()));
+
+	for (uint32_t i = 0; i < count; ++i)
+		_threads.push_back(std::thread(&ThreadPool::Run, this, i));
+}
+
+ThreadPool::~ThreadPool()
+{
+	Wait();
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_stopping = true;
+	}
+
+	_wake.notify_all();
+
+	for (uint32_t i = 0; i < _threads.size(); ++i)
+		_threads[i].join();
+}
+
+void ThreadPool::Submit(Task const& task)
+{
+	uint32_t worker = (_currentPool == this) ? _currentWorker : static_cast<uint32_t>(_next++ % _workers.size());
+
+	++_unfinished;
+
+	{
+		std::lock_guard<std::mutex> lock(_workers[worker]->mutex);
+		_workers[worker]->tasks.push_back(task);
+	}
+
+	// Counted under the pool mutex, so a worker checking for work before going to sleep cannot miss it.
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		++_queued;
+	}
+
+	_wake.notify_one();
+}
+
+void ThreadPool::Wait()
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+
+	_idle.wait(lock, [this]() { return _unfinished == 0; });
+}
+
+void ThreadPool::Run(uint32_t const& worker)
+{
+	_currentPool = this;
+	_currentWorker = worker;
+
+	for (;;)
+	{
+		Task task;
+
+		if (Pop(worker, &task))
+		{
+			task(worker);
+
+			if (--_unfinished == 0)
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				_idle.notify_all();
+			}
+
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(_mutex);
+
+		_wake.wait(lock, [this]() { return _stopping || _queued > 0; });
+
+		if (_stopping && _queued <= 0)
+			return;
+	}
+}
+
+bool ThreadPool::Pop(uint32_t const& worker, Task* task)
+{
+	{
+		Worker& own = *_workers[worker];
+		std::lock_guard<std::mutex> lock(own.mutex);
+
+		if (!own.tasks.empty())
+		{
+			*task = std::move(own.tasks.back());
+			own.tasks.pop_back();
+			--_queued;
+
+			return true;
+		}
+	}
+
+	for (uint32_t i = 1; i < _workers.size(); ++i)
+	{
+		Worker& victim = *_workers[(worker + i) % _workers.size()];
+		std::lock_guard<std::mutex> lock(victim.mutex);
+
+		if (!victim.tasks.empty())
+		{
+			*task = std::move(victim.tasks.front());
+			victim.tasks.pop_front();
+			--_queued;
+			++_steals;
+
+			return true;
+		}
+	}
+
+	return false;
+}
@@ -0,0 +1,59 @@
+#ifndef _THREAD_POOL_H
+#define _THREAD_POOL_H
+
+#include "PCH.h"
+
+// Fixed set of workers with one task deque each. A worker runs its own deque newest first, which keeps the tasks it
+// spawns hot in its cache, and steals the oldest task of another worker when its own runs dry. Tasks submitted from
+// outside the pool are dealt round robin.
+class ThreadPool
+{
+	public:
+		// The argument is the index of the worker running the task, in [0, GetThreads()), for per-worker scratch.
+		using Task = std::function<void(uint32_t const&)>;
+
+		// 0 requests one worker per hardware thread.
+		explicit ThreadPool(uint32_t const& threads = 0);
+
+		// Runs the queued tasks to completion before joining the workers.
+		~ThreadPool();
+
+		uint32_t GetThreads() const { return static_cast<uint32_t>(_workers.size()); }
+
+		void Submit(Task const& task);
+
+		// Blocks until every task submitted so far has finished. Must not be called from a task.
+		void Wait();
+
+		uint64_t GetSteals() const { return _steals; }
+
+	private:
+		struct Worker
+		{
+			std::mutex mutex;
+			std::deque<Task> tasks;
+		};
+
+		ThreadPool(ThreadPool const&);
+		ThreadPool& operator=(ThreadPool const&);
+
+		void Run(uint32_t const& worker);
+		bool Pop(uint32_t const& worker, Task* task);
+
+		static thread_local ThreadPool* _currentPool;		// The pool and worker index of the calling thread, if any.
+		static thread_local uint32_t _currentWorker;
+
+		Vector<std::unique_ptr<Worker>> _workers;
+		Vector<std::thread> _threads;
+
+		std::mutex _mutex;
+		std::condition_variable _wake;		// Signalled when a task is queued or the pool stops.
+		std::condition_variable _idle;		// Signalled when the last unfinished task finishes.
+		std::atomic<int64_t> _queued;		// Tasks in the deques.
+		std::atomic<uint64_t> _unfinished;	// Tasks submitted and not finished yet.
+		std::atomic<uint64_t> _next;
+		std::atomic<uint64_t> _steals;
+		bool _stopping;
+};
+
+#endif
@@ -0,0 +1,132 @@
+#include "PCH.h"
+#include "TopologicalOrder.h"
+#include "Instrumentation.h"
+#include "Parallel.h"
+
+uint32_t const TopologicalOrder::None;
+
+TopologicalOrder::TopologicalOrder(DirectedGraph const& graph, uint32_t const& threads) : _levels(graph.GetVertices(), None),
+	_longest(graph.GetVertices(), 0), _parents(graph.GetVertices(), None), _criticalEnd(None)
+{
+	GRAPH_STATS_COLLECTOR();
+	GRAPH_STATS_PHASE("topological_levels");
+
+	uint32_t vertices = graph.GetVertices();
+	uint32_t threadCount = Parallel::GetThreads(threads);
+	bool weighted = graph.IsWeighted();
+	CompressedGraph compressed(graph);
+	CompressedGraph transpose = compressed.GetTranspose();
+	Vector<std::atomic<uint32_t>> inDegrees(vertices);
+	Matrix<uint32_t> next(threadCount);
+
+	_order.reserve(vertices);
+
+	for (uint32_t i = 0; i < vertices; ++i)
+	{
+		inDegrees[i].store(transpose.GetDegree(i), std::memory_order_relaxed);
+
+		if (!transpose.GetDegree(i))
+		{
+			_levels[i] = 0;
+			_order.push_back(i);
+		}
+	}
+
+	for (uint64_t begin = 0, end = _order.size(); begin < end; begin = end, end = _order.size())
+	{
+		uint32_t level = static_cast<uint32_t>(_widths.size());
+
+		_widths.push_back(static_cast<uint32_t>(end - begin));
+		GRAPH_STATS_ADD(VerticesVisited, end - begin);
+
+		// Only the thread that takes the last in-arc of a vertex touches it, and by then every predecessor is final, so
+		// it pulls its longest distance over the transposed arcs without any race.
+		Parallel::ForDynamic(begin, end, 256, threadCount, [&](uint64_t const& first, uint64_t const& last, uint32_t const& thread)
+		{
+			for (uint64_t i = first; i < last; ++i)
+			{
+				uint32_t vertex = _order[i];
+
+				for (uint64_t arc = compressed.GetBegin(vertex); arc < compressed.GetEnd(vertex); ++arc)
+				{
+					uint32_t neighbour = compressed.GetTarget(arc);
+
+					if (inDegrees[neighbour].fetch_sub(1, std::memory_order_acq_rel) != 1)
+						continue;
+
+					_levels[neighbour] = level + 1;
+
+					for (uint64_t in = transpose.GetBegin(neighbour); in < transpose.GetEnd(neighbour); ++in)
+					{
+						int64_t length = _longest[transpose.GetTarget(in)] + (weighted ? transpose.GetWeight(in) : 1);
+
+						if (_parents[neighbour] == None || length > _longest[neighbour])
+						{
+							_longest[neighbour] = length;
+							_parents[neighbour] = transpose.GetTarget(in);
+						}
+					}
+
+					next[thread].push_back(neighbour);
+				}
+			}
+		});
+
+		for (uint32_t i = 0; i < threadCount; ++i)
+		{
+			_order.insert(_order.end(), next[i].begin(), next[i].end());
+			next[i].clear();
+		}
+	}
+
+	for (uint32_t i = 0; i < _order.size(); ++i)
+		if (_criticalEnd == None || _longest[_order[i]] > _longest[_criticalEnd])
+			_criticalEnd = _order[i];
+
+	if (_order.size() < vertices)
+		FindCycle(transpose);
+}
+
+int64_t TopologicalOrder::GetCriticalPathLength() const
+{
+	return (_criticalEnd == None) ? 0 : _longest[_criticalEnd];
+}
+
+Vector<uint32_t> TopologicalOrder::GetCriticalPath() const
+{
+	Vector<uint32_t> path;
+
+	for (uint32_t vertex = _criticalEnd; vertex != None; vertex = _parents[vertex])
+		path.push_back(vertex);
+
+	std::reverse(path.begin(), path.end());
+
+	return path;
+}
+
+void TopologicalOrder::FindCycle(CompressedGraph const& transpose)
+{
+	// An unordered vertex kept an in-arc from another unordered vertex, so walking those backwards must repeat one.
+	Vector<uint32_t> step(_levels.size(), None);
+	Vector<uint32_t> walk;
+	uint32_t vertex = 0;
+
+	while (_levels[vertex] != None)
+		++vertex;
+
+	while (step[vertex] == None)
+	{
+		step[vertex] = static_cast<uint32_t>(walk.size());
+		walk.push_back(vertex);
+
+		for (uint64_t arc = transpose.GetBegin(vertex); arc < transpose.GetEnd(vertex); ++arc)
+			if (_levels[transpose.GetTarget(arc)] == None)
+			{
+				vertex = transpose.GetTarget(arc);
+				break;
+			}
+	}
+
+	// The walk went against the arcs.
+	_cycle.assign(walk.rbegin(), walk.rend() - step[vertex]);
+}
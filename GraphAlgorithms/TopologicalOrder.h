@@ -0,0 +1,54 @@
+#ifndef _TOPOLOGICAL_ORDER_H
+#define _TOPOLOGICAL_ORDER_H
+
+#include "PCH.h"
+#include "DirectedGraph.h"
+#include "CompressedGraph.h"
+
+// Kahn topological sort that peels the zero in-degree vertices one level at a time, the vertices of a level in
+// parallel. The same pass finds the longest (critical) path into every vertex, with the arc weights as durations; an
+// unweighted graph counts arcs.
+class TopologicalOrder
+{
+	public:
+		static uint32_t const None = UINT32_MAX;
+
+		// threads splits every level, 0 uses every hardware thread.
+		explicit TopologicalOrder(DirectedGraph const& graph, uint32_t const& threads = 0);
+
+		bool IsAcyclic() const { return _cycle.empty(); }
+
+		// The vertices of one cycle in arc order, the last one has an arc back to the first. Empty for a DAG.
+		Vector<uint32_t> const& GetCycle() const { return _cycle; }
+
+		// Level by level, so every arc goes forward. With a cycle it only holds the vertices no cycle reaches.
+		Vector<uint32_t> const& GetOrder() const { return _order; }
+
+		// Longest arc count from a source, None for the vertices a cycle reaches.
+		uint32_t GetLevel(uint32_t const& vertex) const { return _levels[vertex]; }
+		Vector<uint32_t> const& GetLevels() const { return _levels; }
+
+		uint32_t GetLevelCount() const { return static_cast<uint32_t>(_widths.size()); }
+		Vector<uint32_t> const& GetLevelWidths() const { return _widths; }
+
+		// Heaviest path ending at vertex and its previous vertex on that path, None for a source.
+		int64_t GetLongestDistance(uint32_t const& vertex) const { return _longest[vertex]; }
+		uint32_t GetCriticalParent(uint32_t const& vertex) const { return _parents[vertex]; }
+
+		// The heaviest path of the ordered part of the graph, source first.
+		int64_t GetCriticalPathLength() const;
+		Vector<uint32_t> GetCriticalPath() const;
+
+	private:
+		void FindCycle(CompressedGraph const& transpose);
+
+		Vector<uint32_t> _order;
+		Vector<uint32_t> _levels;
+		Vector<uint32_t> _widths;
+		Vector<int64_t> _longest;
+		Vector<uint32_t> _parents;
+		Vector<uint32_t> _cycle;
+		uint32_t _criticalEnd;
+};
+
+#endif
@@ -0,0 +1,234 @@
+#ifndef _TRAVERSAL_H
+#define _TRAVERSAL_H
+
+#include "PCH.h"
+#include "Graph.h"
+#include "ComponentLabels.h"
+#include "TraversalWorkspace.h"
+#include "Instrumentation.h"
+
+// The traversals shared by the graphs and GraphView. They read the arcs through _Arcs, which gives GetVertices(),
+// HasVertex(vertex), the stored arcs of a vertex with GetArcs(vertex) and HasArc(source, arc) telling which of them
+// are kept. The graphs go through AllArcs, whose checks always pass and compile away.
+class Traversal
+{
+	public:
+		class AllArcs
+		{
+			public:
+				explicit AllArcs(Graph const& graph) : _graph(graph) { }
+
+				uint32_t GetVertices() const { return _graph.GetVertices(); }
+				bool HasVertex(uint32_t const& vertex) const { return vertex < _graph.GetVertices(); }
+				Vector<Pair<uint32_t, int32_t>> const& GetArcs(uint32_t const& vertex) const { return _graph.GetNeighbours(vertex); }
+				bool HasArc(uint32_t const&, Pair<uint32_t, int32_t> const&) const { return true; }
+
+			private:
+				Graph const& _graph;
+		};
+
+		// Breadth first order from vertex, ending early with stop once that is reached; UINT32_MAX never stops.
+		template <class _Arcs>
+		static Vector<uint32_t> const& BreadthFirstSearch(_Arcs const& arcs, uint32_t const& vertex, uint32_t const& stop,
+			TraversalWorkspace* workspace)
+		{
+			workspace->Begin(arcs.GetVertices());
+
+			if (!arcs.HasVertex(vertex))
+				return workspace->_order;
+
+			GRAPH_STATS_COLLECTOR();
+
+			Vector<uint32_t>& order = workspace->_order;
+
+			workspace->Reach(vertex);
+			order.push_back(vertex);
+
+			// The order doubles as the queue, it ends with stop once that is reached.
+			for (uint64_t head = 0; head < order.size() && order.back() != stop; ++head)
+			{
+				uint32_t element = order[head];
+				Vector<Pair<uint32_t, int32_t>> const& neighbours = arcs.GetArcs(element);
+
+				GRAPH_STATS_ADD(VerticesVisited, 1);
+				GRAPH_STATS_ADD(EdgesScanned, neighbours.size());
+
+				for (AdjacencyListConstIterator itr = neighbours.begin(); itr != neighbours.end(); ++itr)
+					if (!workspace->IsReached(itr->first) && arcs.HasArc(element, *itr))
+					{
+						workspace->Reach(itr->first);
+						order.push_back(itr->first);
+
+						if (itr->first == stop)
+							break;
+					}
+			}
+
+			return order;
+		}
+
+		template <class _Arcs>
+		static Vector<uint32_t> const& DepthFirstSearch(_Arcs const& arcs, uint32_t const& vertex, TraversalWorkspace* workspace)
+		{
+			workspace->Begin(arcs.GetVertices());
+
+			if (!arcs.HasVertex(vertex))
+				return workspace->_order;
+
+			GRAPH_STATS_COLLECTOR();
+
+			Vector<Pair<uint32_t, uint32_t>>& stack = workspace->_stack;
+
+			workspace->Reach(vertex);
+			workspace->_order.push_back(vertex);
+			stack.push_back(std::make_pair(vertex, 0));
+
+			while (!stack.empty())
+			{
+				uint32_t element = stack.back().first;
+				uint32_t& next = stack.back().second;
+				Vector<Pair<uint32_t, int32_t>> const& neighbours = arcs.GetArcs(element);
+
+				while (next < neighbours.size() && (workspace->IsReached(neighbours[next].first) || !arcs.HasArc(element, neighbours[next])))
+					++next;
+
+				if (next == neighbours.size())
+				{
+					GRAPH_STATS_ADD(EdgesScanned, next);
+					stack.pop_back();
+					continue;
+				}
+
+				uint32_t neighbour = neighbours[next++].first;
+
+				GRAPH_STATS_ADD(VerticesVisited, 1);
+				workspace->Reach(neighbour);
+				workspace->_order.push_back(neighbour);
+				stack.push_back(std::make_pair(neighbour, 0));
+			}
+
+			return workspace->_order;
+		}
+
+		// The vertices outside the arcs get ComponentLabels::None. The arcs must be symmetric.
+		template <class _Arcs>
+		static void GetConnectedComponents(_Arcs const& arcs, ComponentLabels* components)
+		{
+			GRAPH_STATS_COLLECTOR();
+
+			components->Reset(arcs.GetVertices());
+
+			// Breadth first, the members array of the component doubles as the queue.
+			for (uint32_t i = 0; i < arcs.GetVertices(); ++i)
+				if (components->_labels[i] == ComponentLabels::None && arcs.HasVertex(i))
+				{
+					uint64_t head = components->_members.size();
+
+					components->Add(i);
+
+					while (head < components->_members.size())
+					{
+						uint32_t vertex = components->_members[head++];
+						Vector<Pair<uint32_t, int32_t>> const& neighbours = arcs.GetArcs(vertex);
+
+						GRAPH_STATS_ADD(VerticesVisited, 1);
+						GRAPH_STATS_ADD(EdgesScanned, neighbours.size());
+
+						for (AdjacencyListConstIterator itr = neighbours.begin(); itr != neighbours.end(); ++itr)
+							if (components->_labels[itr->first] == ComponentLabels::None && arcs.HasArc(vertex, *itr))
+								components->Add(itr->first);
+					}
+
+					components->Close();
+				}
+		}
+
+		// The vertices outside the arcs get ComponentLabels::None.
+		template <class _Arcs>
+		static void GetStronglyConnectedComponents(_Arcs const& arcs, ComponentLabels* components)
+		{
+			GRAPH_STATS_COLLECTOR();
+
+			components->Reset(arcs.GetVertices());
+
+			// Pearce's single array variant: a label holds the smallest reachable index while the vertex is open and a
+			// component number counting down from V once it is closed. Closing a vertex gives its index back, so every
+			// closed vertex stays above every open one and an arc only has to look at one array.
+			Vector<uint32_t>& labels = components->_labels;
+			Vector<uint32_t>& index = components->_depth;
+			Vector<uint32_t>& stack = components->_stack;
+			Vector<ComponentLabels::Frame>& frames = components->_frames;
+			uint32_t next = 1;
+			uint32_t component = arcs.GetVertices();
+
+			for (uint32_t i = 0; i < arcs.GetVertices(); ++i)
+			{
+				if (labels[i] != ComponentLabels::None || !arcs.HasVertex(i))
+					continue;
+
+				ComponentLabels::Frame root = { i, 0 };
+
+				labels[i] = index[i] = next++;
+				frames.push_back(root);
+
+				while (!frames.empty())
+				{
+					uint32_t vertex = frames.back().vertex;
+					Vector<Pair<uint32_t, int32_t>> const& neighbours = arcs.GetArcs(vertex);
+
+					if (frames.back().next < neighbours.size())
+					{
+						Pair<uint32_t, int32_t> const& arc = neighbours[frames.back().next++];
+
+						if (!arcs.HasArc(vertex, arc))
+							continue;
+
+						if (labels[arc.first] == ComponentLabels::None)
+						{
+							ComponentLabels::Frame frame = { arc.first, 0 };
+
+							labels[arc.first] = index[arc.first] = next++;
+							frames.push_back(frame);
+						}
+						else if (labels[arc.first] < labels[vertex])
+							labels[vertex] = labels[arc.first];
+
+						continue;
+					}
+
+					frames.pop_back();
+					GRAPH_STATS_ADD(VerticesVisited, 1);
+					GRAPH_STATS_ADD(EdgesScanned, neighbours.size());
+
+					// Only the vertices that are not the root of their component wait on the stack.
+					if (labels[vertex] == index[vertex])
+					{
+						--next;
+
+						while (!stack.empty() && labels[vertex] <= labels[stack.back()])
+						{
+							labels[stack.back()] = component;
+							components->_members.push_back(stack.back());
+							stack.pop_back();
+							--next;
+						}
+
+						labels[vertex] = component--;
+						components->_members.push_back(vertex);
+						components->Close();
+					}
+					else
+						stack.push_back(vertex);
+
+					if (!frames.empty() && labels[vertex] < labels[frames.back().vertex])
+						labels[frames.back().vertex] = labels[vertex];
+				}
+			}
+
+			for (uint32_t i = 0; i < arcs.GetVertices(); ++i)
+				if (labels[i] != ComponentLabels::None)
+					labels[i] = arcs.GetVertices() - labels[i];
+		}
+};
+
+#endif
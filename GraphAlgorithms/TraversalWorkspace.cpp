@@ -0,0 +1,55 @@
+#include "PCH.h"
+#include "TraversalWorkspace.h"
+
+void TraversalWorkspace::Begin(uint32_t const& vertices, bool distances)
+{
+	// Stamps left over from earlier traversals are all below the new epoch; only a wrap around has to clear them.
+	if (_epoch >= UINT32_MAX - 2)
+	{
+		std::fill(_stamps.begin(), _stamps.end(), 0);
+		_epoch = 0;
+	}
+
+	_epoch += 2;
+
+	if (_stamps.size() < vertices)
+		_stamps.resize(vertices, 0);
+
+	if (distances && _distances.size() < vertices)
+		_distances.resize(vertices);
+
+	_order.clear();
+	_stack.clear();
+	_heap.clear();
+}
+
+TraversalWorkspacePool::Lease TraversalWorkspacePool::Acquire()
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	if (_free.empty())
+	{
+		_workspaces.push_back(std::unique_ptr<TraversalWorkspace>(new TraversalWorkspace()));
+		_free.push_back(_workspaces.back().get());
+	}
+
+	TraversalWorkspace* workspace = _free.back();
+
+	_free.pop_back();
+
+	return Lease(this, workspace);
+}
+
+uint32_t TraversalWorkspacePool::GetCreated() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	return static_cast<uint32_t>(_workspaces.size());
+}
+
+void TraversalWorkspacePool::Release(TraversalWorkspace* workspace)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	_free.push_back(workspace);
+}
@@ -0,0 +1,87 @@
+#ifndef _TRAVERSAL_WORKSPACE_H
+#define _TRAVERSAL_WORKSPACE_H
+
+#include "PCH.h"
+
+// Per-vertex state for one traversal at a time. A vertex counts as reached only when its stamp belongs to the
+// current traversal, so Begin bumps an epoch instead of clearing V entries and a short local query costs only what it
+// touches. A workspace is not thread safe, concurrent traversals take one each from a TraversalWorkspacePool.
+class TraversalWorkspace
+{
+	public:
+		TraversalWorkspace() : _epoch(0) { }
+
+		// Starts a traversal of a graph with the given vertex count, growing the arrays when needed. The distances are
+		// only allocated for the traversals that ask for them.
+		void Begin(uint32_t const& vertices, bool distances = false);
+
+		bool IsReached(uint32_t const& vertex) const { return _stamps[vertex] >= _epoch; }
+		bool IsSettled(uint32_t const& vertex) const { return _stamps[vertex] == _epoch + 1; }
+
+		void Reach(uint32_t const& vertex) { _stamps[vertex] = _epoch; }
+		void Settle(uint32_t const& vertex) { _stamps[vertex] = _epoch + 1; }
+
+		// -1 for a vertex the current traversal did not reach.
+		int64_t GetDistance(uint32_t const& vertex) const { return IsReached(vertex) ? _distances[vertex] : -1; }
+		void SetDistance(uint32_t const& vertex, int64_t const& distance) { _distances[vertex] = distance; }
+
+		// Vertices in the order the current traversal reached them.
+		Vector<uint32_t> const& GetOrder() const { return _order; }
+
+	private:
+		friend class Graph;
+		friend class UndirectedGraph;
+		friend class Traversal;
+
+		uint32_t _epoch;			// Reached vertices carry _epoch, settled ones _epoch + 1.
+		Vector<uint32_t> _stamps;
+		Vector<int64_t> _distances;
+		Vector<uint32_t> _order;
+		Vector<Pair<uint32_t, uint32_t>> _stack;	// DFS vertices with the index of their next neighbour.
+		Vector<Pair<int64_t, uint32_t>> _heap;
+};
+
+// Hands out workspaces to concurrent traversals. A lease returns its workspace on destruction, the pool keeps every
+// workspace it created, so a steady set of threads stops allocating after warming up.
+class TraversalWorkspacePool
+{
+	public:
+		class Lease
+		{
+			public:
+				Lease(Lease&& source) : _pool(source._pool), _workspace(source._workspace) { source._workspace = nullptr; }
+				~Lease() { if (_workspace) _pool->Release(_workspace); }
+
+				TraversalWorkspace* Get() const { return _workspace; }
+				TraversalWorkspace* operator->() const { return _workspace; }
+
+			private:
+				friend class TraversalWorkspacePool;
+
+				Lease(TraversalWorkspacePool* pool, TraversalWorkspace* workspace) : _pool(pool), _workspace(workspace) { }
+
+				Lease(Lease const&);
+				Lease& operator=(Lease const&);
+
+				TraversalWorkspacePool* _pool;
+				TraversalWorkspace* _workspace;
+		};
+
+		TraversalWorkspacePool() { }
+
+		Lease Acquire();
+
+		uint32_t GetCreated() const;
+
+	private:
+		TraversalWorkspacePool(TraversalWorkspacePool const&);
+		TraversalWorkspacePool& operator=(TraversalWorkspacePool const&);
+
+		void Release(TraversalWorkspace* workspace);
+
+		mutable std::mutex _mutex;
+		Vector<std::unique_ptr<TraversalWorkspace>> _workspaces;
+		Vector<TraversalWorkspace*> _free;
+};
+
+#endif
@@ -1,553 +1,792 @@
-#include "PCH.h"
-#include "UndirectedGraph.h"
-#include "DisjointSet.h"
-
-UndirectedGraph::UndirectedGraph(std::ifstream& ifs, bool weighted)
-{
-	uint32_t vertices;
-	_weighted = weighted;
-	ifs >> vertices >> _edges;
-	_adjacencyList.resize(vertices);
-
-	if (!IsWeighted())
-		for (uint32_t i = 0; i < GetEdges(); ++i)
-		{
-			uint32_t x, y;
-
-			ifs >> x >> y;
-			_adjacencyList[x].push_back(std::make_pair(y, 0));
-			_adjacencyList[y].push_back(std::make_pair(x, 0));
-		}
-	else
-		for (uint32_t i = 0; i < GetEdges(); ++i)
-		{
-			uint32_t x, y, w;
-
-			ifs >> x >> y >> w;
-			_adjacencyList[x].push_back(std::make_pair(y, w));
-			_adjacencyList[y].push_back(std::make_pair(x, w));
-		}
-}
-
-uint32_t UndirectedGraph::GetDegree(uint32_t const& vertex) const
-{
-	return Graph::GetOutDegree(vertex);
-}
-
-double UndirectedGraph::GetDensity() const
-{
-	return 2 * Graph::GetDensity();
-}
-
-bool UndirectedGraph::IsComplete() const
-{
-	if (!HasVertices() || !HasEdges())
-		return false;
-
-	if ((GetVertices() * (GetVertices() - 1)) / 2 != GetEdges())
-		return false;
-
-	return true;
-}
-
-bool UndirectedGraph::IsRegular() const
-{
-	for (uint32_t i = 1; i < GetVertices(); ++i)
-		if (GetDegree(i) != GetDegree(i - 1))
-			return false;
-
-	return true;
-}
-
-bool UndirectedGraph::IsConnected() const
-{
-	if (!HasVertices() || !HasEdges())
-		return false;
-
-	if (GetVertices() == 1)
-		return true;
-
-	if (DepthFirstSearch(0).size() == GetVertices())
-		return true;
-
-	return false;
-}
-
-bool UndirectedGraph::IsHamiltonian() const
-{
-	if (GetVertices() < 3)
-		return false;
-
-	if (IsComplete())
-		return true;
-
-	for (uint32_t i = 0; i < GetVertices(); ++i)
-		if (GetDegree(i) < (GetVertices() / 2))
-			return false;
-
-	return true;
-}
-
-bool UndirectedGraph::IsEulerian() const
-{
-	if (!IsConnected())
-		return false;
-
-	for (uint32_t i = 0; i < GetVertices(); ++i)
-		if (GetDegree(i) % 2 != 0)
-			return false;
-
-	return true;
-}
-
-bool UndirectedGraph::IsBipartite() const
-{
-	if (!HasVertices() || !HasEdges())
-		return false;
-
-	Vector<bool> visited(GetVertices());
-	Vector<char> color(GetVertices());
-	Queue<uint32_t> queue;
-
-	queue.push(0);
-	visited[0] = true;
-	color[0] = 0;
-
-	while (!queue.empty())
-	{
-		uint32_t element = queue.front();
-
-		for (uint32_t i = 0; i < GetDegree(element); ++i)
-		{
-			if (!visited[_adjacencyList[element][i].first])
-			{
-				queue.push(_adjacencyList[element][i].first);
-				visited[_adjacencyList[element][i].first] = true;
-				color[_adjacencyList[element][i].first] = (color[element] == 0 ? 1 : 0);
-				continue;
-			}
-			
-			if (color[element] == color[_adjacencyList[element][i].first])
-				return false;
-		}
-
-		queue.pop();
-	}
-
-	return true;
-}
-
-bool UndirectedGraph::IsBiconnected() const
-{
-	if (!HasVertices() || !HasEdges())
-		return false;
-
-	Vector<bool> visited(GetVertices(), false);
-	Vector<int> parent(GetVertices(), -1);
-	Vector<uint32_t> discoveryTime(GetVertices());
-	Vector<uint32_t> low(GetVertices());
-
-	if (HasArticulationPoint(0, &visited, &parent, &discoveryTime, &low))
-		return false;
-
-	for (uint32_t i = 0; i < visited.size(); ++i)
-		if (!visited[i])
-			return false;
-
-	return true;
-}
-
-Matrix<bool> UndirectedGraph::GetRoadMatrix() const
-{
-	Matrix<bool> roadMatrix(GetVertices());
-	Matrix<uint32_t> connectedComponents = GetConnectedComponents();
-
-	for (uint32_t i = 0; i < roadMatrix.size(); ++i)
-		roadMatrix[i].resize(GetVertices(), false);
-
-	for (uint32_t i = 0; i < connectedComponents.size(); ++i)
-		for (uint32_t j = 0; j < connectedComponents[i].size() - 1; ++j)
-			for (uint32_t k = j + 1; k < connectedComponents[i].size(); ++k)
-			{
-				roadMatrix[connectedComponents[i][j]][connectedComponents[i][k]] = true;
-				roadMatrix[connectedComponents[i][k]][connectedComponents[i][j]] = true;
-			}
-
-	return roadMatrix;
-}
-
-Vector<uint32_t> UndirectedGraph::GetArticulationPoints() const
-{
-	Vector<bool> visited(GetVertices(), false);
-	Vector<int> parent(GetVertices(), -1);
-	Vector<uint32_t> discoveryTime(GetVertices());
-	Vector<uint32_t> low(GetVertices());
-	Vector<uint32_t> articulationPoints;
-
-	for (uint32_t i = 0; i < GetVertices(); ++i)
-		if (!visited[i])
-			ArticulationPoint(i, &visited, &parent, &discoveryTime, &low, &articulationPoints);
-
-	return articulationPoints;
-}
-
-Matrix<uint32_t> UndirectedGraph::GetConnectedComponents() const
-{
-	Matrix<uint32_t> connectedComponents;
-	Vector<bool> visited(GetVertices(), false);
-
-	for (uint32_t i = 0; i < GetVertices(); ++i)
-	{
-		if (!visited[i])
-		{
-			connectedComponents.push_back(DepthFirstSearch(i));
-
-			for (uint32_t j = 0; j < connectedComponents.back().size(); ++j)
-				visited[connectedComponents.back()[j]] = true;
-		}
-	}
-
-	return connectedComponents;
-}
-
-Matrix<uint32_t> UndirectedGraph::GetBiconnectedComponents() const
-{
-	Stack<uint32_t> stack;
-	Vector<int> parent(GetVertices(), -1);						// Represents the parent of the vertex in DFS-tree.
-	Vector<uint32_t> low(GetVertices(), 0);						// Represents the lowest depth of a vertex connected to the index vertex through a back-edge in DFS-tree.
-	Vector<uint32_t> depth(GetVertices(), 0);					// Represents the depth of the vertex in DFS-tree.
-	Matrix<uint32_t> biconnectedComponents;
-
-	for (uint32_t i = 0; i < GetVertices(); ++i)
-		if (!depth[i])
-			GetBiconnectedComponents(i, &parent, &depth, &low, &stack, &biconnectedComponents);
-
-	return biconnectedComponents;
-}
-
-Vector<Pair<uint32_t, uint32_t>> UndirectedGraph::GetMinimumSpanningTree() const
-{
-	Vector<Pair<Pair<uint32_t, uint32_t>, int32_t>> edgesCostVector = GetEdgesVector();
-
-	std::sort(edgesCostVector.begin(), edgesCostVector.end(), EdgesCostComparator(true));
-
-	DisjointSet disjointSet(GetVertices());
-	Vector<Pair<uint32_t, uint32_t>> mstEdges;	// Minimum Spanning Tree edges
-
-	for (uint32_t i = 0; i < edgesCostVector.size(); ++i)
-	{
-		uint32_t x = edgesCostVector[i].first.first;
-		uint32_t y = edgesCostVector[i].first.second;
-
-		if (disjointSet.GetRoot(x) != disjointSet.GetRoot(y))
-		{
-			mstEdges.push_back(std::make_pair(x, y));
-			disjointSet.UnionSets(x, y);
-		}
-	}
-
-	return mstEdges;
-}
-
-Vector<Pair<uint32_t, uint32_t>> UndirectedGraph::GetMinimumSpanningTree(int32_t* cost) const
-{
-	Vector<Pair<Pair<uint32_t, uint32_t>, int32_t>> edgesCostVector = GetEdgesVector();
-
-	std::sort(edgesCostVector.begin(), edgesCostVector.end(), EdgesCostComparator(true));
-
-	DisjointSet disjointSet(GetVertices());
-	Vector<Pair<uint32_t, uint32_t>> mstEdges;	// Minimum Spanning Tree edges
-
-	for (uint32_t i = 0; i < edgesCostVector.size(); ++i)
-	{
-		int32_t _cost = edgesCostVector[i].second;
-		uint32_t x = edgesCostVector[i].first.first;
-		uint32_t y = edgesCostVector[i].first.second;
-
-		if (disjointSet.GetRoot(x) != disjointSet.GetRoot(y))
-		{
-			mstEdges.push_back(std::make_pair(x, y));
-			disjointSet.UnionSets(x, y);
-			*cost += _cost;
-		}
-	}
-
-	return mstEdges;
-}
-
-Vector<Pair<Pair<uint32_t, uint32_t>, int32_t>> UndirectedGraph::GetEdgesVector() const
-{
-	typedef Vector<Pair<Pair<uint32_t, uint32_t>, int32_t>>::const_iterator EdgesIterator;
-	Vector<Pair<Pair<uint32_t, uint32_t>, int32_t>> edges;
-
-	for (uint32_t i = 0; i < GetVertices(); ++i)
-		for (AdjacencyListConstIterator itr = _adjacencyList[i].begin(); itr != _adjacencyList[i].end(); ++itr)
-		{
-			bool found = false;
-
-			for (EdgesIterator iter = edges.begin(); iter != edges.end() && !found; ++iter)
-				if (((iter->first.first == i) && (iter->first.second == itr->first)) || 
-					((iter->first.second == i) && (iter->first.first == itr->first)))
-					found = true;
-
-			if (!found)
-				edges.push_back(std::make_pair(std::make_pair(i, itr->first), itr->second));
-		}
-
-	return edges;
-}
-
-void UndirectedGraph::ArticulationPoint(uint32_t const& vertex, Vector<bool>* visited, Vector<int>* parent,
-	Vector<uint32_t>* discoveryTime, Vector<uint32_t>* low, Vector<uint32_t>* articulationPoints) const
-{
-	if (!IsValidVertex(vertex))
-		return;
-
-	static uint32_t time = 0;
-	uint32_t children = 0;
-	(*visited)[vertex] = true;
-	(*discoveryTime)[vertex] = (*low)[vertex] = ++time;
-
-	for (uint32_t i = 0; i < GetDegree(vertex); ++i)
-	{
-		if (!(*visited)[_adjacencyList[vertex][i].first])
-		{
-			children++;
-			(*parent)[_adjacencyList[vertex][i].first] = vertex;
-			ArticulationPoint(_adjacencyList[vertex][i].first, visited, parent, discoveryTime, low, articulationPoints);
-
-			if ((*low)[_adjacencyList[vertex][i].first] < (*low)[vertex])
-				(*low)[vertex] = (*low)[_adjacencyList[vertex][i].first];
-
-			if (((*parent)[vertex] == -1 && children > 1) ||
-				((*parent)[vertex] != -1 && (*low)[_adjacencyList[vertex][i].first] >= (*discoveryTime)[vertex]))
-				articulationPoints->push_back(vertex);
-		}
-		else if ((_adjacencyList[vertex][i].first != (*parent)[vertex]) && 
-			((*discoveryTime)[_adjacencyList[vertex][i].first] < (*low)[vertex]))
-			(*low)[vertex] = (*discoveryTime)[_adjacencyList[vertex][i].first];
-	}
-}
-
-bool UndirectedGraph::HasArticulationPoint(uint32_t const& vertex, Vector<bool>* visited, 
-	Vector<int>* parent, Vector<uint32_t>* discoveryTime, Vector<uint32_t>* low) const
-{
-	if (!IsValidVertex(vertex))
-		return false;
-
-	static uint32_t time = 0;
-	uint32_t children = 0;
-	(*visited)[vertex] = true;
-	(*discoveryTime)[vertex] = (*low)[vertex] = ++time;
-
-	for (uint32_t i = 0; i < GetDegree(vertex); ++i)
-	{
-		if (!(*visited)[_adjacencyList[vertex][i].first])
-		{
-			children++;
-			(*parent)[_adjacencyList[vertex][i].first] = vertex;
-			
-			if (HasArticulationPoint(_adjacencyList[vertex][i].first, visited, parent, discoveryTime, low))
-				return true;
-
-			if ((*low)[_adjacencyList[vertex][i].first] < (*low)[vertex])
-				(*low)[vertex] = (*low)[_adjacencyList[vertex][i].first];
-
-			if (((*parent)[vertex] == -1 && children > 1) ||
-				((*parent)[vertex] != -1 && (*low)[_adjacencyList[vertex][i].first] >= (*discoveryTime)[vertex]))
-				return true;
-		}
-		else if ((_adjacencyList[vertex][i].first != (*parent)[vertex]) &&
-			((*discoveryTime)[_adjacencyList[vertex][i].first] < (*low)[vertex]))
-			(*low)[vertex] = (*discoveryTime)[_adjacencyList[vertex][i].first];
-	}
-
-	return false;
-}
-
-void UndirectedGraph::GetBiconnectedComponents(uint32_t const& vertex, Vector<int>* parent, Vector<uint32_t>* depth,
-	Vector<uint32_t>* low, Stack<uint32_t>* stack, Vector<Vector<uint32_t>>* biconnectedComponents) const
-{
-	if (!IsValidVertex(vertex))
-		return;
-
-	static uint32_t currentDepth = 0;
-	stack->push(vertex);
-	(*depth)[vertex] = (*low)[vertex] = ++currentDepth;
-
-	for (AdjacencyListConstIterator neighbour = _adjacencyList[vertex].begin(); neighbour != _adjacencyList[vertex].end(); ++neighbour)
-	{
-		if (!(*depth)[neighbour->first])
-		{
-			(*parent)[neighbour->first] = vertex;
-			GetBiconnectedComponents(neighbour->first, parent, depth, low, stack, biconnectedComponents);
-			(*low)[vertex] = std::min((*low)[vertex], (*low)[neighbour->first]);
-
-			// Check if vertex is an articulation point.
-			if ((*low)[neighbour->first] >= (*depth)[vertex])
-			{
-				biconnectedComponents->push_back(Vector<uint32_t>());
-				Matrix<uint32_t>::reverse_iterator itr = biconnectedComponents->rbegin();
-				while (stack->top() != neighbour->first)
-				{
-					itr->push_back(stack->top());
-					stack->pop();
-				}
-				itr->push_back(neighbour->first);
-				stack->pop();
-				itr->push_back(vertex);
-			}
-		}
-		// Check if neighbour is an ancestor of vertex in dfs tree.
-		else if (neighbour->first != (*parent)[vertex])
-			(*low)[vertex] = std::min((*low)[vertex], (*depth)[neighbour->first]);
-	}
-}
-
-UndirectedGraph& UndirectedGraph::operator=(UndirectedGraph const& source)
-{
-	if (this == &source)
-		return *this;
-
-	_weighted = source._weighted;
-	_edges = source._edges;
-	_adjacencyList = source._adjacencyList;
-
-	return *this;
-}
-
-UndirectedGraph UndirectedGraph::operator+(UndirectedGraph const& source)
-{
-	// TODO: better way to handle this
-	if (this->GetVertices() != source.GetVertices() || this->GetVertices() == 0)
-		return UndirectedGraph();
-
-	UndirectedGraph sumGraph;
-	sumGraph._adjacencyList.resize(this->GetVertices());
-
-	for (uint32_t i = 0; i < sumGraph.GetVertices(); ++i)
-	{
-		for (uint32_t j = 0; j < this->GetDegree(i); ++j)
-			sumGraph._adjacencyList[i].push_back(this->_adjacencyList[i][j]);
-
-		for (uint32_t j = 0; j < source.GetDegree(i); ++j)
-		{
-			bool found = false;
-
-			for (uint32_t k = 0; k < sumGraph.GetDegree(i); ++k)
-				if (sumGraph._adjacencyList[i][k] == source._adjacencyList[i][j])
-					found = true;
-
-			if (!found)
-				sumGraph._adjacencyList[i].push_back(source._adjacencyList[i][j]);
-		}
-	}
-
-	return sumGraph;
-}
-
-UndirectedGraph UndirectedGraph::operator-(UndirectedGraph const& source)
-{
-	// TODO: better way to handle this
-	if (this->GetVertices() != source.GetVertices() || this->GetVertices() == 0)
-		return UndirectedGraph();
-
-	UndirectedGraph difGraph;
-	difGraph._adjacencyList.resize(this->GetVertices());
-
-	for (uint32_t i = 0; i < this->GetVertices(); ++i)
-	{
-		for (uint32_t j = 0; j < this->GetDegree(i); ++j)
-		{
-			bool found = false;
-			for (uint32_t k = 0; k < source.GetDegree(i); ++k)
-				if (this->_adjacencyList[i][j] == source._adjacencyList[i][k])
-					found = true;
-
-			if (!found)
-				difGraph._adjacencyList[i].push_back(this->_adjacencyList[i][j]);
-		}
-	}
-
-	return difGraph;
-}
-
-bool UndirectedGraph::operator==(UndirectedGraph const& source)
-{
-	if (this->GetVertices() != source.GetVertices() || 
-		this->GetEdges() != source.GetEdges() || 
-		this->_adjacencyList != source._adjacencyList)
-		return false;
-
-	if (((*this) + source).GetEdges() != this->GetEdges())
-		return false;
-
-	return true;
-}
-
-std::istream& operator>>(std::istream& is, UndirectedGraph& graph)
-{
-	uint16_t weighted;
-	uint32_t vertices;
-	is >> vertices >> graph._edges >> weighted;
-
-	graph._adjacencyList.~vector();
-	graph._adjacencyList.resize(vertices);
-
-	graph._weighted = weighted ? true : false;
-
-	if (!graph.IsWeighted())
-		for (uint32_t i = 0; i < graph.GetEdges(); ++i)
-		{
-			uint32_t x, y;
-
-			is >> x >> y;
-			graph._adjacencyList[x].push_back(std::make_pair(y, 0));
-			graph._adjacencyList[y].push_back(std::make_pair(x, 0));
-		}
-	else
-		for (uint32_t i = 0; i < graph.GetEdges(); ++i)
-		{
-			uint32_t x, y, w;
-
-			is >> x >> y >> w;
-			graph._adjacencyList[x].push_back(std::make_pair(y, w));
-			graph._adjacencyList[y].push_back(std::make_pair(x, w));
-		}
-
-	return is;
-}
-
-std::ifstream& operator>>(std::ifstream& ifs, UndirectedGraph& graph)
-{
-	uint16_t weighted;
-	uint32_t vertices;
-	ifs >> vertices >> graph._edges >> weighted;
-
-	graph._adjacencyList.~vector();
-	graph._adjacencyList.resize(vertices);
-
-	graph._weighted = weighted ? true : false;
-
-	if (!graph.IsWeighted())
-		for (uint32_t i = 0; i < graph.GetEdges(); ++i)
-		{
-			uint32_t x, y;
-
-			ifs >> x >> y;
-			graph._adjacencyList[x].push_back(std::make_pair(y, 0));
-			graph._adjacencyList[y].push_back(std::make_pair(x, 0));
-		}
-	else
-		for (uint32_t i = 0; i < graph.GetEdges(); ++i)
-		{
-			uint32_t x, y, w;
-
-			ifs >> x >> y >> w;
-			graph._adjacencyList[x].push_back(std::make_pair(y, w));
-			graph._adjacencyList[y].push_back(std::make_pair(x, w));
-		}
-
-	return ifs;
-}
-
+#include "PCH.h"
+#include "UndirectedGraph.h"
+#include "DisjointSet.h"
+#include "HamiltonianCycle.h"
+#include "Instrumentation.h"
+#include "Traversal.h"
+
+UndirectedGraph::UndirectedGraph(std::ifstream& ifs, bool weighted)
+{
+	uint32_t vertices;
+	_weighted = weighted;
+	ifs >> vertices >> _edges;
+	_adjacencyList.resize(vertices);
+
+	if (!IsWeighted())
+		for (uint32_t i = 0; i < GetEdges(); ++i)
+		{
+			uint32_t x, y;
+
+			ifs >> x >> y;
+			_adjacencyList[x].push_back(std::make_pair(y, 0));
+			_adjacencyList[y].push_back(std::make_pair(x, 0));
+		}
+	else
+		for (uint32_t i = 0; i < GetEdges(); ++i)
+		{
+			uint32_t x, y, w;
+
+			ifs >> x >> y >> w;
+			_adjacencyList[x].push_back(std::make_pair(y, w));
+			_adjacencyList[y].push_back(std::make_pair(x, w));
+		}
+}
+
+uint32_t UndirectedGraph::GetDegree(uint32_t const& vertex) const
+{
+	return Graph::GetOutDegree(vertex);
+}
+
+Vector<uint32_t> UndirectedGraph::GetDegrees() const
+{
+	Vector<uint32_t> degrees(GetVertices());
+
+	for (uint32_t i = 0; i < GetVertices(); ++i)
+		degrees[i] = static_cast<uint32_t>(_adjacencyList[i].size());
+
+	return degrees;
+}
+
+double UndirectedGraph::GetDensity() const
+{
+	return 2 * Graph::GetDensity();
+}
+
+bool UndirectedGraph::IsComplete() const
+{
+	if (!HasVertices() || !HasEdges())
+		return false;
+
+	if ((GetVertices() * (GetVertices() - 1)) / 2 != GetEdges())
+		return false;
+
+	return true;
+}
+
+bool UndirectedGraph::IsRegular() const
+{
+	for (uint32_t i = 1; i < GetVertices(); ++i)
+		if (_adjacencyList[i].size() != _adjacencyList[i - 1].size())
+			return false;
+
+	return true;
+}
+
+bool UndirectedGraph::IsConnected() const
+{
+	if (!HasVertices() || !HasEdges())
+		return false;
+
+	if (GetVertices() == 1)
+		return true;
+
+	if (DepthFirstSearch(0).size() == GetVertices())
+		return true;
+
+	return false;
+}
+
+bool UndirectedGraph::IsHamiltonian() const
+{
+	if (GetVertices() < 3)
+		return false;
+
+	if (GetVertices() <= HamiltonianCycle::MaximumVertices)
+		return HamiltonianCycle(*this).HasCycle();
+
+	if (IsComplete())
+		return true;
+
+	// Dirac's condition is only sufficient, a larger graph without it is taken as not Hamiltonian.
+	for (uint32_t i = 0; i < GetVertices(); ++i)
+		if (GetDegree(i) < (GetVertices() / 2))
+			return false;
+
+	return true;
+}
+
+bool UndirectedGraph::IsEulerian() const
+{
+	uint32_t start = GetVertices();
+	uint32_t withEdges = 0;
+
+	for (uint32_t i = 0; i < GetVertices(); ++i)
+	{
+		if (_adjacencyList[i].size() % 2 != 0)
+			return false;
+
+		if (!_adjacencyList[i].empty() && !withEdges++)
+			start = i;
+	}
+
+	if (!withEdges)
+		return false;
+
+	// Isolated vertices do not matter, the others have to be connected.
+	TraversalWorkspace workspace;
+
+	return BreadthFirstSearch(start, &workspace).size() == withEdges;
+}
+
+bool UndirectedGraph::IsBipartite() const
+{
+	if (!HasVertices() || !HasEdges())
+		return false;
+
+	Vector<char> color;
+
+	return GetBipartition(&color);
+}
+
+bool UndirectedGraph::IsBipartite(TraversalWorkspace* workspace) const
+{
+	if (!HasVertices() || !HasEdges())
+		return false;
+
+	Vector<uint32_t>& queue = workspace->_order;
+
+	workspace->Begin(GetVertices(), true);
+
+	for (uint32_t i = 0; i < GetVertices(); ++i)
+	{
+		if (workspace->IsReached(i))
+			continue;
+
+		uint64_t head = queue.size();
+
+		workspace->Reach(i);
+		workspace->SetDistance(i, 0);
+		queue.push_back(i);
+
+		while (head < queue.size())
+		{
+			uint32_t element = queue[head++];
+			int64_t depth = workspace->_distances[element] + 1;
+
+			for (AdjacencyListConstIterator itr = _adjacencyList[element].begin(); itr != _adjacencyList[element].end(); ++itr)
+			{
+				if (!workspace->IsReached(itr->first))
+				{
+					workspace->Reach(itr->first);
+					workspace->SetDistance(itr->first, depth);
+					queue.push_back(itr->first);
+				}
+				else if ((workspace->_distances[itr->first] & 1) != (depth & 1))
+					return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+bool UndirectedGraph::IsBiconnected() const
+{
+	if (!HasVertices() || !HasEdges())
+		return false;
+
+	Vector<bool> visited(GetVertices(), false);
+	Vector<int> parent(GetVertices(), -1);
+	Vector<uint32_t> discoveryTime(GetVertices());
+	Vector<uint32_t> low(GetVertices());
+	uint32_t time = 0;
+
+	if (HasArticulationPoint(0, &visited, &parent, &discoveryTime, &low, &time))
+		return false;
+
+	for (uint32_t i = 0; i < visited.size(); ++i)
+		if (!visited[i])
+			return false;
+
+	return true;
+}
+
+bool UndirectedGraph::GetBipartition(Vector<char>* color) const
+{
+	Vector<bool> visited(GetVertices(), false);
+	Vector<uint32_t> queue;
+
+	color->assign(GetVertices(), 0);
+	queue.reserve(GetVertices());
+
+	for (uint32_t i = 0; i < GetVertices(); ++i)
+	{
+		if (visited[i])
+			continue;
+
+		uint32_t head = static_cast<uint32_t>(queue.size());
+
+		queue.push_back(i);
+		visited[i] = true;
+
+		while (head < queue.size())
+		{
+			uint32_t element = queue[head++];
+			char neighbourColor = ((*color)[element] == 0) ? 1 : 0;
+
+			for (AdjacencyListConstIterator itr = _adjacencyList[element].begin(); itr != _adjacencyList[element].end(); ++itr)
+			{
+				if (!visited[itr->first])
+				{
+					visited[itr->first] = true;
+					(*color)[itr->first] = neighbourColor;
+					queue.push_back(itr->first);
+					continue;
+				}
+
+				if ((*color)[itr->first] != neighbourColor)
+					return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+Matrix<bool> UndirectedGraph::GetRoadMatrix() const
+{
+	Matrix<bool> roadMatrix(GetVertices());
+	Matrix<uint32_t> connectedComponents = GetConnectedComponents();
+
+	for (uint32_t i = 0; i < roadMatrix.size(); ++i)
+		roadMatrix[i].resize(GetVertices(), false);
+
+	for (uint32_t i = 0; i < connectedComponents.size(); ++i)
+		for (uint32_t j = 0; j < connectedComponents[i].size() - 1; ++j)
+			for (uint32_t k = j + 1; k < connectedComponents[i].size(); ++k)
+			{
+				roadMatrix[connectedComponents[i][j]][connectedComponents[i][k]] = true;
+				roadMatrix[connectedComponents[i][k]][connectedComponents[i][j]] = true;
+			}
+
+	return roadMatrix;
+}
+
+Vector<uint32_t> UndirectedGraph::GetArticulationPoints() const
+{
+	GRAPH_STATS_COLLECTOR();
+	GRAPH_STATS_ADD(BytesAllocated, GetVertices() / 8 + GetVertices() * (sizeof(int) + 2 * sizeof(uint32_t)));
+
+	Vector<bool> visited(GetVertices(), false);
+	Vector<int> parent(GetVertices(), -1);
+	Vector<uint32_t> discoveryTime(GetVertices());
+	Vector<uint32_t> low(GetVertices());
+	Vector<uint32_t> articulationPoints;
+	uint32_t time = 0;
+
+	for (uint32_t i = 0; i < GetVertices(); ++i)
+		if (!visited[i])
+			ArticulationPoint(i, &visited, &parent, &discoveryTime, &low, &time, &articulationPoints);
+
+	return articulationPoints;
+}
+
+Matrix<uint32_t> UndirectedGraph::GetConnectedComponents() const
+{
+	Matrix<uint32_t> connectedComponents;
+	Vector<bool> visited(GetVertices(), false);
+
+	for (uint32_t i = 0; i < GetVertices(); ++i)
+	{
+		if (!visited[i])
+		{
+			connectedComponents.push_back(DepthFirstSearch(i));
+
+			for (uint32_t j = 0; j < connectedComponents.back().size(); ++j)
+				visited[connectedComponents.back()[j]] = true;
+		}
+	}
+
+	return connectedComponents;
+}
+
+Matrix<uint32_t> UndirectedGraph::GetBiconnectedComponents() const
+{
+	GRAPH_STATS_COLLECTOR();
+	GRAPH_STATS_ADD(BytesAllocated, GetVertices() * (sizeof(int) + 2 * sizeof(uint32_t)));
+
+	Stack<uint32_t> stack;
+	Vector<int> parent(GetVertices(), -1);						// Represents the parent of the vertex in DFS-tree.
+	Vector<uint32_t> low(GetVertices(), 0);						// Represents the lowest depth of a vertex connected to the index vertex through a back-edge in DFS-tree.
+	Vector<uint32_t> depth(GetVertices(), 0);					// Represents the depth of the vertex in DFS-tree.
+	Matrix<uint32_t> biconnectedComponents;
+	uint32_t time = 0;
+
+	for (uint32_t i = 0; i < GetVertices(); ++i)
+		if (!depth[i])
+			GetBiconnectedComponents(i, &parent, &depth, &low, &time, &stack, &biconnectedComponents);
+
+	return biconnectedComponents;
+}
+
+void UndirectedGraph::GetConnectedComponents(ComponentLabels* components) const
+{
+	Traversal::GetConnectedComponents(Traversal::AllArcs(*this), components);
+}
+
+void UndirectedGraph::GetBiconnectedComponents(ComponentLabels* components) const
+{
+	GRAPH_STATS_COLLECTOR();
+	GRAPH_STATS_ADD(VerticesVisited, GetVertices());
+	GRAPH_STATS_ADD(EdgesScanned, 2 * static_cast<uint64_t>(GetEdges()));
+
+	components->Reset(GetVertices());
+
+	Vector<uint32_t>& depth = components->_depth;
+	Vector<uint32_t>& low = components->_low;
+	Vector<uint32_t>& stack = components->_stack;
+	Vector<ComponentLabels::Frame>& frames = components->_frames;
+	uint32_t time = 0;
+
+	for (uint32_t i = 0; i < GetVertices(); ++i)
+	{
+		if (depth[i])
+			continue;
+
+		ComponentLabels::Frame root = { i, 0 };
+
+		depth[i] = low[i] = ++time;
+		stack.push_back(i);
+		frames.push_back(root);
+
+		while (!frames.empty())
+		{
+			uint32_t vertex = frames.back().vertex;
+
+			if (frames.back().next < _adjacencyList[vertex].size())
+			{
+				uint32_t neighbour = _adjacencyList[vertex][frames.back().next++].first;
+
+				if (!depth[neighbour])
+				{
+					ComponentLabels::Frame frame = { neighbour, 0 };
+
+					depth[neighbour] = low[neighbour] = ++time;
+					stack.push_back(neighbour);
+					frames.push_back(frame);
+				}
+				// The frame below is the DFS parent.
+				else if (frames.size() < 2 || neighbour != frames[frames.size() - 2].vertex)
+					low[vertex] = std::min(low[vertex], depth[neighbour]);
+
+				continue;
+			}
+
+			frames.pop_back();
+
+			if (frames.empty())
+				break;
+
+			uint32_t parent = frames.back().vertex;
+
+			low[parent] = std::min(low[parent], low[vertex]);
+
+			// parent separates the subtree of vertex, which is still on top of the stack.
+			if (low[vertex] >= depth[parent])
+			{
+				while (stack.back() != vertex)
+				{
+					components->Add(stack.back());
+					stack.pop_back();
+				}
+
+				components->Add(vertex);
+				stack.pop_back();
+				components->Add(parent);
+				components->Close();
+			}
+		}
+
+		stack.clear();
+	}
+}
+
+Vector<Pair<uint32_t, uint32_t>> UndirectedGraph::GetMinimumSpanningTree() const
+{
+	GRAPH_STATS_COLLECTOR();
+	Vector<Pair<Pair<uint32_t, uint32_t>, int32_t>> edgesCostVector;
+
+	{
+		GRAPH_STATS_PHASE("kruskal_edges");
+		edgesCostVector = GetEdgesVector();
+	}
+
+	{
+		GRAPH_STATS_PHASE("kruskal_sort");
+		std::sort(edgesCostVector.begin(), edgesCostVector.end(), EdgesCostComparator(true));
+	}
+
+	GRAPH_STATS_PHASE("kruskal_union_find");
+	GRAPH_STATS_ADD(EdgesScanned, edgesCostVector.size());
+	GRAPH_STATS_ADD(BytesAllocated, edgesCostVector.size() * sizeof(edgesCostVector[0]) + 2 * (GetVertices() + 1) * sizeof(uint32_t));
+
+	DisjointSet disjointSet(GetVertices());
+	Vector<Pair<uint32_t, uint32_t>> mstEdges;	// Minimum Spanning Tree edges
+
+	for (uint32_t i = 0; i < edgesCostVector.size(); ++i)
+	{
+		uint32_t x = edgesCostVector[i].first.first;
+		uint32_t y = edgesCostVector[i].first.second;
+
+		if (disjointSet.GetRoot(x) != disjointSet.GetRoot(y))
+		{
+			mstEdges.push_back(std::make_pair(x, y));
+			disjointSet.UnionSets(x, y);
+		}
+	}
+
+	return mstEdges;
+}
+
+Vector<Pair<uint32_t, uint32_t>> UndirectedGraph::GetMinimumSpanningTree(int32_t* cost) const
+{
+	GRAPH_STATS_COLLECTOR();
+	Vector<Pair<Pair<uint32_t, uint32_t>, int32_t>> edgesCostVector;
+
+	{
+		GRAPH_STATS_PHASE("kruskal_edges");
+		edgesCostVector = GetEdgesVector();
+	}
+
+	{
+		GRAPH_STATS_PHASE("kruskal_sort");
+		std::sort(edgesCostVector.begin(), edgesCostVector.end(), EdgesCostComparator(true));
+	}
+
+	GRAPH_STATS_PHASE("kruskal_union_find");
+	GRAPH_STATS_ADD(EdgesScanned, edgesCostVector.size());
+	GRAPH_STATS_ADD(BytesAllocated, edgesCostVector.size() * sizeof(edgesCostVector[0]) + 2 * (GetVertices() + 1) * sizeof(uint32_t));
+
+	DisjointSet disjointSet(GetVertices());
+	Vector<Pair<uint32_t, uint32_t>> mstEdges;	// Minimum Spanning Tree edges
+
+	for (uint32_t i = 0; i < edgesCostVector.size(); ++i)
+	{
+		int32_t _cost = edgesCostVector[i].second;
+		uint32_t x = edgesCostVector[i].first.first;
+		uint32_t y = edgesCostVector[i].first.second;
+
+		if (disjointSet.GetRoot(x) != disjointSet.GetRoot(y))
+		{
+			mstEdges.push_back(std::make_pair(x, y));
+			disjointSet.UnionSets(x, y);
+			*cost += _cost;
+		}
+	}
+
+	return mstEdges;
+}
+
+Vector<Pair<Pair<uint32_t, uint32_t>, int32_t>> UndirectedGraph::GetEdgesVector() const
+{
+	typedef Vector<Pair<Pair<uint32_t, uint32_t>, int32_t>>::const_iterator EdgesIterator;
+	Vector<Pair<Pair<uint32_t, uint32_t>, int32_t>> edges;
+
+	for (uint32_t i = 0; i < GetVertices(); ++i)
+		for (AdjacencyListConstIterator itr = _adjacencyList[i].begin(); itr != _adjacencyList[i].end(); ++itr)
+		{
+			bool found = false;
+
+			for (EdgesIterator iter = edges.begin(); iter != edges.end() && !found; ++iter)
+				if (((iter->first.first == i) && (iter->first.second == itr->first)) || 
+					((iter->first.second == i) && (iter->first.first == itr->first)))
+					found = true;
+
+			if (!found)
+				edges.push_back(std::make_pair(std::make_pair(i, itr->first), itr->second));
+		}
+
+	return edges;
+}
+
+void UndirectedGraph::ArticulationPoint(uint32_t const& vertex, Vector<bool>* visited, Vector<int>* parent,
+	Vector<uint32_t>* discoveryTime, Vector<uint32_t>* low, uint32_t* time, Vector<uint32_t>* articulationPoints) const
+{
+	if (!IsValidVertex(vertex))
+		return;
+
+	GRAPH_STATS_COLLECTOR();
+	GRAPH_STATS_RECURSION();
+	GRAPH_STATS_ADD(VerticesVisited, 1);
+	GRAPH_STATS_ADD(EdgesScanned, _adjacencyList[vertex].size());
+
+	uint32_t children = 0;
+	(*visited)[vertex] = true;
+	(*discoveryTime)[vertex] = (*low)[vertex] = ++(*time);
+
+	for (uint32_t i = 0; i < GetDegree(vertex); ++i)
+	{
+		if (!(*visited)[_adjacencyList[vertex][i].first])
+		{
+			children++;
+			(*parent)[_adjacencyList[vertex][i].first] = vertex;
+			ArticulationPoint(_adjacencyList[vertex][i].first, visited, parent, discoveryTime, low, time, articulationPoints);
+
+			if ((*low)[_adjacencyList[vertex][i].first] < (*low)[vertex])
+				(*low)[vertex] = (*low)[_adjacencyList[vertex][i].first];
+
+			if (((*parent)[vertex] == -1 && children > 1) ||
+				((*parent)[vertex] != -1 && (*low)[_adjacencyList[vertex][i].first] >= (*discoveryTime)[vertex]))
+				articulationPoints->push_back(vertex);
+		}
+		else if ((_adjacencyList[vertex][i].first != (*parent)[vertex]) && 
+			((*discoveryTime)[_adjacencyList[vertex][i].first] < (*low)[vertex]))
+			(*low)[vertex] = (*discoveryTime)[_adjacencyList[vertex][i].first];
+	}
+}
+
+bool UndirectedGraph::HasArticulationPoint(uint32_t const& vertex, Vector<bool>* visited, 
+	Vector<int>* parent, Vector<uint32_t>* discoveryTime, Vector<uint32_t>* low, uint32_t* time) const
+{
+	if (!IsValidVertex(vertex))
+		return false;
+
+	GRAPH_STATS_COLLECTOR();
+	GRAPH_STATS_RECURSION();
+	GRAPH_STATS_ADD(VerticesVisited, 1);
+	GRAPH_STATS_ADD(EdgesScanned, _adjacencyList[vertex].size());
+
+	uint32_t children = 0;
+	(*visited)[vertex] = true;
+	(*discoveryTime)[vertex] = (*low)[vertex] = ++(*time);
+
+	for (uint32_t i = 0; i < GetDegree(vertex); ++i)
+	{
+		if (!(*visited)[_adjacencyList[vertex][i].first])
+		{
+			children++;
+			(*parent)[_adjacencyList[vertex][i].first] = vertex;
+			
+			if (HasArticulationPoint(_adjacencyList[vertex][i].first, visited, parent, discoveryTime, low, time))
+				return true;
+
+			if ((*low)[_adjacencyList[vertex][i].first] < (*low)[vertex])
+				(*low)[vertex] = (*low)[_adjacencyList[vertex][i].first];
+
+			if (((*parent)[vertex] == -1 && children > 1) ||
+				((*parent)[vertex] != -1 && (*low)[_adjacencyList[vertex][i].first] >= (*discoveryTime)[vertex]))
+				return true;
+		}
+		else if ((_adjacencyList[vertex][i].first != (*parent)[vertex]) &&
+			((*discoveryTime)[_adjacencyList[vertex][i].first] < (*low)[vertex]))
+			(*low)[vertex] = (*discoveryTime)[_adjacencyList[vertex][i].first];
+	}
+
+	return false;
+}
+
+void UndirectedGraph::GetBiconnectedComponents(uint32_t const& vertex, Vector<int>* parent, Vector<uint32_t>* depth,
+	Vector<uint32_t>* low, uint32_t* time, Stack<uint32_t>* stack, Vector<Vector<uint32_t>>* biconnectedComponents) const
+{
+	if (!IsValidVertex(vertex))
+		return;
+
+	GRAPH_STATS_COLLECTOR();
+	GRAPH_STATS_RECURSION();
+	GRAPH_STATS_ADD(VerticesVisited, 1);
+	GRAPH_STATS_ADD(EdgesScanned, _adjacencyList[vertex].size());
+
+	stack->push(vertex);
+	(*depth)[vertex] = (*low)[vertex] = ++(*time);
+
+	for (AdjacencyListConstIterator neighbour = _adjacencyList[vertex].begin(); neighbour != _adjacencyList[vertex].end(); ++neighbour)
+	{
+		if (!(*depth)[neighbour->first])
+		{
+			(*parent)[neighbour->first] = vertex;
+			GetBiconnectedComponents(neighbour->first, parent, depth, low, time, stack, biconnectedComponents);
+			(*low)[vertex] = std::min((*low)[vertex], (*low)[neighbour->first]);
+
+			// Check if vertex is an articulation point.
+			if ((*low)[neighbour->first] >= (*depth)[vertex])
+			{
+				biconnectedComponents->push_back(Vector<uint32_t>());
+				Matrix<uint32_t>::reverse_iterator itr = biconnectedComponents->rbegin();
+				while (stack->top() != neighbour->first)
+				{
+					itr->push_back(stack->top());
+					stack->pop();
+				}
+				itr->push_back(neighbour->first);
+				stack->pop();
+				itr->push_back(vertex);
+			}
+		}
+		// Check if neighbour is an ancestor of vertex in dfs tree.
+		else if (neighbour->first != (*parent)[vertex])
+			(*low)[vertex] = std::min((*low)[vertex], (*depth)[neighbour->first]);
+	}
+}
+
+UndirectedGraph& UndirectedGraph::operator=(UndirectedGraph const& source)
+{
+	if (this == &source)
+		return *this;
+
+	_weighted = source._weighted;
+	_edges = source._edges;
+	_adjacencyList = source._adjacencyList;
+	_permutation = source._permutation;
+
+	return *this;
+}
+
+UndirectedGraph& UndirectedGraph::operator=(UndirectedGraph&& source)
+{
+	if (this != &source)
+		MoveFrom(source);
+
+	return *this;
+}
+
+UndirectedGraph UndirectedGraph::operator+(UndirectedGraph const& source)
+{
+	// TODO: better way to handle this
+	if (this->GetVertices() != source.GetVertices() || this->GetVertices() == 0)
+		return UndirectedGraph();
+
+	Matrix<Pair<uint32_t, int32_t>> buffer;
+	Matrix<Pair<uint32_t, int32_t>> const& arcs = GetAlignedArcs(source, &buffer);
+	UndirectedGraph sumGraph;
+
+	sumGraph._adjacencyList.resize(this->GetVertices());
+	sumGraph._permutation = _permutation;
+
+	for (uint32_t i = 0; i < sumGraph.GetVertices(); ++i)
+	{
+		for (uint32_t j = 0; j < this->GetDegree(i); ++j)
+			sumGraph._adjacencyList[i].push_back(this->_adjacencyList[i][j]);
+
+		for (uint32_t j = 0; j < arcs[i].size(); ++j)
+		{
+			bool found = false;
+
+			for (uint32_t k = 0; k < sumGraph.GetDegree(i); ++k)
+				if (sumGraph._adjacencyList[i][k] == arcs[i][j])
+					found = true;
+
+			if (!found)
+				sumGraph._adjacencyList[i].push_back(arcs[i][j]);
+		}
+	}
+
+	uint64_t arcCount = 0;
+
+	for (uint32_t i = 0; i < sumGraph.GetVertices(); ++i)
+		arcCount += sumGraph._adjacencyList[i].size();
+
+	sumGraph._weighted = _weighted;
+	sumGraph._edges = static_cast<uint32_t>(arcCount / 2);
+
+	return sumGraph;
+}
+
+UndirectedGraph UndirectedGraph::operator-(UndirectedGraph const& source)
+{
+	// TODO: better way to handle this
+	if (this->GetVertices() != source.GetVertices() || this->GetVertices() == 0)
+		return UndirectedGraph();
+
+	Matrix<Pair<uint32_t, int32_t>> buffer;
+	Matrix<Pair<uint32_t, int32_t>> const& arcs = GetAlignedArcs(source, &buffer);
+	UndirectedGraph difGraph;
+
+	difGraph._adjacencyList.resize(this->GetVertices());
+	difGraph._permutation = _permutation;
+
+	for (uint32_t i = 0; i < this->GetVertices(); ++i)
+	{
+		for (uint32_t j = 0; j < this->GetDegree(i); ++j)
+		{
+			bool found = false;
+			for (uint32_t k = 0; k < arcs[i].size(); ++k)
+				if (this->_adjacencyList[i][j] == arcs[i][k])
+					found = true;
+
+			if (!found)
+				difGraph._adjacencyList[i].push_back(this->_adjacencyList[i][j]);
+		}
+	}
+
+	uint64_t arcCount = 0;
+
+	for (uint32_t i = 0; i < difGraph.GetVertices(); ++i)
+		arcCount += difGraph._adjacencyList[i].size();
+
+	difGraph._weighted = _weighted;
+	difGraph._edges = static_cast<uint32_t>(arcCount / 2);
+
+	return difGraph;
+}
+
+bool UndirectedGraph::operator==(UndirectedGraph const& source) const
+{
+	return GetEdges() == source.GetEdges() && HasSameArcs(source);
+}
+
+std::istream& operator>>(std::istream& is, UndirectedGraph& graph)
+{
+	uint16_t weighted;
+	uint32_t vertices;
+	is >> vertices >> graph._edges >> weighted;
+
+	graph._adjacencyList.assign(vertices, Vector<Pair<uint32_t, int32_t>>());
+
+	graph._weighted = weighted ? true : false;
+	graph._permutation = VertexPermutation();
+
+	if (!graph.IsWeighted())
+		for (uint32_t i = 0; i < graph.GetEdges(); ++i)
+		{
+			uint32_t x, y;
+
+			is >> x >> y;
+			graph._adjacencyList[x].push_back(std::make_pair(y, 0));
+			graph._adjacencyList[y].push_back(std::make_pair(x, 0));
+		}
+	else
+		for (uint32_t i = 0; i < graph.GetEdges(); ++i)
+		{
+			uint32_t x, y, w;
+
+			is >> x >> y >> w;
+			graph._adjacencyList[x].push_back(std::make_pair(y, w));
+			graph._adjacencyList[y].push_back(std::make_pair(x, w));
+		}
+
+	return is;
+}
+
+std::ifstream& operator>>(std::ifstream& ifs, UndirectedGraph& graph)
+{
+	uint16_t weighted;
+	uint32_t vertices;
+	ifs >> vertices >> graph._edges >> weighted;
+
+	graph._adjacencyList.assign(vertices, Vector<Pair<uint32_t, int32_t>>());
+
+	graph._weighted = weighted ? true : false;
+	graph._permutation = VertexPermutation();
+
+	if (!graph.IsWeighted())
+		for (uint32_t i = 0; i < graph.GetEdges(); ++i)
+		{
+			uint32_t x, y;
+
+			ifs >> x >> y;
+			graph._adjacencyList[x].push_back(std::make_pair(y, 0));
+			graph._adjacencyList[y].push_back(std::make_pair(x, 0));
+		}
+	else
+		for (uint32_t i = 0; i < graph.GetEdges(); ++i)
+		{
+			uint32_t x, y, w;
+
+			ifs >> x >> y >> w;
+			graph._adjacencyList[x].push_back(std::make_pair(y, w));
+			graph._adjacencyList[y].push_back(std::make_pair(x, w));
+		}
+
+	return ifs;
+}
+
@@ -0,0 +1,353 @@
+#include "PCH.h"
+#include "VersionedGraph.h"
+#include "Instrumentation.h"
+
+uint32_t const VersionedGraph::CompactionDivisor;
+
+uint32_t VersionedGraph::Snapshot::GetDegree(uint32_t const& vertex) const
+{
+	uint32_t degree = 0;
+
+	ForEachNeighbour(vertex, [&](uint32_t const&, int32_t const&) { ++degree; });
+
+	return degree;
+}
+
+bool VersionedGraph::Snapshot::HasArc(uint32_t const& x, uint32_t const& y) const
+{
+	if (x >= GetVertices() || y >= GetVertices())
+		return false;
+
+	Change const* change = FindChanges(x);
+	Change const* changeEnd = _version->changes.data() + _version->changes.size();
+	uint64_t arc;
+
+	for (; change != changeEnd && change->source == x; ++change)
+		if (change->target == y)
+			return !change->deleted;
+
+	return FindBaseArc(*_version->base, x, y, &arc);
+}
+
+Vector<uint32_t> VersionedGraph::Snapshot::BreadthFirstSearch(uint32_t const& vertex) const
+{
+	Vector<uint32_t> order;
+
+	if (vertex >= GetVertices())
+		return order;
+
+	GRAPH_STATS_COLLECTOR();
+
+	Vector<bool> visited(GetVertices(), false);
+
+	visited[vertex] = true;
+	order.push_back(vertex);
+
+	// The element is copied out of the order, which the callback grows.
+	for (uint64_t head = 0; head < order.size(); ++head)
+	{
+		uint32_t element = order[head];
+
+		GRAPH_STATS_ADD(VerticesVisited, 1);
+
+		ForEachNeighbour(element, [&](uint32_t const& target, int32_t const&)
+			{
+				if (!visited[target])
+				{
+					visited[target] = true;
+					order.push_back(target);
+				}
+			});
+	}
+
+	return order;
+}
+
+EdgesVector VersionedGraph::Snapshot::GetEdges() const
+{
+	EdgesVector edges;
+
+	for (uint32_t i = 0; i < GetVertices(); ++i)
+		ForEachNeighbour(i, [&](uint32_t const& target, int32_t const& weight)
+			{
+				if (IsDirected() || i <= target)
+					edges.push_back(std::make_pair(std::make_pair(i, target), weight));
+			});
+
+	return edges;
+}
+
+VersionedGraph::Change const* VersionedGraph::Snapshot::FindChanges(uint32_t const& vertex) const
+{
+	Vector<Change> const& changes = _version->changes;
+
+	Vector<Change>::const_iterator itr = std::lower_bound(changes.begin(), changes.end(), vertex,
+		[](Change const& change, uint32_t const& source) { return change.source < source; });
+
+	return changes.data() + (itr - changes.begin());
+}
+
+VersionedGraph::VersionedGraph(UndirectedGraph const& graph, uint32_t const& maxReaders) : VersionedGraph(graph, false, maxReaders)
+{
+}
+
+VersionedGraph::VersionedGraph(DirectedGraph const& graph, uint32_t const& maxReaders) : VersionedGraph(graph, true, maxReaders)
+{
+}
+
+VersionedGraph::VersionedGraph(Graph const& graph, bool directed, uint32_t const& maxReaders) : _directed(directed),
+	_weighted(graph.IsWeighted()), _current(nullptr), _epoch(1),
+	_slotCount(std::max<uint32_t>(maxReaders, 1)), _slotStorage(new char[_slotCount * sizeof(Slot) + alignof(Slot)]),
+	_slots(nullptr)
+{
+	std::shared_ptr<Base> base = std::make_shared<Base>();
+	Vector<Pair<uint32_t, int32_t>> row;
+
+	base->offsets.assign(graph.GetVertices() + 1, 0);
+
+	// stable_sort keeps the parallel arcs in adjacency order, so unique keeps the first one.
+	for (uint32_t i = 0; i < graph.GetVertices(); ++i)
+	{
+		row = graph.GetNeighbours(i);
+		std::stable_sort(row.begin(), row.end(),
+			[](Pair<uint32_t, int32_t> const& x, Pair<uint32_t, int32_t> const& y) { return x.first < y.first; });
+		row.erase(std::unique(row.begin(), row.end(),
+			[](Pair<uint32_t, int32_t> const& x, Pair<uint32_t, int32_t> const& y) { return x.first == y.first; }), row.end());
+
+		for (uint32_t j = 0; j < row.size(); ++j)
+		{
+			base->targets.push_back(row[j].first);
+			base->weights.push_back(row[j].second);
+		}
+
+		base->offsets[i + 1] = base->targets.size();
+	}
+
+	// Before C++17 new only aligns for the fundamental types, so the slots are placed on the first cache line boundary.
+	void* storage = _slotStorage.get();
+	size_t space = _slotCount * sizeof(Slot) + alignof(Slot);
+
+	_slots = static_cast<Slot*>(std::align(alignof(Slot), _slotCount * sizeof(Slot), storage, space));
+
+	for (uint32_t i = 0; i < _slotCount; ++i)
+	{
+		new (&_slots[i]) Slot();
+		_slots[i].epoch = 0;
+	}
+
+	Version* version = new Version();
+
+	version->number = 0;
+	version->arcs = base->targets.size();
+	version->base = base;
+	_current = version;
+}
+
+VersionedGraph::~VersionedGraph()
+{
+	for (uint32_t i = 0; i < _retired.size(); ++i)
+		delete _retired[i].second;
+
+	delete _current.load();
+}
+
+VersionedGraph::Snapshot VersionedGraph::GetSnapshot() const
+{
+	uint32_t start = static_cast<uint32_t>(std::hash<std::thread::id>()(std::this_thread::get_id()) % _slotCount);
+
+	for (;;)
+	{
+		for (uint32_t i = 0; i < _slotCount; ++i)
+		{
+			uint32_t slot = (start + i) % _slotCount;
+			uint64_t expected = 0;
+
+			// Announcing the epoch before loading the version means a writer that has not seen the announcement yet
+			// already published the version loaded here, so it cannot free it.
+			if (_slots[slot].epoch.load() == 0 && _slots[slot].epoch.compare_exchange_strong(expected, _epoch.load()))
+				return Snapshot(this, slot, _current.load());
+		}
+
+		std::this_thread::yield();
+	}
+}
+
+uint64_t VersionedGraph::Apply(Vector<EdgeUpdate> const& batch)
+{
+	std::lock_guard<std::mutex> lock(_writerMutex);
+
+	Version const& current = *_current.load();
+	Base const& base = *current.base;
+	uint32_t vertices = static_cast<uint32_t>(base.offsets.size() - 1);
+	Vector<Change> updates;
+
+	// An undirected edge becomes its two arcs.
+	for (uint64_t i = 0; i < batch.size(); ++i)
+	{
+		if (batch[i].x >= vertices || batch[i].y >= vertices)
+			continue;
+
+		Change update = { batch[i].x, batch[i].y, _weighted ? batch[i].weight : 0, batch[i].type == EdgeUpdate::Delete };
+
+		updates.push_back(update);
+
+		if (!_directed && batch[i].x != batch[i].y)
+		{
+			std::swap(update.source, update.target);
+			updates.push_back(update);
+		}
+	}
+
+	// The last update of an arc wins.
+	std::stable_sort(updates.begin(), updates.end(), [](Change const& x, Change const& y)
+		{ return x.source < y.source || (x.source == y.source && x.target < y.target); });
+
+	Version* version = new Version();
+	Vector<Change> const& changes = current.changes;
+	uint64_t next = 0;
+
+	version->number = current.number + 1;
+	version->arcs = current.arcs;
+	version->base = current.base;
+	version->changes.reserve(changes.size() + updates.size());
+
+	for (uint64_t i = 0; i < updates.size(); ++i)
+	{
+		if (i + 1 < updates.size() && updates[i + 1].source == updates[i].source && updates[i + 1].target == updates[i].target)
+			continue;
+
+		Change const& update = updates[i];
+
+		while (next < changes.size() && (changes[next].source < update.source ||
+			(changes[next].source == update.source && changes[next].target < update.target)))
+			version->changes.push_back(changes[next++]);
+
+		uint64_t arc;
+		bool inBase = FindBaseArc(base, update.source, update.target, &arc);
+		bool wasLive = inBase;
+
+		if (next < changes.size() && changes[next].source == update.source && changes[next].target == update.target)
+			wasLive = !changes[next++].deleted;
+
+		// A deleted arc that is not in the base simply leaves the list.
+		if (!update.deleted || inBase)
+			version->changes.push_back(update);
+
+		if (wasLive && update.deleted)
+			--version->arcs;
+		else if (!wasLive && !update.deleted)
+			++version->arcs;
+	}
+
+	version->changes.insert(version->changes.end(), changes.begin() + next, changes.end());
+
+	if (version->changes.size() * CompactionDivisor > base.targets.size() + vertices)
+	{
+		version->base = BuildBase(*version, vertices);
+		version->changes.clear();
+		version->changes.shrink_to_fit();
+	}
+
+	Publish(version);
+
+	return version->number;
+}
+
+void VersionedGraph::Compact()
+{
+	std::lock_guard<std::mutex> lock(_writerMutex);
+
+	Version const& current = *_current.load();
+
+	if (current.changes.empty())
+		return;
+
+	Version* version = new Version();
+
+	version->number = current.number + 1;
+	version->arcs = current.arcs;
+	version->base = BuildBase(current, static_cast<uint32_t>(current.base->offsets.size() - 1));
+
+	Publish(version);
+}
+
+uint32_t VersionedGraph::GetRetired() const
+{
+	std::lock_guard<std::mutex> lock(_writerMutex);
+
+	return static_cast<uint32_t>(_retired.size());
+}
+
+bool VersionedGraph::FindBaseArc(Base const& base, uint32_t const& source, uint32_t const& target, uint64_t* arc)
+{
+	Vector<uint32_t>::const_iterator begin = base.targets.begin() + base.offsets[source];
+	Vector<uint32_t>::const_iterator end = base.targets.begin() + base.offsets[source + 1];
+	Vector<uint32_t>::const_iterator itr = std::lower_bound(begin, end, target);
+
+	*arc = static_cast<uint64_t>(itr - base.targets.begin());
+
+	return itr != end && *itr == target;
+}
+
+std::shared_ptr<VersionedGraph::Base const> VersionedGraph::BuildBase(Version const& version, uint32_t const& vertices)
+{
+	GRAPH_STATS_COLLECTOR();
+	GRAPH_STATS_PHASE("versioned_compaction");
+
+	std::shared_ptr<Base> base = std::make_shared<Base>();
+
+	// The snapshot merge already yields the arcs of a vertex in ascending order.
+	Snapshot view(nullptr, 0, &version);
+
+	base->offsets.assign(vertices + 1, 0);
+	base->targets.reserve(version.arcs);
+	base->weights.reserve(version.arcs);
+
+	for (uint32_t i = 0; i < vertices; ++i)
+	{
+		view.ForEachNeighbour(i, [&](uint32_t const& target, int32_t const& weight)
+			{
+				base->targets.push_back(target);
+				base->weights.push_back(weight);
+			});
+
+		base->offsets[i + 1] = base->targets.size();
+	}
+
+	GRAPH_STATS_ADD(BytesAllocated, base->offsets.size() * sizeof(uint64_t) + base->targets.size() * 2 * sizeof(uint32_t));
+
+	return base;
+}
+
+void VersionedGraph::Publish(Version* version)
+{
+	Version* previous = _current.exchange(version);
+
+	// Snapshots announced in an epoch after this one load the new version.
+	_retired.push_back(std::make_pair(_epoch.fetch_add(1), previous));
+
+	Reclaim();
+}
+
+void VersionedGraph::Reclaim()
+{
+	uint64_t oldest = UINT64_MAX;
+
+	for (uint32_t i = 0; i < _slotCount; ++i)
+	{
+		uint64_t epoch = _slots[i].epoch.load();
+
+		if (epoch)
+			oldest = std::min(oldest, epoch);
+	}
+
+	uint64_t kept = 0;
+
+	for (uint64_t i = 0; i < _retired.size(); ++i)
+		if (_retired[i].first < oldest)
+			delete _retired[i].second;
+		else
+			_retired[kept++] = _retired[i];
+
+	_retired.resize(kept);
+}
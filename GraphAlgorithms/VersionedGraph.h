@@ -0,0 +1,185 @@
+#ifndef _VERSIONED_GRAPH_H
+#define _VERSIONED_GRAPH_H
+
+#include "PCH.h"
+#include "UndirectedGraph.h"
+#include "DirectedGraph.h"
+
+struct EdgeUpdate
+{
+	enum Type { Insert, Delete };
+
+	EdgeUpdate(Type const& type, uint32_t const& x, uint32_t const& y, int32_t const& weight = 0) : type(type), x(x),
+		y(y), weight(weight) { }
+
+	Type type;
+	uint32_t x;
+	uint32_t y;
+	int32_t weight;		// Insert only, an insert of an existing edge replaces its weight.
+};
+
+// Multi-version graph for readers that run alongside a writer. Every batch of updates publishes a new immutable
+// version: a sorted compressed base shared with the previous versions plus a sorted list of the arcs the batches
+// inserted, reweighted or deleted since the base was built. Once that list outgrows an eighth of the base the writer
+// folds it into a new base. Readers take a Snapshot, which pins the version current at that time for as long as it
+// lives and never blocks or is blocked by the writer; a version is freed once every snapshot that could still see it
+// is gone (epoch based reclamation). Reclamation goes by the oldest live snapshot, so a long traversal also holds
+// back the versions published while it runs, they share the base and only cost their change lists.
+//
+// The graph is simple: parallel arcs of the source graph are merged, the first weight wins, and an undirected self
+// loop is a single arc. The vertex count is fixed, updates with an invalid vertex are ignored.
+class VersionedGraph
+{
+	private:
+		struct Base
+		{
+			Vector<uint64_t> offsets;
+			Vector<uint32_t> targets;		// Ascending per vertex.
+			Vector<int32_t> weights;
+		};
+
+		// An arc the batches touched since the base was built, sorted by (source, target).
+		struct Change
+		{
+			uint32_t source;
+			uint32_t target;
+			int32_t weight;
+			bool deleted;		// Only base arcs are deleted, a deleted change arc is dropped from the list.
+		};
+
+		struct Version
+		{
+			uint64_t number;
+			uint64_t arcs;
+			std::shared_ptr<Base const> base;
+			Vector<Change> changes;
+		};
+
+	public:
+		// A pinned version. It is move only and must not outlive the VersionedGraph.
+		class Snapshot
+		{
+			public:
+				Snapshot(Snapshot&& source) : _graph(source._graph), _slot(source._slot), _version(source._version)
+				{
+					source._graph = nullptr;
+				}
+
+				~Snapshot() { if (_graph) _graph->Release(_slot); }
+
+				uint64_t GetVersion() const { return _version->number; }
+				uint32_t GetVertices() const { return static_cast<uint32_t>(_version->base->offsets.size() - 1); }
+				uint64_t GetArcs() const { return _version->arcs; }
+				bool IsDirected() const { return _graph->_directed; }
+				bool IsWeighted() const { return _graph->_weighted; }
+
+				// Calls function(target, weight) for the out arcs of vertex in ascending target order.
+				template <class _Function>
+				void ForEachNeighbour(uint32_t const& vertex, _Function const& function) const
+				{
+					Base const& base = *_version->base;
+					Change const* change = FindChanges(vertex);
+					Change const* changeEnd = _version->changes.data() + _version->changes.size();
+					uint64_t arc = base.offsets[vertex];
+					uint64_t arcEnd = base.offsets[vertex + 1];
+
+					for (;;)
+					{
+						bool hasChange = change != changeEnd && change->source == vertex;
+
+						if (arc < arcEnd && (!hasChange || base.targets[arc] < change->target))
+						{
+							function(base.targets[arc], base.weights[arc]);
+							++arc;
+						}
+						else if (hasChange)
+						{
+							if (arc < arcEnd && base.targets[arc] == change->target)
+								++arc;
+
+							if (!change->deleted)
+								function(change->target, change->weight);
+
+							++change;
+						}
+						else
+							break;
+					}
+				}
+
+				uint32_t GetDegree(uint32_t const& vertex) const;
+				bool HasArc(uint32_t const& x, uint32_t const& y) const;
+
+				Vector<uint32_t> BreadthFirstSearch(uint32_t const& vertex) const;
+
+				// The edges of the version, an undirected edge once from its smaller endpoint. Feed them to the
+				// UndirectedGraph or DirectedGraph constructor to run the other algorithms on the version.
+				EdgesVector GetEdges() const;
+
+			private:
+				friend class VersionedGraph;
+
+				Snapshot(VersionedGraph const* graph, uint32_t const& slot, Version const* version) : _graph(graph),
+					_slot(slot), _version(version) { }
+
+				Snapshot(Snapshot const&);
+				Snapshot& operator=(Snapshot const&);
+
+				Change const* FindChanges(uint32_t const& vertex) const;
+
+				VersionedGraph const* _graph;
+				uint32_t _slot;
+				Version const* _version;
+		};
+
+		// maxReaders bounds the snapshots alive at once, GetSnapshot waits for a free slot beyond that.
+		explicit VersionedGraph(UndirectedGraph const& graph, uint32_t const& maxReaders = 64);
+		explicit VersionedGraph(DirectedGraph const& graph, uint32_t const& maxReaders = 64);
+		~VersionedGraph();
+
+		Snapshot GetSnapshot() const;
+
+		// Applies the batch in order and publishes it as one version, whose number it returns. Writers are serialised.
+		uint64_t Apply(Vector<EdgeUpdate> const& batch);
+
+		// Folds the changes into a new base now instead of waiting for the threshold.
+		void Compact();
+
+		uint64_t GetVersion() const { return _current.load()->number; }
+
+		// Versions replaced but still pinned by a snapshot.
+		uint32_t GetRetired() const;
+
+	private:
+		static uint32_t const CompactionDivisor = 8;
+
+		// One slot per cache line, the readers do not share them.
+		struct alignas(64) Slot
+		{
+			std::atomic<uint64_t> epoch;	// 0 when free, else the epoch the snapshot was taken in.
+		};
+
+		VersionedGraph(Graph const& graph, bool directed, uint32_t const& maxReaders);
+		VersionedGraph(VersionedGraph const&);
+		VersionedGraph& operator=(VersionedGraph const&);
+
+		static bool FindBaseArc(Base const& base, uint32_t const& source, uint32_t const& target, uint64_t* arc);
+		static std::shared_ptr<Base const> BuildBase(Version const& version, uint32_t const& vertices);
+
+		void Publish(Version* version);
+		void Reclaim();
+		void Release(uint32_t const& slot) const { _slots[slot].epoch = 0; }
+
+		bool _directed;
+		bool _weighted;
+		std::atomic<Version*> _current;
+		std::atomic<uint64_t> _epoch;
+		uint32_t _slotCount;
+		std::unique_ptr<char[]> _slotStorage;	// The slots, with room to start them on a cache line.
+		Slot* _slots;
+
+		mutable std::mutex _writerMutex;
+		Vector<Pair<uint64_t, Version*>> _retired;	// Replaced versions with the epoch they were replaced in.
+};
+
+#endif
@@ -0,0 +1,189 @@
+#include "PCH.h"
+#include "VertexOrdering.h"
+#include "Graph.h"
+
+VertexPermutation::VertexPermutation(Vector<uint32_t> const& newToOriginal) : _originalToNew(newToOriginal.size()),
+	_newToOriginal(newToOriginal)
+{
+	for (uint32_t i = 0; i < _newToOriginal.size(); ++i)
+		_originalToNew[_newToOriginal[i]] = i;
+}
+
+VertexPermutation VertexPermutation::Compute(Matrix<Pair<uint32_t, int32_t>> const& adjacencyList, VertexOrder const& order)
+{
+	switch (order)
+	{
+		case VertexOrder::Degree:
+			return VertexPermutation(GetDegreeOrder(adjacencyList));
+		case VertexOrder::ReverseCuthillMcKee:
+			return VertexPermutation(GetBreadthFirstOrder(adjacencyList, true));
+		case VertexOrder::BreadthFirst:
+			return VertexPermutation(GetBreadthFirstOrder(adjacencyList, false));
+	}
+
+	return VertexPermutation();
+}
+
+Vector<uint32_t> VertexPermutation::ToInternal(Vector<uint32_t> const& vertices) const
+{
+	if (IsIdentity())
+		return vertices;
+
+	Vector<uint32_t> internalVertices(vertices.size());
+
+	for (uint32_t i = 0; i < vertices.size(); ++i)
+		internalVertices[i] = _originalToNew[vertices[i]];
+
+	return internalVertices;
+}
+
+Vector<uint32_t> VertexPermutation::ToOriginal(Vector<uint32_t> const& vertices) const
+{
+	if (IsIdentity())
+		return vertices;
+
+	Vector<uint32_t> originalVertices(vertices.size());
+
+	for (uint32_t i = 0; i < vertices.size(); ++i)
+		originalVertices[i] = _newToOriginal[vertices[i]];
+
+	return originalVertices;
+}
+
+Matrix<uint32_t> VertexPermutation::ToOriginal(Matrix<uint32_t> const& vertices) const
+{
+	if (IsIdentity())
+		return vertices;
+
+	Matrix<uint32_t> originalVertices(vertices.size());
+
+	for (uint32_t i = 0; i < vertices.size(); ++i)
+		originalVertices[i] = ToOriginal(vertices[i]);
+
+	return originalVertices;
+}
+
+VertexPermutation VertexPermutation::Then(VertexPermutation const& next) const
+{
+	if (IsIdentity())
+		return next;
+
+	if (next.IsIdentity())
+		return *this;
+
+	Vector<uint32_t> newToOriginal(next._newToOriginal.size());
+
+	for (uint32_t i = 0; i < newToOriginal.size(); ++i)
+		newToOriginal[i] = _newToOriginal[next._newToOriginal[i]];
+
+	return VertexPermutation(newToOriginal);
+}
+
+VertexPermutation& VertexPermutation::operator=(VertexPermutation const& source)
+{
+	if (this == &source)
+		return *this;
+
+	_originalToNew = source._originalToNew;
+	_newToOriginal = source._newToOriginal;
+
+	return *this;
+}
+
+VertexPermutation& VertexPermutation::operator=(VertexPermutation&& source)
+{
+	if (this == &source)
+		return *this;
+
+	_originalToNew = std::move(source._originalToNew);
+	_newToOriginal = std::move(source._newToOriginal);
+
+	return *this;
+}
+
+Vector<uint32_t> VertexPermutation::GetDegrees(Matrix<Pair<uint32_t, int32_t>> const& adjacencyList)
+{
+	// In + out degree of every vertex in one pass. Undirected graphs count every edge twice, which keeps the order.
+	Vector<uint32_t> degrees(adjacencyList.size(), 0);
+
+	for (uint32_t i = 0; i < adjacencyList.size(); ++i)
+	{
+		degrees[i] += static_cast<uint32_t>(adjacencyList[i].size());
+
+		for (AdjacencyListConstIterator itr = adjacencyList[i].begin(); itr != adjacencyList[i].end(); ++itr)
+			++degrees[itr->first];
+	}
+
+	return degrees;
+}
+
+Vector<uint32_t> VertexPermutation::GetDegreeOrder(Matrix<Pair<uint32_t, int32_t>> const& adjacencyList)
+{
+	Vector<uint32_t> degrees = GetDegrees(adjacencyList);
+	Vector<uint32_t> order(adjacencyList.size());
+
+	for (uint32_t i = 0; i < order.size(); ++i)
+		order[i] = i;
+
+	std::stable_sort(order.begin(), order.end(), [&degrees](uint32_t const& first, uint32_t const& second)
+		{ return degrees[first] > degrees[second]; });
+
+	return order;
+}
+
+Vector<uint32_t> VertexPermutation::GetBreadthFirstOrder(Matrix<Pair<uint32_t, int32_t>> const& adjacencyList, bool cuthillMcKee)
+{
+	uint32_t vertices = static_cast<uint32_t>(adjacencyList.size());
+	Vector<uint32_t> degrees;
+	Vector<uint32_t> roots(vertices);
+	Vector<bool> visited(vertices, false);
+	Vector<uint32_t> order;
+
+	order.reserve(vertices);
+
+	for (uint32_t i = 0; i < vertices; ++i)
+		roots[i] = i;
+
+	// Cuthill-McKee starts every component from its lowest degree vertex and visits neighbours by ascending degree.
+	if (cuthillMcKee)
+	{
+		degrees = GetDegrees(adjacencyList);
+		std::stable_sort(roots.begin(), roots.end(), [&degrees](uint32_t const& first, uint32_t const& second)
+			{ return degrees[first] < degrees[second]; });
+	}
+
+	for (uint32_t i = 0; i < vertices; ++i)
+	{
+		if (visited[roots[i]])
+			continue;
+
+		uint32_t head = static_cast<uint32_t>(order.size());
+
+		order.push_back(roots[i]);
+		visited[roots[i]] = true;
+
+		// order doubles as the BFS queue: [head, order.size()) are the discovered but unexpanded vertices.
+		while (head < order.size())
+		{
+			uint32_t element = order[head++];
+			uint32_t firstNeighbour = static_cast<uint32_t>(order.size());
+
+			for (AdjacencyListConstIterator itr = adjacencyList[element].begin(); itr != adjacencyList[element].end(); ++itr)
+				if (!visited[itr->first])
+				{
+					visited[itr->first] = true;
+					order.push_back(itr->first);
+				}
+
+			if (cuthillMcKee)
+				std::stable_sort(order.begin() + firstNeighbour, order.end(), [&degrees](uint32_t const& first, uint32_t const& second)
+					{ return degrees[first] < degrees[second]; });
+		}
+	}
+
+	if (cuthillMcKee)
+		std::reverse(order.begin(), order.end());
+
+	return order;
+}
+
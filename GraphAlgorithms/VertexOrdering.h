@@ -0,0 +1,72 @@
+#ifndef _VERTEX_ORDERING_H
+#define _VERTEX_ORDERING_H
+
+#include "PCH.h"
+
+enum class VertexOrder
+{
+	Degree,					// Descending degree, hubs first.
+	ReverseCuthillMcKee,	// Bandwidth reducing order, every component started from a minimum degree vertex.
+	BreadthFirst			// Breadth-first discovery order of every component.
+};
+
+// Maps the vertex ids read from the input (original ids) to the ids used internally after a reordering.
+class VertexPermutation
+{
+	public:
+		VertexPermutation() { }
+		explicit VertexPermutation(Vector<uint32_t> const& newToOriginal);
+		VertexPermutation(VertexPermutation const& source) : _originalToNew(source._originalToNew),
+			_newToOriginal(source._newToOriginal) { }
+		VertexPermutation(VertexPermutation&& source) : _originalToNew(std::move(source._originalToNew)),
+			_newToOriginal(std::move(source._newToOriginal)) { }
+
+		static VertexPermutation Compute(Matrix<Pair<uint32_t, int32_t>> const& adjacencyList, VertexOrder const& order);
+
+		bool IsIdentity() const { return _newToOriginal.empty(); }
+
+		uint32_t ToInternal(uint32_t const& vertex) const { return IsIdentity() ? vertex : _originalToNew[vertex]; }
+		uint32_t ToOriginal(uint32_t const& vertex) const { return IsIdentity() ? vertex : _newToOriginal[vertex]; }
+
+		Vector<uint32_t> ToInternal(Vector<uint32_t> const& vertices) const;
+		Vector<uint32_t> ToOriginal(Vector<uint32_t> const& vertices) const;
+		Matrix<uint32_t> ToOriginal(Matrix<uint32_t> const& vertices) const;
+
+		// Rearranges a per-vertex array indexed by internal ids (e.g. GetRoadDistance) so it is indexed by original ids.
+		template <class _Type>
+		Vector<_Type> ToOriginalOrder(Vector<_Type> const& values) const;
+
+		// Returns the permutation equivalent to applying this one and then next.
+		VertexPermutation Then(VertexPermutation const& next) const;
+
+		Vector<uint32_t> const& GetOriginalToNew() const { return _originalToNew; }
+		Vector<uint32_t> const& GetNewToOriginal() const { return _newToOriginal; }
+
+		VertexPermutation& operator=(VertexPermutation const& source);
+		VertexPermutation& operator=(VertexPermutation&& source);
+
+	private:
+		static Vector<uint32_t> GetDegrees(Matrix<Pair<uint32_t, int32_t>> const& adjacencyList);
+
+		static Vector<uint32_t> GetDegreeOrder(Matrix<Pair<uint32_t, int32_t>> const& adjacencyList);
+		static Vector<uint32_t> GetBreadthFirstOrder(Matrix<Pair<uint32_t, int32_t>> const& adjacencyList, bool cuthillMcKee);
+
+		Vector<uint32_t> _originalToNew, _newToOriginal;
+};
+
+template <class _Type>
+Vector<_Type> VertexPermutation::ToOriginalOrder(Vector<_Type> const& values) const
+{
+	if (IsIdentity())
+		return values;
+
+	Vector<_Type> reordered(values.size());
+
+	for (uint32_t i = 0; i < values.size(); ++i)
+		reordered[_newToOriginal[i]] = values[i];
+
+	return reordered;
+}
+
+#endif
+
@@ -0,0 +1,1333 @@
+#include "PCH.h"
+#include "AllPairsShortestPaths.h"
+#include "BellmanFord.h"
+#include "BipartiteMatching.h"
+#include "BlockCutTree.h"
+#include "Centrality.h"
+#include "ContractionHierarchy.h"
+#include "CoreDecomposition.h"
+#include "DirectedGraph.h"
+#include "EulerianPath.h"
+#include "GraphFingerprint.h"
+#include "GraphGenerator.h"
+#include "HamiltonianCycle.h"
+#include "MaximumFlow.h"
+#include "PageRank.h"
+#include "QueryExecutor.h"
+#include "PointToPointSearch.h"
+#include "TopologicalOrder.h"
+#include "UndirectedGraph.h"
+#include "VersionedGraph.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+// Regression checks for the library, run by "make -C Tests test"; the exit code is the number of failed checks.
+static uint32_t failures = 0;
+
+#define CHECK(condition) \
+	do \
+	{ \
+		if (!(condition)) \
+		{ \
+			std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK(" #condition ") failed" << std::endl; \
+			++failures; \
+		} \
+	} while (false)
+
+static EdgesVector GetEdges()
+{
+	// A path with a pendant triangle, so every reordering moves vertices.
+	EdgesVector edges;
+	uint32_t const pairs[][2] = { { 0, 1 }, { 1, 2 }, { 2, 3 }, { 3, 4 }, { 4, 5 }, { 5, 3 }, { 1, 6 } };
+
+	for (uint32_t i = 0; i < sizeof(pairs) / sizeof(pairs[0]); ++i)
+		edges.push_back(std::make_pair(std::make_pair(pairs[i][0], pairs[i][1]), static_cast<int32_t>(i + 1)));
+
+	return edges;
+}
+
+static bool HasArc(Graph const& graph, uint32_t const& x, uint32_t const& y)
+{
+	for (AdjacencyListConstIterator itr = graph.GetNeighbours(x).begin(); itr != graph.GetNeighbours(x).end(); ++itr)
+		if (itr->first == y)
+			return true;
+
+	return false;
+}
+
+// Length of the path over the cheapest arcs between its consecutive vertices, -1 when one of them is missing.
+static int64_t GetPathLength(Graph const& graph, Vector<uint32_t> const& path)
+{
+	int64_t length = 0;
+
+	for (uint32_t i = 0; i + 1 < path.size(); ++i)
+	{
+		int64_t cheapest = -1;
+
+		for (AdjacencyListConstIterator itr = graph.GetNeighbours(path[i]).begin(); itr != graph.GetNeighbours(path[i]).end(); ++itr)
+			if (itr->first == path[i + 1] && (cheapest < 0 || itr->second < cheapest))
+				cheapest = itr->second;
+
+		if (cheapest < 0)
+			return -1;
+
+		length += cheapest;
+	}
+
+	return length;
+}
+
+template <class _Graph>
+static void TestReorderedOperands()
+{
+	EdgesVector edges = GetEdges();
+	EdgesVector half(edges.begin(), edges.begin() + edges.size() / 2);
+	_Graph graph(7, edges, true);
+	_Graph reordered(graph);
+	_Graph reorderedHalf(7, half, true);
+
+	reordered.Reorder(VertexOrder::Degree);
+	reorderedHalf.Reorder(VertexOrder::ReverseCuthillMcKee);
+
+	CHECK(!reordered.GetPermutation().IsIdentity());
+	CHECK(graph == reordered);
+	CHECK(reordered == graph);
+	CHECK((graph - reordered).GetEdges() == 0);
+	CHECK((graph + reordered) == graph);
+
+	// The results keep the left operand's ids.
+	_Graph sum = reorderedHalf + graph;
+	_Graph difference = graph - reorderedHalf;
+
+	CHECK(sum.GetPermutation().GetNewToOriginal() == reorderedHalf.GetPermutation().GetNewToOriginal());
+	CHECK(sum == graph);
+	CHECK(difference.GetEdges() == edges.size() - half.size());
+	CHECK(difference == _Graph(7, EdgesVector(edges.begin() + half.size(), edges.end()), true));
+	CHECK(graph != reorderedHalf);
+}
+
+template <class _Graph>
+static void TestReadResetsPermutation()
+{
+	_Graph graph(7, GetEdges(), true);
+	std::istringstream input("3 2 0\n0 1\n1 2\n");
+
+	graph.Reorder(VertexOrder::Degree);
+	input >> graph;
+
+	CHECK(graph.GetPermutation().IsIdentity());
+	CHECK(graph.GetVertices() == 3);
+	CHECK(graph == _Graph(3, EdgesVector{ { { 0, 1 }, 0 }, { { 1, 2 }, 0 } }));
+}
+
+static void TestGenerator()
+{
+	GraphGenerator generator(7);
+
+	generator.SetWeights(1, 9);
+
+	Tree tree = generator.GetRandomTree(50);
+
+	CHECK(tree.IsWeighted());
+	CHECK(tree.GetEdges() == 49);
+
+	// Probability 1 is the complete graph, a tiny one must not round to it.
+	CHECK(generator.GetGnpEdges(20, 1.0, false).size() == 190);
+	CHECK(generator.GetGnpEdges(20, 1.0, true).size() == 380);
+	CHECK(generator.GetGnpEdges(1000, 1e-300, true).empty());
+}
+
+template <class _Graph>
+static void TestContractionHierarchy()
+{
+	_Graph graph(7, GetEdges(), true);
+	ContractionHierarchy hierarchy(graph, 2);
+	ContractionHierarchy::Workspace workspace;
+	PointToPointSearch search(graph);
+	char const* file = "ContractionHierarchy.bin";
+
+	for (uint32_t i = 0; i < graph.GetVertices(); ++i)
+		for (uint32_t j = 0; j < graph.GetVertices(); ++j)
+			CHECK(hierarchy.Query(i, j, &workspace) == search.Query(i, j));
+
+	{
+		std::ofstream ofs(file, std::ios::binary);
+
+		hierarchy.Save(ofs);
+	}
+
+	std::string bytes;
+
+	{
+		std::ifstream ifs(file, std::ios::binary);
+
+		bytes.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+	}
+
+	// Header of 28 bytes, then the ranks, the upward offsets and the upward arcs of 12 bytes each.
+	auto load = [&](uint64_t const& offset, uint32_t const& value)
+		{
+			std::string corrupt(bytes);
+			ContractionHierarchy loaded;
+
+			std::memcpy(&corrupt[offset], &value, sizeof(value));
+
+			{
+				std::ofstream ofs(file, std::ios::binary);
+
+				ofs.write(corrupt.data(), corrupt.size());
+			}
+
+			std::ifstream ifs(file, std::ios::binary);
+
+			return loaded.Load(ifs) && loaded.Query(0, 4) == hierarchy.Query(0, 4);
+		};
+
+	uint32_t rank = 0;
+	uint64_t arcs = 28 + 7 * 4 + 8 * 8;
+
+	std::memcpy(&rank, &bytes[28], sizeof(rank));
+	CHECK(load(28, rank));
+	CHECK(!load(28, 7));
+	CHECK(!load(32, rank));
+	CHECK(!load(28 + 7 * 4 + 8, 1000));
+	CHECK(!load(arcs, 7));
+	CHECK(!load(arcs + 8, 1000));
+
+	std::remove(file);
+}
+
+// Size of the largest set of edges[index..] sharing no endpoint with each other or with the used vertices.
+static uint32_t GetMaximumMatching(EdgesVector const& edges, uint64_t const& index, uint32_t const& used)
+{
+	if (index == edges.size())
+		return 0;
+
+	uint32_t ends = (1U << edges[index].first.first) | (1U << edges[index].first.second);
+	uint32_t best = GetMaximumMatching(edges, index + 1, used);
+
+	if (!(used & ends))
+		best = std::max(best, 1 + GetMaximumMatching(edges, index + 1, used | ends));
+
+	return best;
+}
+
+static void TestBipartiteMatching()
+{
+	for (uint32_t trial = 0; trial < 60; ++trial)
+	{
+		GraphGenerator generator(trial);
+		uint32_t vertices = 2 + trial % 9;
+		uint32_t left = 1 + trial % (vertices - 1);
+		EdgesVector edges = generator.GetGnpEdges(vertices, 0.4, false);
+
+		// Only the edges between [0, left) and [left, V).
+		edges.erase(std::remove_if(edges.begin(), edges.end(), [&](Pair<Pair<uint32_t, uint32_t>, int32_t> const& edge)
+			{ return (edge.first.first < left) == (edge.first.second < left); }), edges.end());
+
+		UndirectedGraph graph(vertices, edges);
+
+		for (uint32_t threads = 1; threads <= 2; ++threads)
+		{
+			BipartiteMatching matching(graph, threads);
+			uint32_t matched = 0;
+
+			CHECK(matching.IsBipartite());
+			CHECK(matching.GetSize() == GetMaximumMatching(edges, 0, 0));
+
+			for (uint32_t i = 0; i < vertices; ++i)
+				if (matching.GetMate(i) != BipartiteMatching::NoMate)
+				{
+					CHECK(matching.GetMate(matching.GetMate(i)) == i && HasArc(graph, i, matching.GetMate(i)));
+					++matched;
+				}
+
+			CHECK(matched == 2 * matching.GetSize());
+			CHECK(matching.GetEdges().size() == matching.GetSize());
+		}
+	}
+
+	UndirectedGraph triangle(3, EdgesVector{ { { 0, 1 }, 0 }, { { 1, 2 }, 0 }, { { 2, 0 }, 0 } });
+
+	CHECK(!BipartiteMatching(triangle).IsBipartite());
+}
+
+// Distances after up to V rounds that relax every arc, from source or from every vertex at once for AllVertices.
+// False when the last round still improves a distance, i.e. a negative cycle is reachable.
+static bool Relax(Graph const& graph, uint32_t const& source, Vector<int64_t>* distances)
+{
+	bool improved = true;
+
+	distances->assign(graph.GetVertices(), (source == BellmanFord::AllVertices) ? 0 : BellmanFord::Unreachable);
+
+	if (source != BellmanFord::AllVertices)
+		(*distances)[source] = 0;
+
+	for (uint32_t round = 0; round < graph.GetVertices() && improved; ++round)
+	{
+		improved = false;
+
+		for (uint32_t i = 0; i < graph.GetVertices(); ++i)
+			for (AdjacencyListConstIterator itr = graph.GetNeighbours(i).begin(); itr != graph.GetNeighbours(i).end(); ++itr)
+				if ((*distances)[i] != BellmanFord::Unreachable && (*distances)[i] + itr->second < (*distances)[itr->first])
+				{
+					(*distances)[itr->first] = (*distances)[i] + itr->second;
+					improved = true;
+				}
+	}
+
+	return !improved;
+}
+
+static void CheckBellmanFord(DirectedGraph const& graph, uint32_t const& source, uint32_t const& threads)
+{
+	BellmanFord search(graph, source, threads);
+	Vector<int64_t> distances;
+	bool acyclic = Relax(graph, source, &distances);
+
+	CHECK(search.IsValid());
+	CHECK(search.HasNegativeCycle() == !acyclic);
+
+	if (acyclic)
+	{
+		CHECK(search.GetDistances() == distances);
+		return;
+	}
+
+	// The cycle follows arcs of the graph and the cheapest of them add up to a negative length.
+	Vector<uint32_t> const& cycle = search.GetNegativeCycle();
+	int64_t length = 0;
+
+	for (uint32_t i = 0; i < cycle.size(); ++i)
+	{
+		int64_t cheapest = BellmanFord::Unreachable;
+
+		for (AdjacencyListConstIterator itr = graph.GetNeighbours(cycle[i]).begin(); itr != graph.GetNeighbours(cycle[i]).end(); ++itr)
+			if (itr->first == cycle[(i + 1) % cycle.size()])
+				cheapest = std::min<int64_t>(cheapest, itr->second);
+
+		CHECK(cheapest != BellmanFord::Unreachable);
+		length += cheapest;
+	}
+
+	CHECK(!cycle.empty() && length < 0);
+}
+
+static void TestBellmanFord()
+{
+	for (uint32_t trial = 0; trial < 60; ++trial)
+	{
+		GraphGenerator generator(trial);
+		uint32_t vertices = 1 + trial % 9;
+
+		generator.SetWeights(-3, 9);
+
+		DirectedGraph graph(vertices, generator.GetGnpEdges(vertices, 0.4, true), true);
+
+		for (uint32_t threads = 1; threads <= 3; threads += 2)
+		{
+			CheckBellmanFord(graph, 0, threads);
+			CheckBellmanFord(graph, BellmanFord::AllVertices, threads);
+		}
+	}
+
+	// Negative arcs without a negative cycle: w(x, y) + p(x) - p(y) with w >= 0. The first rounds relax more than
+	// SerialRelaxations arcs and the later ones fewer, so both filters run.
+	uint32_t const vertices = 20000;
+	GraphGenerator generator(5);
+
+	generator.SetWeights(0, 50);
+
+	EdgesVector edges = generator.GetGnmEdges(vertices, 5 * vertices, true);
+
+	for (uint64_t i = 0; i < edges.size(); ++i)
+		edges[i].second += static_cast<int32_t>(edges[i].first.first % 97) - static_cast<int32_t>(edges[i].first.second % 97);
+
+	DirectedGraph graph(vertices, edges, true);
+
+	for (uint32_t threads = 1; threads <= 4; threads += 3)
+	{
+		CheckBellmanFord(graph, 0, threads);
+		CheckBellmanFord(graph, BellmanFord::AllVertices, threads);
+	}
+}
+
+static void CheckAllPairsShortestPaths(Graph const& graph, DistanceMatrix const& distances)
+{
+	Vector<int64_t> expected;
+
+	CHECK(distances.GetVertices() == graph.GetVertices());
+
+	for (uint32_t i = 0; i < graph.GetVertices() && i < distances.GetVertices(); ++i)
+	{
+		Relax(graph, i, &expected);
+
+		for (uint32_t j = 0; j < graph.GetVertices(); ++j)
+			CHECK(distances.Get(i, j) == ((expected[j] == BellmanFord::Unreachable) ? DistanceMatrix::Unreachable : expected[j]));
+	}
+}
+
+static void TestAllPairsShortestPaths()
+{
+	for (uint32_t trial = 0; trial < 8; ++trial)
+	{
+		GraphGenerator generator(trial);
+		uint32_t vertices = 5 + 9 * trial;
+
+		generator.SetWeights(0, 30);
+
+		// Negative arcs without a negative cycle, reweighted by vertex potentials.
+		EdgesVector edges = generator.GetGnpEdges(vertices, 0.15, true);
+
+		for (uint64_t i = 0; i < edges.size(); ++i)
+			edges[i].second += static_cast<int32_t>(edges[i].first.first % 7) - static_cast<int32_t>(edges[i].first.second % 7);
+
+		DirectedGraph directed(vertices, edges, true);
+		UndirectedGraph undirected(vertices, generator.GetGnpEdges(vertices, 0.1, false), true);
+
+		for (uint32_t threads = 1; threads <= 3; threads += 2)
+		{
+			CheckAllPairsShortestPaths(directed, AllPairsShortestPaths::FloydWarshall(directed, threads));
+			CheckAllPairsShortestPaths(directed, AllPairsShortestPaths::Johnson(directed, threads));
+			CheckAllPairsShortestPaths(undirected, AllPairsShortestPaths::FloydWarshall(undirected, threads));
+			CheckAllPairsShortestPaths(undirected, AllPairsShortestPaths::Johnson(undirected, threads));
+		}
+	}
+
+	DirectedGraph cycle(3, EdgesVector{ { { 0, 1 }, 2 }, { { 1, 2 }, -1 }, { { 2, 0 }, -2 } }, true);
+
+	CHECK(AllPairsShortestPaths::FloydWarshall(cycle).IsEmpty());
+	CHECK(AllPairsShortestPaths::Johnson(cycle).IsEmpty());
+}
+
+static void TestPointToPointSearch()
+{
+	for (uint32_t trial = 0; trial < 20; ++trial)
+	{
+		GraphGenerator generator(trial);
+		uint32_t vertices = 2 + 3 * trial;
+
+		generator.SetWeights(1, 20);
+
+		EdgesVector edges = generator.GetGnpEdges(vertices, 2.0 / vertices, true);
+		EdgesVector hops(edges);
+
+		for (uint64_t i = 0; i < hops.size(); ++i)
+			hops[i].second = 1;
+
+		// The unweighted search counts hops, as on the same arcs weighted 1.
+		DirectedGraph graphs[] = { DirectedGraph(vertices, edges, true), DirectedGraph(vertices, edges),
+			DirectedGraph(vertices, hops, true) };
+
+		for (uint32_t k = 0; k < 2; ++k)
+		{
+			PointToPointSearch search(graphs[k]);
+			DirectedGraph const& reference = graphs[k ? 2 : 0];
+			Vector<int64_t> expected;
+			Vector<uint32_t> path;
+
+			for (uint32_t i = 0; i < vertices; ++i)
+			{
+				Relax(reference, i, &expected);
+
+				for (uint32_t j = 0; j < vertices; ++j)
+				{
+					int64_t distance = search.Query(i, j, &path);
+
+					CHECK(distance == ((expected[j] == BellmanFord::Unreachable) ? -1 : expected[j]));
+					CHECK(path.empty() == (distance < 0));
+					CHECK(path.empty() || (path.front() == i && path.back() == j && GetPathLength(reference, path) == distance));
+				}
+			}
+
+			CHECK(search.Query(0, vertices) == -1);
+		}
+	}
+}
+
+// Component labels of the edges without the vertex skipped and the edge at index skippedEdge, by union-find.
+static Vector<uint32_t> GetComponentsWithout(uint32_t const& vertices, EdgesVector const& edges, uint32_t const& skipped,
+	uint64_t const& skippedEdge)
+{
+	Vector<uint32_t> parents(vertices);
+
+	for (uint32_t i = 0; i < vertices; ++i)
+		parents[i] = i;
+
+	for (uint64_t i = 0; i < edges.size(); ++i)
+	{
+		uint32_t x = edges[i].first.first;
+		uint32_t y = edges[i].first.second;
+
+		if (i == skippedEdge || x == skipped || y == skipped)
+			continue;
+
+		while (parents[x] != x)
+			x = parents[x];
+
+		while (parents[y] != y)
+			y = parents[y];
+
+		parents[x] = y;
+	}
+
+	for (uint32_t i = 0; i < vertices; ++i)
+		while (parents[i] != parents[parents[i]])
+			parents[i] = parents[parents[i]];
+
+	return parents;
+}
+
+static uint32_t GetComponentCount(Vector<uint32_t> const& components, uint32_t const& skipped)
+{
+	uint32_t count = 0;
+
+	for (uint32_t i = 0; i < components.size(); ++i)
+		count += i != skipped && components[i] == i;
+
+	return count;
+}
+
+static void TestBlockCutTree()
+{
+	for (uint32_t trial = 0; trial < 40; ++trial)
+	{
+		GraphGenerator generator(trial);
+		uint32_t vertices = 2 + trial % 10;
+		EdgesVector edges = generator.GetGnmEdges(vertices, vertices + trial % 4 - 2, false);
+
+		// A parallel edge and a self loop, neither can be a bridge.
+		if (trial % 3 == 0 && !edges.empty())
+		{
+			edges.push_back(edges.front());
+			edges.push_back(std::make_pair(std::make_pair(vertices - 1, vertices - 1), 0));
+		}
+
+		UndirectedGraph graph(vertices, edges, false);
+		BlockCutTree tree(graph);
+		Vector<uint32_t> components = GetComponentsWithout(vertices, edges, UINT32_MAX, UINT64_MAX);
+		Vector<Vector<uint32_t>> withoutEdge;
+		uint32_t bridges = 0;
+
+		for (uint64_t i = 0; i < edges.size(); ++i)
+		{
+			uint32_t x = edges[i].first.first;
+			uint32_t y = edges[i].first.second;
+
+			withoutEdge.push_back(GetComponentsWithout(vertices, edges, UINT32_MAX, i));
+
+			bool bridge = withoutEdge.back()[x] != withoutEdge.back()[y];
+
+			bridges += bridge;
+			CHECK(tree.IsBridge(x, y) == bridge && tree.IsBridge(y, x) == bridge);
+
+			for (uint32_t u = 0; u < vertices; ++u)
+				for (uint32_t v = 0; v < vertices; ++v)
+					CHECK(tree.IsConnectedWithoutEdge(u, v, x, y) == (withoutEdge.back()[u] == withoutEdge.back()[v]));
+		}
+
+		CHECK(tree.GetBridges().size() == bridges);
+
+		uint32_t cutVertices = 0;
+
+		for (uint32_t failed = 0; failed < vertices; ++failed)
+		{
+			Vector<uint32_t> without = GetComponentsWithout(vertices, edges, failed, UINT64_MAX);
+			bool cutVertex = GetComponentCount(without, failed) > GetComponentCount(components, UINT32_MAX);
+
+			cutVertices += cutVertex;
+			CHECK(tree.IsCutVertex(failed) == cutVertex);
+
+			for (uint32_t u = 0; u < vertices; ++u)
+				for (uint32_t v = 0; v < vertices; ++v)
+					CHECK(tree.IsConnectedWithoutVertex(u, v, failed) == (u != failed && v != failed && without[u] == without[v]));
+		}
+
+		CHECK(tree.GetCutVertices().size() == cutVertices);
+
+		ComponentLabels const& twoEdgeComponents = tree.GetTwoEdgeConnectedComponents();
+
+		for (uint32_t u = 0; u < vertices; ++u)
+			for (uint32_t v = 0; v < vertices; ++v)
+			{
+				bool twoEdgeConnected = components[u] == components[v];
+
+				for (uint64_t i = 0; i < withoutEdge.size(); ++i)
+					twoEdgeConnected = twoEdgeConnected && withoutEdge[i][u] == withoutEdge[i][v];
+
+				CHECK(tree.IsConnected(u, v) == (components[u] == components[v]));
+				CHECK(tree.IsTwoEdgeConnected(u, v) == twoEdgeConnected);
+				CHECK((twoEdgeComponents.GetComponent(u) == twoEdgeComponents.GetComponent(v)) == twoEdgeConnected);
+			}
+	}
+}
+
+// The cheapest Hamiltonian cycle by trying every order of the vertices after 0, -1 when there is none.
+static int64_t GetCheapestCycle(UndirectedGraph const& graph)
+{
+	Vector<uint32_t> cycle(graph.GetVertices() + 1, 0);
+	int64_t cheapest = -1;
+
+	for (uint32_t i = 1; i < graph.GetVertices(); ++i)
+		cycle[i] = i;
+
+	do
+	{
+		int64_t cost = GetPathLength(graph, cycle);
+
+		if (cost >= 0 && (cheapest < 0 || cost < cheapest))
+			cheapest = cost;
+	} while (std::next_permutation(cycle.begin() + 1, cycle.end() - 1));
+
+	return cheapest;
+}
+
+static bool IsTour(Vector<uint32_t> const& cycle, uint32_t const& vertices)
+{
+	Vector<bool> visited(vertices, false);
+
+	if (cycle.size() != vertices || cycle.front() != 0)
+		return false;
+
+	for (uint32_t i = 0; i < cycle.size(); ++i)
+	{
+		if (visited[cycle[i]])
+			return false;
+
+		visited[cycle[i]] = true;
+	}
+
+	return true;
+}
+
+static void TestHamiltonianCycle()
+{
+	for (uint32_t trial = 0; trial < 40; ++trial)
+	{
+		GraphGenerator generator(trial);
+		uint32_t vertices = 3 + trial % 6;
+
+		generator.SetWeights(1, 9);
+
+		EdgesVector edges = generator.GetGnpEdges(vertices, 0.3 + 0.1 * (trial % 5), false);
+
+		// A dearer parallel copy and a self loop must not change the tour.
+		if (trial % 4 == 0 && !edges.empty())
+		{
+			edges.push_back(std::make_pair(edges.front().first, edges.front().second + 5));
+			edges.push_back(std::make_pair(std::make_pair(0U, 0U), 1));
+		}
+
+		UndirectedGraph unweighted(vertices, edges, false);
+		UndirectedGraph weighted(vertices, edges, true);
+		int64_t cheapest = GetCheapestCycle(weighted);
+
+		for (uint32_t threads = 1; threads <= 2; ++threads)
+		{
+			HamiltonianCycle cycle(unweighted, threads);
+			Vector<uint32_t> closed = cycle.GetCycle();
+
+			closed.push_back(0);
+			CHECK(cycle.IsExact() && cycle.HasCycle() == (cheapest >= 0) && cycle.IsOptimal() == cycle.HasCycle());
+			CHECK(!cycle.HasCycle() || (IsTour(cycle.GetCycle(), vertices) && GetPathLength(unweighted, closed) >= 0));
+			CHECK(!cycle.HasCycle() || cycle.GetCost() == vertices);
+
+			HamiltonianCycle tour(weighted, threads);
+
+			CHECK(tour.HasCycle() == (cheapest >= 0) && !tour.IsOptimal());
+			CHECK(tour.FindOptimal() == tour.HasCycle());
+
+			closed = tour.GetCycle();
+			closed.push_back(0);
+			CHECK(!tour.HasCycle() || (IsTour(tour.GetCycle(), vertices) && GetPathLength(weighted, closed) == cheapest));
+			CHECK(!tour.HasCycle() || tour.GetCost() == cheapest);
+		}
+
+		CHECK(unweighted.IsHamiltonian() == (cheapest >= 0));
+	}
+}
+
+// Every edge carries its index plus one as weight, so the walk has to use each of the weights once.
+template <class _Graph>
+static void CheckEulerianPath(uint32_t const& vertices, EdgesVector const& edges, bool directed)
+{
+	_Graph graph(vertices, edges, true);
+	EulerianPath path(graph);
+	Vector<uint32_t> components = GetComponentsWithout(vertices, edges, UINT32_MAX, UINT64_MAX);
+	Vector<int32_t> balance(vertices, 0);
+	Vector<bool> touched(vertices, false);
+	uint32_t unbalanced = 0;
+	bool connected = !edges.empty();
+	bool balanced = true;
+
+	for (uint64_t i = 0; i < edges.size(); ++i)
+	{
+		++balance[edges[i].first.first];
+		balance[edges[i].first.second] += directed ? -1 : 1;
+		touched[edges[i].first.first] = touched[edges[i].first.second] = true;
+		connected = connected && components[edges[i].first.first] == components[edges.front().first.first];
+	}
+
+	// Undirected, a balance is the degree and only its parity counts; directed, it is out minus in degree and the
+	// path has to start at the one vertex with an extra out arc.
+	for (uint32_t i = 0; i < vertices; ++i)
+	{
+		if (!directed)
+			balance[i] %= 2;
+
+		unbalanced += balance[i] != 0;
+		balanced = balanced && balance[i] >= -1 && balance[i] <= 1;
+	}
+
+	bool exists = connected && balanced && unbalanced <= 2;
+
+	CHECK(path.HasPath() == exists && path.IsCircuit() == (exists && unbalanced == 0));
+
+	if (!path.HasPath())
+		return;
+
+	Vector<bool> used(edges.size(), false);
+
+	CHECK(path.GetPath().size() == edges.size() + 1 && path.GetIndices().size() == edges.size());
+	CHECK(unbalanced == 0 ? touched[path.GetPath().front()] : balance[path.GetPath().front()] == 1);
+
+	for (uint64_t i = 0; i < path.GetIndices().size(); ++i)
+	{
+		Pair<uint32_t, int32_t> const& arc = graph.GetNeighbours(path.GetPath()[i])[path.GetIndices()[i]];
+
+		CHECK(arc.first == path.GetPath()[i + 1] && arc.second >= 1 && !used[arc.second - 1]);
+		used[arc.second - 1] = true;
+	}
+}
+
+static void TestEulerianPath()
+{
+	for (uint32_t trial = 0; trial < 60; ++trial)
+	{
+		RandomEngine random(trial);
+		uint32_t vertices = 1 + trial % 7;
+		uint32_t current = static_cast<uint32_t>(random.NextBelow(vertices));
+		uint32_t first = current;
+		EdgesVector edges;
+
+		// A random walk has an Eulerian path, closing it gives a circuit and a stray edge usually breaks both.
+		for (uint32_t i = 0; i < trial % 9; ++i)
+		{
+			uint32_t next = static_cast<uint32_t>(random.NextBelow(vertices));
+
+			edges.push_back(std::make_pair(std::make_pair(current, next), 0));
+			current = next;
+		}
+
+		if (trial % 3 == 1)
+			edges.push_back(std::make_pair(std::make_pair(current, first), 0));
+		else if (trial % 3 == 2)
+			edges.push_back(std::make_pair(std::make_pair(static_cast<uint32_t>(random.NextBelow(vertices)),
+				static_cast<uint32_t>(random.NextBelow(vertices))), 0));
+
+		for (uint64_t i = 0; i < edges.size(); ++i)
+			edges[i].second = static_cast<int32_t>(i + 1);
+
+		CheckEulerianPath<UndirectedGraph>(vertices, edges, false);
+		CheckEulerianPath<DirectedGraph>(vertices, edges, true);
+	}
+}
+
+static EdgesVector GetRelabeledEdges(EdgesVector const& edges, Vector<uint32_t> const& labels, bool directed)
+{
+	EdgesVector relabeled;
+
+	for (uint64_t i = 0; i < edges.size(); ++i)
+	{
+		uint32_t x = labels[edges[i].first.first];
+		uint32_t y = labels[edges[i].first.second];
+
+		if (!directed && y < x)
+			std::swap(x, y);
+
+		relabeled.push_back(std::make_pair(std::make_pair(x, y), edges[i].second));
+	}
+
+	std::sort(relabeled.begin(), relabeled.end());
+
+	return relabeled;
+}
+
+// Isomorphism by trying every relabeling of the first graph's vertices.
+static bool IsIsomorphic(uint32_t const& vertices, EdgesVector const& first, EdgesVector const& second, bool directed)
+{
+	Vector<uint32_t> labels(vertices);
+	Vector<uint32_t> identity(vertices);
+
+	for (uint32_t i = 0; i < vertices; ++i)
+		labels[i] = identity[i] = i;
+
+	EdgesVector target = GetRelabeledEdges(second, identity, directed);
+
+	do
+	{
+		if (GetRelabeledEdges(first, labels, directed) == target)
+			return true;
+	} while (std::next_permutation(labels.begin(), labels.end()));
+
+	return false;
+}
+
+template <class _Graph>
+static void TestGraphFingerprint(bool directed)
+{
+	for (uint32_t trial = 0; trial < 40; ++trial)
+	{
+		GraphGenerator generator(trial);
+		RandomEngine random(trial);
+		uint32_t vertices = 2 + trial % 5;
+		uint32_t edgeCount = vertices - 1 + trial % 3;
+
+		generator.SetWeights(1, 1 + trial % 2);
+
+		EdgesVector first = generator.GetGnmEdges(vertices, edgeCount, directed);
+		EdgesVector second = GraphGenerator(trial + 1000).GetGnmEdges(vertices, edgeCount, directed);
+		Vector<uint32_t> labels(vertices);
+
+		for (uint32_t i = 0; i < vertices; ++i)
+			labels[i] = i;
+
+		for (uint32_t i = vertices - 1; i > 0; --i)
+			std::swap(labels[i], labels[random.NextBelow(i + 1)]);
+
+		// Second takes the weights of first, a different weight multiset would settle the question too early.
+		for (uint64_t i = 0; i < second.size() && i < first.size(); ++i)
+			second[i].second = first[i].second;
+
+		EdgesVector permuted = GetRelabeledEdges(first, labels, directed);
+		_Graph firstGraph(vertices, first, true);
+		_Graph secondGraph(vertices, second, true);
+		_Graph permutedGraph(vertices, permuted, true);
+		bool isomorphic = first.size() == second.size() && IsIsomorphic(vertices, first, second, directed);
+
+		for (uint32_t threads = 1; threads <= 2; ++threads)
+		{
+			GraphFingerprint firstFingerprint(firstGraph, threads);
+			GraphFingerprint secondFingerprint(secondGraph, threads);
+			GraphFingerprint permutedFingerprint(permutedGraph, threads);
+
+			CHECK(firstFingerprint.GetFingerprint() == permutedFingerprint.GetFingerprint());
+			CHECK(firstFingerprint.IsIsomorphic(permutedFingerprint) && permutedFingerprint.IsIsomorphic(firstFingerprint));
+
+			for (uint32_t i = 0; i < vertices; ++i)
+				CHECK(firstFingerprint.GetColors()[i] == permutedFingerprint.GetColors()[labels[i]]);
+
+			CHECK(firstFingerprint.IsIsomorphic(secondFingerprint) == isomorphic);
+			CHECK(!isomorphic || firstFingerprint.GetFingerprint() == secondFingerprint.GetFingerprint());
+		}
+	}
+}
+
+// Brandes' scores from all-pairs distances and shortest path counts, each pair once when undirected.
+template <class _Graph>
+static void CheckCentrality(_Graph const& graph, bool directed)
+{
+	uint32_t vertices = graph.GetVertices();
+	Matrix<int64_t> distances(vertices, Vector<int64_t>(vertices, INT64_MAX));
+	Matrix<double> counts(vertices, Vector<double>(vertices, 0));
+
+	for (uint32_t s = 0; s < vertices; ++s)
+	{
+		Vector<int64_t>& distance = distances[s];
+		Vector<uint32_t> order(vertices);
+
+		distance[s] = 0;
+
+		for (uint32_t round = 0; round < vertices; ++round)
+			for (uint32_t u = 0; u < vertices; ++u)
+				for (AdjacencyListConstIterator itr = graph.GetNeighbours(u).begin(); itr != graph.GetNeighbours(u).end(); ++itr)
+					if (distance[u] != INT64_MAX)
+						distance[itr->first] = std::min(distance[itr->first], distance[u] + (graph.IsWeighted() ? itr->second : 1));
+
+		for (uint32_t i = 0; i < vertices; ++i)
+			order[i] = i;
+
+		std::sort(order.begin(), order.end(), [&distance](uint32_t const& x, uint32_t const& y) { return distance[x] < distance[y]; });
+
+		// Every arc on a shortest path adds the paths of its tail, parallel arcs each.
+		counts[s][s] = 1;
+
+		for (uint32_t i = 0; i < vertices; ++i)
+			for (AdjacencyListConstIterator itr = graph.GetNeighbours(order[i]).begin(); itr != graph.GetNeighbours(order[i]).end(); ++itr)
+				if (distance[order[i]] != INT64_MAX && itr->first != order[i] &&
+					distance[order[i]] + (graph.IsWeighted() ? itr->second : 1) == distance[itr->first])
+					counts[s][itr->first] += counts[s][order[i]];
+	}
+
+	Vector<double> betweenness(vertices, 0);
+	Vector<double> closeness(vertices, 0);
+
+	for (uint32_t v = 0; v < vertices; ++v)
+		for (uint32_t s = 0; s < vertices; ++s)
+		{
+			if (s != v && distances[s][v] != INT64_MAX)
+				closeness[v] += 1.0 / distances[s][v] / (vertices - 1);
+
+			for (uint32_t t = 0; t < vertices; ++t)
+				if (s != v && v != t && s != t && distances[s][v] != INT64_MAX && distances[v][t] != INT64_MAX &&
+					distances[s][v] + distances[v][t] == distances[s][t])
+					betweenness[v] += counts[s][v] * counts[v][t] / counts[s][t] / (directed ? 1 : 2);
+		}
+
+	double pairs = static_cast<double>(vertices - 1) * (vertices - 2) / (directed ? 1 : 2);
+
+	for (uint32_t threads = 1; threads <= 2; ++threads)
+	{
+		Centrality centrality(graph, Centrality::AllSources, 0, threads);
+
+		CHECK(centrality.IsValid() && centrality.IsExact());
+
+		for (uint32_t v = 0; v < vertices; ++v)
+		{
+			CHECK(std::abs(centrality.GetBetweenness()[v] - betweenness[v]) < 1e-9);
+			CHECK(std::abs(centrality.GetCloseness()[v] - closeness[v]) < 1e-9);
+			CHECK(vertices < 3 || std::abs(centrality.GetNormalizedBetweenness(v) - betweenness[v] / pairs) < 1e-9);
+		}
+	}
+}
+
+static void TestCentrality()
+{
+	for (uint32_t trial = 0; trial < 30; ++trial)
+	{
+		GraphGenerator generator(trial);
+		uint32_t vertices = 2 + trial % 7;
+
+		generator.SetWeights(1, 3);
+
+		EdgesVector undirected = generator.GetGnpEdges(vertices, 0.4, false);
+		EdgesVector directed = generator.GetGnpEdges(vertices, 0.4, true);
+
+		// A parallel edge doubles the shortest paths through it.
+		if (!undirected.empty() && !directed.empty())
+		{
+			undirected.push_back(undirected.front());
+			directed.push_back(directed.front());
+		}
+
+		CheckCentrality(UndirectedGraph(vertices, undirected, trial % 2 == 0), false);
+		CheckCentrality(DirectedGraph(vertices, directed, trial % 2 == 0), true);
+	}
+
+	// On a path of three vertices the middle one carries the single pair of its ends, once.
+	EdgesVector edges;
+
+	edges.push_back(std::make_pair(std::make_pair(0U, 1U), 0));
+	edges.push_back(std::make_pair(std::make_pair(1U, 2U), 0));
+
+	Centrality centrality(UndirectedGraph(3, edges, false), Centrality::AllSources, 0, 1);
+
+	CHECK(centrality.GetBetweenness()[1] == 1 && centrality.GetNormalizedBetweenness(1) == 1);
+}
+
+// Core numbers by removing a vertex of the smallest remaining degree at a time. The degree of a vertex counts the arcs
+// into it, its edges on an undirected graph, and removing it takes away the arcs out of it.
+static Vector<uint32_t> GetCoresByPeeling(Graph const& graph)
+{
+	uint32_t vertices = graph.GetVertices();
+	Vector<uint32_t> degrees(vertices, 0);
+	Vector<uint32_t> cores(vertices, 0);
+	Vector<bool> removed(vertices, false);
+	uint32_t core = 0;
+
+	for (uint32_t i = 0; i < vertices; ++i)
+		for (AdjacencyListConstIterator itr = graph.GetNeighbours(i).begin(); itr != graph.GetNeighbours(i).end(); ++itr)
+			degrees[itr->first] += itr->first != i;
+
+	for (uint32_t step = 0; step < vertices; ++step)
+	{
+		uint32_t vertex = UINT32_MAX;
+
+		for (uint32_t i = 0; i < vertices; ++i)
+			if (!removed[i] && (vertex == UINT32_MAX || degrees[i] < degrees[vertex]))
+				vertex = i;
+
+		core = std::max(core, degrees[vertex]);
+		cores[vertex] = core;
+		removed[vertex] = true;
+
+		for (AdjacencyListConstIterator itr = graph.GetNeighbours(vertex).begin(); itr != graph.GetNeighbours(vertex).end(); ++itr)
+			if (!removed[itr->first])
+				--degrees[itr->first];
+	}
+
+	return cores;
+}
+
+static void CheckCoreDecomposition(CoreDecomposition const& decomposition, Vector<uint32_t> const& cores)
+{
+	Vector<uint32_t> order = decomposition.GetOrder();
+	uint32_t degeneracy = cores.empty() ? 0 : *std::max_element(cores.begin(), cores.end());
+
+	std::sort(order.begin(), order.end());
+	CHECK(decomposition.GetCores() == cores && decomposition.GetDegeneracy() == degeneracy);
+	CHECK(order.size() == cores.size() && std::adjacent_find(order.begin(), order.end()) == order.end());
+
+	for (uint32_t k = 0; k <= degeneracy + 1; ++k)
+	{
+		Vector<uint32_t> members;
+
+		for (uint32_t i = 0; i < cores.size(); ++i)
+			if (cores[i] >= k)
+				members.push_back(i);
+
+		CHECK(decomposition.GetCoreVertices(k) == members);
+	}
+}
+
+static void TestCoreDecomposition()
+{
+	// The large graphs pass SerialVertices, so the threads peel their levels in parallel.
+	for (uint32_t trial = 0; trial < 24; ++trial)
+	{
+		GraphGenerator generator(trial);
+		uint32_t vertices = trial < 20 ? 1 + trial : 6000;
+		EdgesVector undirected = generator.GetGnmEdges(vertices, 2 * vertices, false);
+		EdgesVector directed = generator.GetGnmEdges(vertices, 3 * vertices, true);
+
+		// Parallel edges count each, self loops not at all.
+		undirected.push_back(std::make_pair(std::make_pair(0U, vertices - 1), 0));
+		undirected.push_back(std::make_pair(std::make_pair(0U, vertices - 1), 0));
+		undirected.push_back(std::make_pair(std::make_pair(0U, 0U), 0));
+		directed.push_back(std::make_pair(std::make_pair(0U, vertices - 1), 0));
+		directed.push_back(std::make_pair(std::make_pair(vertices - 1, vertices - 1), 0));
+
+		EdgesVector transposed = directed;
+
+		for (uint64_t i = 0; i < transposed.size(); ++i)
+			std::swap(transposed[i].first.first, transposed[i].first.second);
+
+		UndirectedGraph undirectedGraph(vertices, undirected, false);
+		DirectedGraph directedGraph(vertices, directed, false);
+		DirectedGraph transposedGraph(vertices, transposed, false);
+		Vector<uint32_t> cores = GetCoresByPeeling(undirectedGraph);
+		Vector<uint32_t> inCores = GetCoresByPeeling(directedGraph);
+		Vector<uint32_t> outCores = GetCoresByPeeling(transposedGraph);
+
+		for (uint32_t threads = 1; threads <= 4; threads += 3)
+		{
+			CheckCoreDecomposition(CoreDecomposition(undirectedGraph, threads), cores);
+			CheckCoreDecomposition(CoreDecomposition(directedGraph, CoreDecomposition::InCore, threads), inCores);
+			CheckCoreDecomposition(CoreDecomposition(directedGraph, CoreDecomposition::OutCore, threads), outCores);
+		}
+	}
+}
+
+static void TestTopologicalOrder()
+{
+	for (uint32_t trial = 0; trial < 30; ++trial)
+	{
+		GraphGenerator generator(trial);
+		uint32_t vertices = 1 + 2 * trial;
+		EdgesVector edges;
+
+		generator.SetWeights(1, 9);
+
+		// Arcs from smaller to larger ids only, so the ids are a topological order to compare against.
+		EdgesVector candidates = generator.GetGnpEdges(vertices, 0.2, true);
+
+		for (uint64_t i = 0; i < candidates.size(); ++i)
+			if (candidates[i].first.first < candidates[i].first.second)
+				edges.push_back(candidates[i]);
+
+		DirectedGraph graph(vertices, edges, true);
+		Vector<uint32_t> levels(vertices, 0);
+		Vector<int64_t> longest(vertices, 0);
+
+		for (uint32_t i = 0; i < vertices; ++i)
+			for (AdjacencyListConstIterator itr = graph.GetNeighbours(i).begin(); itr != graph.GetNeighbours(i).end(); ++itr)
+			{
+				levels[itr->first] = std::max(levels[itr->first], levels[i] + 1);
+				longest[itr->first] = std::max(longest[itr->first], longest[i] + itr->second);
+			}
+
+		for (uint32_t threads = 1; threads <= 3; threads += 2)
+		{
+			TopologicalOrder order(graph, threads);
+			Vector<uint32_t> positions(vertices, TopologicalOrder::None);
+
+			CHECK(order.IsAcyclic() && order.GetOrder().size() == vertices);
+
+			for (uint32_t i = 0; i < order.GetOrder().size(); ++i)
+				positions[order.GetOrder()[i]] = i;
+
+			for (uint32_t i = 0; i < vertices; ++i)
+			{
+				for (AdjacencyListConstIterator itr = graph.GetNeighbours(i).begin(); itr != graph.GetNeighbours(i).end(); ++itr)
+					CHECK(positions[i] < positions[itr->first]);
+
+				CHECK(order.GetLevel(i) == levels[i] && order.GetLongestDistance(i) == longest[i]);
+			}
+
+			Vector<uint32_t> path = order.GetCriticalPath();
+
+			CHECK(order.GetLevelCount() == *std::max_element(levels.begin(), levels.end()) + 1);
+			CHECK(order.GetCriticalPathLength() == *std::max_element(longest.begin(), longest.end()));
+			CHECK(!path.empty() && GetPathLength(graph, path) == order.GetCriticalPathLength());
+		}
+
+		// An arc back to the first vertex closes a cycle, the vertices it reaches leave the order.
+		if (vertices < 3 || graph.GetNeighbours(0).empty())
+			continue;
+
+		edges.push_back(std::make_pair(std::make_pair(graph.GetNeighbours(0)[0].first, 0U), 1));
+
+		DirectedGraph cyclic(vertices, edges, true);
+		TopologicalOrder order(cyclic, 2);
+		Vector<uint32_t> cycle = order.GetCycle();
+
+		cycle.push_back(cycle.empty() ? 0 : cycle.front());
+		CHECK(!order.IsAcyclic() && GetPathLength(cyclic, cycle) > 0);
+		CHECK(order.GetLevel(0) == TopologicalOrder::None && order.GetOrder().size() < vertices);
+	}
+}
+
+// Capacity of the arcs leaving the vertices for which isSourceSide holds, a negative weight counts as 0.
+template <class _Function>
+static int64_t GetCutCapacity(DirectedGraph const& graph, _Function const& isSourceSide)
+{
+	int64_t capacity = 0;
+
+	for (uint32_t i = 0; i < graph.GetVertices(); ++i)
+		if (isSourceSide(i))
+			for (AdjacencyListConstIterator itr = graph.GetNeighbours(i).begin(); itr != graph.GetNeighbours(i).end(); ++itr)
+				if (!isSourceSide(itr->first))
+					capacity += std::max(itr->second, 0);
+
+	return capacity;
+}
+
+static void TestMaximumFlow()
+{
+	for (uint32_t trial = 0; trial < 60; ++trial)
+	{
+		GraphGenerator generator(trial);
+		uint32_t vertices = 2 + trial % 7;
+
+		generator.SetWeights(-2, 9);
+
+		DirectedGraph graph(vertices, generator.GetGnpEdges(vertices, 0.5, true), true);
+		MaximumFlow flow(graph, 0, vertices - 1);
+		int64_t minimum = INT64_MAX;
+		uint64_t crossing = 0;
+
+		// Every source side that holds the source and not the sink.
+		for (uint32_t side = 1; side < (1U << (vertices - 1)); side += 2)
+		{
+			auto isSourceSide = [&](uint32_t const& vertex) { return ((side >> vertex) & 1) != 0; };
+
+			minimum = std::min(minimum, GetCutCapacity(graph, isSourceSide));
+		}
+
+		CHECK(flow.GetValue() == minimum);
+		CHECK(flow.IsSourceSide(0) && !flow.IsSourceSide(vertices - 1));
+		CHECK(GetCutCapacity(graph, [&](uint32_t const& vertex) { return flow.IsSourceSide(vertex); }) == flow.GetValue());
+
+		// The flow respects the capacities and is conserved everywhere but at the source and the sink.
+		Vector<int64_t> balance(vertices, 0);
+
+		for (uint32_t i = 0; i < vertices; ++i)
+			for (uint32_t j = 0; j < graph.GetNeighbours(i).size(); ++j)
+			{
+				Pair<uint32_t, int32_t> const& arc = graph.GetNeighbours(i)[j];
+
+				CHECK(flow.GetFlow(i, j) >= 0 && flow.GetFlow(i, j) <= std::max(arc.second, 0));
+				balance[i] -= flow.GetFlow(i, j);
+				balance[arc.first] += flow.GetFlow(i, j);
+				crossing += flow.IsSourceSide(i) && !flow.IsSourceSide(arc.first);
+			}
+
+		for (uint32_t i = 1; i + 1 < vertices; ++i)
+			CHECK(balance[i] == 0);
+
+		CHECK(balance[vertices - 1] == flow.GetValue());
+		CHECK(flow.GetCutEdges().size() == crossing);
+	}
+}
+
+static void TestQueryExecutor()
+{
+	uint32_t const vertices = 300;
+	GraphGenerator generator(3);
+
+	generator.SetWeights(1, 20);
+
+	DirectedGraph graph(vertices, generator.GetGnmEdges(vertices, 2 * vertices, true), true);
+	QueryExecutor executor(graph, 4);
+	TraversalWorkspace workspace;
+	Vector<Query> queries;
+	Vector<std::future<QueryResult>> futures;
+
+	for (uint32_t i = 0; i < 2000; ++i)
+	{
+		Query query((i % 2) ? Query::Distance : Query::Reachable, (i * 7919) % vertices, (i * 104729 + 1) % vertices);
+
+		queries.push_back(query);
+		futures.push_back(executor.Submit(query));
+	}
+
+	Vector<QueryResult> results = executor.Execute(queries);
+
+	CHECK(results.size() == queries.size());
+
+	for (uint32_t i = 0; i < queries.size() && i < results.size(); ++i)
+	{
+		Query const& query = queries[i];
+		QueryResult submitted = futures[i].get();
+
+		if (query.type == Query::Reachable)
+			CHECK(results[i].value == graph.IsReachable(query.source, query.target, &workspace));
+		else
+		{
+			// The path runs from source to target over arcs and its weights add up to the distance.
+			int64_t distance = graph.GetRoadDistance(query.source)[query.target];
+			Vector<uint32_t> const& path = results[i].vertices;
+
+			CHECK(results[i].value == distance);
+			CHECK(path.empty() == (distance < 0));
+			CHECK(path.empty() || (path.front() == query.source && path.back() == query.target &&
+				GetPathLength(graph, path) == distance));
+		}
+
+		CHECK(submitted.value == results[i].value);
+	}
+}
+
+static void TestVersionedGraph()
+{
+	UndirectedGraph graph(7, GetEdges(), true);
+	VersionedGraph versioned(graph, 4);
+
+	{
+		VersionedGraph::Snapshot old = versioned.GetSnapshot();
+		EdgesVector edges = old.GetEdges();
+
+		CHECK(edges.size() == graph.GetEdges());
+
+		// Every commit retires the version before it, which the old snapshot may still see.
+		for (uint32_t i = 0; i < 6; ++i)
+		{
+			versioned.Apply({ EdgeUpdate(EdgeUpdate::Insert, 0, 2 + i % 5, 10), EdgeUpdate(EdgeUpdate::Delete, 1, 2) });
+
+			if (i == 3)
+				versioned.Compact();
+
+			CHECK(old.GetEdges() == edges);
+			CHECK(old.HasArc(1, 2) && !old.HasArc(0, 3));
+			CHECK(versioned.GetRetired() == i + 1 + (i >= 3));
+		}
+
+		VersionedGraph::Snapshot latest = versioned.GetSnapshot();
+
+		CHECK(latest.GetVersion() == old.GetVersion() + 7);
+		CHECK(!latest.HasArc(1, 2) && latest.HasArc(0, 3) && latest.HasArc(3, 0));
+		CHECK(latest.GetArcs() == old.GetArcs() + 8);
+	}
+
+	// With no snapshot left the next commit frees every retired version.
+	versioned.Apply({ EdgeUpdate(EdgeUpdate::Delete, 0, 3) });
+	CHECK(versioned.GetRetired() == 0);
+
+	// Readers on every slot, each snapshot keeps reading the same edges, two arcs each, while the writer commits.
+	std::atomic<bool> done(false);
+	std::atomic<uint32_t> changed(0);
+	Vector<std::thread> readers;
+
+	for (uint32_t i = 0; i < 4; ++i)
+		readers.push_back(std::thread([&]()
+			{
+				while (!done)
+				{
+					VersionedGraph::Snapshot snapshot = versioned.GetSnapshot();
+					EdgesVector edges = snapshot.GetEdges();
+
+					std::this_thread::yield();
+
+					if (snapshot.GetEdges() != edges || edges.size() * 2 != snapshot.GetArcs())
+						++changed;
+				}
+			}));
+
+	for (uint32_t i = 0; i < 500; ++i)
+		versioned.Apply({ EdgeUpdate(EdgeUpdate::Insert, 6, i % 6, 1), EdgeUpdate(EdgeUpdate::Delete, 6, (i + 5) % 6) });
+
+	done = true;
+
+	for (uint32_t i = 0; i < readers.size(); ++i)
+		readers[i].join();
+
+	CHECK(changed == 0);
+	versioned.Apply(Vector<EdgeUpdate>());
+	CHECK(versioned.GetRetired() == 0);
+}
+
+static void TestPageRank()
+{
+	// Enough vertices for several source segments, so the batches sum across them.
+	GraphGenerator generator(11);
+	DirectedGraph graph(3 * PageRank::SegmentVertices, generator.GetGnpEdges(3 * PageRank::SegmentVertices, 2e-5, true));
+	PageRank pageRank(CompressedGraph(graph), 0.85, 1e-7, 100, 2);
+	Vector<uint32_t> seeds = { 0, 70000, 140000 };
+	Matrix<float> personalized = pageRank.ComputePersonalized(seeds);
+
+	CHECK(personalized.size() == seeds.size());
+
+	for (uint32_t i = 0; i < seeds.size() && i < personalized.size(); ++i)
+	{
+		Vector<float> teleports(graph.GetVertices(), 0.0f);
+		double difference = 0;
+
+		teleports[seeds[i]] = 1.0f;
+
+		Vector<float> ranks = pageRank.Compute(teleports);
+
+		for (uint32_t j = 0; j < graph.GetVertices(); ++j)
+			difference += std::fabs(ranks[j] - personalized[i][j]);
+
+		CHECK(difference < 1e-4);
+	}
+}
+
+int main()
+{
+	TestReorderedOperands<UndirectedGraph>();
+	TestReorderedOperands<DirectedGraph>();
+	TestReadResetsPermutation<UndirectedGraph>();
+	TestReadResetsPermutation<DirectedGraph>();
+	TestGenerator();
+	TestContractionHierarchy<UndirectedGraph>();
+	TestContractionHierarchy<DirectedGraph>();
+	TestBipartiteMatching();
+	TestBellmanFord();
+	TestTopologicalOrder();
+	TestBlockCutTree();
+	TestHamiltonianCycle();
+	TestEulerianPath();
+	TestGraphFingerprint<UndirectedGraph>(false);
+	TestGraphFingerprint<DirectedGraph>(true);
+	TestCentrality();
+	TestCoreDecomposition();
+	TestMaximumFlow();
+	TestAllPairsShortestPaths();
+	TestPointToPointSearch();
+	TestPageRank();
+	TestQueryExecutor();
+	TestVersionedGraph();
+
+	if (failures)
+		std::cerr << failures << " checks failed" << std::endl;
+	else
+		std::cout << "All checks passed" << std::endl;
+
+	return static_cast<int>(std::min<uint32_t>(failures, 255));
+}